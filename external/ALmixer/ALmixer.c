@@ -4976,6 +4976,25 @@ static void Internal_FreeData(ALmixer_Data* data)
 
 
 				
+/* Called when a stream's source has run dry before EOF.
+ * The buffers themselves are allocated at load time so max_queue_buffers
+ * is fixed, but within it we can queue more per update pass
+ * (so a late pass catches up sooner) and ramp up further on restart.
+ * Each underrun moves both one step closer to max_queue_buffers,
+ * so a stream that keeps starving ends up keeping its whole queue full.
+ */
+static void Internal_AdaptToUnderrun(ALmixer_Data* data)
+{
+	if(data->num_target_buffers_per_pass < data->max_queue_buffers)
+	{
+		data->num_target_buffers_per_pass++;
+	}
+	if(data->num_startup_buffers < data->max_queue_buffers)
+	{
+		data->num_startup_buffers++;
+	}
+}
+
 /* Private function for Updating ALmixer.
  * This is a very big and ugly function.
  * It should return the number of buffers that were 
@@ -5340,6 +5359,7 @@ static ALint Update_ALmixer(void* data)
 				ALuint unqueued_buffer_id;
 				ALuint number_of_buffers_to_queue_this_pass = ALmixer_Channel_List[i].almixer_data->num_target_buffers_per_pass;
 				ALuint current_count_of_buffer_queue_passes = 0;
+				ALboolean adapted_to_underrun = AL_FALSE;
 				
 /*		fprintf(stderr, "For Streamed\n"); */
 				
@@ -5591,6 +5611,15 @@ static ALint Update_ALmixer(void* data)
 				 */
 				if(AL_STOPPED == state)
 				{
+					/* Adapt here too, not only in the resume path below,
+					 * so the targets grow whichever branch sees the underrun.
+					 * A stopped source at EOF has just finished, not starved.
+					 */
+					if(!ALmixer_Channel_List[i].almixer_data->eof)
+					{
+						Internal_AdaptToUnderrun(ALmixer_Channel_List[i].almixer_data);
+						adapted_to_underrun = AL_TRUE;
+					}
 					number_of_buffers_to_queue_this_pass = ALmixer_Channel_List[i].almixer_data->num_startup_buffers;
 /*					fprintf(stderr, "assuming underrun condition, using num_startup_buffers=%d\n", number_of_buffers_to_queue_this_pass); */
 				}	
@@ -5803,6 +5832,15 @@ static ALint Update_ALmixer(void* data)
 								/* Reset the number of buffers in use to 0 */
 								ALmixer_Channel_List[i].almixer_data->num_buffers_in_use = 0;
 
+								/* Queue deeper from now on so this is less likely to happen again,
+								 * unless this pass already did so above.
+								 */
+								if(!adapted_to_underrun)
+								{
+									Internal_AdaptToUnderrun(ALmixer_Channel_List[i].almixer_data);
+									adapted_to_underrun = AL_TRUE;
+								}
+
 								/* Get more data and put it in the first buffer */
 								if( ALmixer_Channel_List[i].almixer_data->buffer )
 								{
@@ -8943,6 +8981,16 @@ ALint ALmixer_GetTotalTime(ALmixer_Data* data)
 	return data->total_time;
 }
 
+ALuint ALmixer_GetTotalBytes(ALmixer_Data* data)
+{
+	if( (NULL == data) || (AL_FALSE == data->decoded_all) )
+	{
+		return 0;
+	}
+
+	return data->total_bytes;
+}
+
 /* This function will look up the source for the corresponding channel */
 /* Must return 0 on error instead of -1 because of unsigned int */
 ALuint ALmixer_GetSource(ALint channel)
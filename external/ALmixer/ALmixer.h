@@ -998,6 +998,14 @@ extern ALMIXER_DECLSPEC void ALMIXER_CALL ALmixer_SetPlaybackDataCallback(void (
  */
 extern ALMIXER_DECLSPEC ALint ALMIXER_CALL ALmixer_GetTotalTime(ALmixer_Data* almixer_data);
 
+/**
+ * Returns the number of bytes of decoded audio held by a predecoded resource.
+ * Streamed resources only hold their queue buffers, so 0 is returned for them.
+ * @param almixer_data The audio sample you want to know the size of.
+ * @return The number of decoded bytes or 0 if not predecoded.
+ */
+extern ALMIXER_DECLSPEC ALuint ALMIXER_CALL ALmixer_GetTotalBytes(ALmixer_Data* almixer_data);
+
 /** 
  * This function will look up the OpenAL source id for the corresponding channel number.
  * @param which_channel The channel which you want to find the corresponding OpenAL source id for.
@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Core/Rtt_MappedFile.h"
+
+#include "Core/Rtt_FileSystem.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined( Rtt_WIN_ENV )
+	static const unsigned S_IRUSR = _S_IREAD;
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+static const U8*
+ReadContents( Rtt_Allocator *allocator, const char *path, size_t length )
+{
+	FILE *f = Rtt_FileOpen( path, "rb" );
+	if ( ! f )
+	{
+		return NULL;
+	}
+
+	U8 *bytes = (U8 *)Rtt_MALLOC( allocator, length );
+	if ( bytes && Rtt_FileRead( bytes, 1, length, f ) != length )
+	{
+		Rtt_FREE( bytes );
+		bytes = NULL;
+	}
+	Rtt_FileClose( f );
+	return bytes;
+}
+
+SharedPtr< MappedFile >
+MappedFile::Open( Rtt_Allocator *allocator, const char *path )
+{
+	int fileDescriptor = Rtt_FileDescriptorOpen( path, O_RDONLY, S_IRUSR );
+	if ( fileDescriptor < 0 )
+	{
+		return SharedPtr< MappedFile >();
+	}
+
+	struct stat statbuf;
+	if ( fstat( fileDescriptor, &statbuf ) != 0 )
+	{
+		Rtt_FileDescriptorClose( fileDescriptor );
+		return SharedPtr< MappedFile >();
+	}
+
+	size_t length = (size_t)statbuf.st_size;
+	const U8 *bytes = NULL;
+	bool isMapped = false;
+	if ( length > 0 )
+	{
+		// The mapping stays valid once the descriptor is closed
+		bytes = (const U8 *)Rtt_FileMemoryMap( fileDescriptor, 0, length, false );
+		isMapped = ( NULL != bytes );
+	}
+	Rtt_FileDescriptorClose( fileDescriptor );
+
+	if ( length > 0 && ! isMapped )
+	{
+		bytes = ReadContents( allocator, path, length );
+		if ( ! bytes )
+		{
+			return SharedPtr< MappedFile >();
+		}
+	}
+
+	return SharedPtr< MappedFile >( Rtt_NEW( allocator, MappedFile( allocator, bytes, length, isMapped ) ) );
+}
+
+MappedFile::MappedFile( Rtt_Allocator *allocator, const U8 *bytes, size_t length, bool isMapped )
+:	fAllocator( allocator ),
+	fBytes( bytes ),
+	fLength( length ),
+	fIsMapped( isMapped ),
+	fView( bytes, (int)length )
+{
+}
+
+MappedFile::~MappedFile()
+{
+	if ( fIsMapped )
+	{
+		Rtt_FileMemoryUnmap( fBytes, fLength );
+	}
+	else if ( fBytes )
+	{
+		Rtt_FREE( (void *)fBytes );
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_MappedFile_H__
+#define _Rtt_MappedFile_H__
+
+#include "Core/Rtt_Data.h"
+#include "Core/Rtt_SharedPtr.h"
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// The read-only contents of a file, mapped into memory. Pages are loaded
+// on first access and belong to the OS file cache, so a large asset
+// doesn't need a heap copy, and files mapped more than once share memory.
+// Where a file can't be mapped, its contents are read into the heap.
+//
+// Held through a SharedPtr: the file is unmapped when the last one goes.
+class MappedFile
+{
+	Rtt_CLASS_NO_COPIES( MappedFile )
+
+	public:
+		typedef MappedFile Self;
+
+	public:
+		// Returns a null pointer if the file can't be opened
+		static SharedPtr< MappedFile > Open( Rtt_Allocator *allocator, const char *path );
+
+	public:
+		~MappedFile();
+
+	public:
+		const U8* GetBytes() const { return fBytes; }
+		size_t GetLength() const { return fLength; }
+		bool IsMapped() const { return fIsMapped; }
+
+		// A view for code that takes a Data; it's valid while this is
+		const Data< const U8 >& GetData() const { return fView; }
+
+	private:
+		MappedFile( Rtt_Allocator *allocator, const U8 *bytes, size_t length, bool isMapped );
+
+	private:
+		Rtt_Allocator *fAllocator;
+		const U8 *fBytes;
+		size_t fLength;
+		bool fIsMapped;
+		Data< const U8 > fView;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_MappedFile_H__
@@ -17,8 +17,10 @@
 #include "Display/Rtt_BitmapPaintAdapter.h"
 #include "Display/Rtt_Display.h"
 #include "Display/Rtt_DisplayDefaults.h"
+#include "Display/Rtt_ImageSheetPaint.h"
 #include "Renderer/Rtt_RenderData.h"
 #include "Rtt_Runtime.h"
+#include "Display/Rtt_TextureAtlas.h"
 #include "Display/Rtt_TextureFactory.h"
 #include "Display/Rtt_TextureResource.h"
 
@@ -33,12 +35,40 @@ namespace Rtt
 BitmapPaint*
 BitmapPaint::NewBitmap( Runtime& runtime, const char* filename, MPlatform::Directory baseDir, U32 flags )
 {
-	BitmapPaint *result = NULL;
-
 	TextureFactory& factory = runtime.GetDisplay().GetTextureFactory();
 	SharedPtr< TextureResource > pTexture =
 		factory.FindOrCreate( filename, baseDir, flags, false );
 
+	return NewBitmap( runtime, pTexture, filename );
+}
+
+BitmapPaint*
+BitmapPaint::NewImage( Runtime& runtime, const char* filename, MPlatform::Directory baseDir, U32 flags )
+{
+	TextureFactory& factory = runtime.GetDisplay().GetTextureFactory();
+	if ( ! factory.GetAtlas().IsEnabled() )
+	{
+		return NewBitmap( runtime, filename, baseDir, flags );
+	}
+
+	AutoPtr< ImageSheet > sheet;
+	int frameIndex = 0;
+	SharedPtr< TextureResource > pTexture =
+		factory.FindOrCreateAtlased( filename, baseDir, flags, sheet, frameIndex );
+
+	if ( sheet.NotNull() )
+	{
+		return ImageSheetPaint::NewBitmap( runtime.Allocator(), sheet, frameIndex );
+	}
+
+	return NewBitmap( runtime, pTexture, filename );
+}
+
+BitmapPaint*
+BitmapPaint::NewBitmap( Runtime& runtime, const SharedPtr< TextureResource >& pTexture, const char* filename )
+{
+	BitmapPaint *result = NULL;
+
 	if ( pTexture.NotNull() )
 	{
 		if ( pTexture->GetBitmap() == NULL || !pTexture->GetBitmap()->IsMask() )
@@ -39,12 +39,19 @@ class BitmapPaint : public Paint
 		// Load bitmap from file or reuse bitmap from image cache
 		static BitmapPaint* NewBitmap( Runtime& runtime, const char* filename, MPlatform::Directory baseDir, U32 flags );
 
+		// Same as above for display.newImage(). When the runtime atlas is
+		// enabled, the result may be an ImageSheetPaint for one of its frames.
+		static BitmapPaint* NewImage( Runtime& runtime, const char* filename, MPlatform::Directory baseDir, U32 flags );
+
 		// Load bitmap mask from file or reuse bitmap from image cache
 		static BitmapPaint* NewBitmap( Runtime& runtime, const FilePath& data, U32 flags, bool isMask );
 
 		// Wrap platform bitmap in Paint-compatible interface.
 		static BitmapPaint* NewBitmap( TextureFactory& factory, PlatformBitmap* bitmap, bool sharedTexture );
 
+	protected:
+		static BitmapPaint* NewBitmap( Runtime& runtime, const SharedPtr< TextureResource >& texture, const char* filename );
+
 	public:
 		BitmapPaint( const SharedPtr< TextureResource >& resource );
 
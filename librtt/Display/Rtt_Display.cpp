@@ -14,11 +14,15 @@
 #include "Core/Rtt_Geometry.h"
 #include "Display/Rtt_CPUResourcePool.h"
 #include "Display/Rtt_DisplayDefaults.h"
+#include "Display/Rtt_FramePacing.h"
 #include "Display/Rtt_BitmapPaint.h"
 #include "Display/Rtt_Paint.h"
+#include "Display/Rtt_RenderScale.h"
 #include "Display/Rtt_Scene.h"
 #include "Display/Rtt_ShaderFactory.h"
+#include "Display/Rtt_ShaderWarmup.h"
 #include "Display/Rtt_SpritePlayer.h"
+#include "Display/Rtt_TextureAtlas.h"
 #include "Display/Rtt_TextureFactory.h"
 #include "Display/Rtt_TextureResource.h"
 
@@ -30,10 +34,13 @@
 #include "CoronaLua.h"
 
 #include "Renderer/Rtt_GLRenderer.h"
+#include "Renderer/Rtt_NullRenderer.h"
 #include "Renderer/Rtt_VulkanExports.h"
 #include "Renderer/Rtt_FrameBufferObject.h"
 #include "Renderer/Rtt_Matrix_Renderer.h"
 #include "Renderer/Rtt_Program.h"
+#include "Renderer/Rtt_ProgramBinaryCache.h"
+#include "Renderer/Rtt_RenderThread.h"
 #include "Renderer/Rtt_Texture.h"
 
 // TODO: Remove when we replace TemporaryHackStream
@@ -56,9 +63,12 @@ Display::Display( Runtime& owner )
 :	fOwner( owner ),
 	fDefaults( Rtt_NEW( owner.Allocator(), DisplayDefaults ) ),
 	fDeltaTimeInSeconds( 0.0f ),
+	fFramePacing( Rtt_NEW( owner.Allocator(), FramePacing ) ),
 	fPreviousTime( owner.GetElapsedTime() ),
 	fRenderer( NULL ),
+	fRenderThread( NULL ),
 	fShaderFactory( NULL ),
+	fShaderWarmup( NULL ),
 	fSpritePlayer( Rtt_NEW( owner.Allocator(), SpritePlayer( owner.Allocator() ) ) ),
 	fTextureFactory( Rtt_NEW( owner.Allocator(), TextureFactory( * this ) ) ),
 	fScene( Rtt_NEW( & owner.GetAllocator(), Scene( owner.Allocator(), * this ) ) ),
@@ -67,6 +77,8 @@ Display::Display( Runtime& owner )
 	fScreenSurface( owner.Platform().CreateScreenSurface() ),
     fObjectFactories( LUA_REFNIL ),
     fFactoryFunc( NULL ),
+	fInterpolationFactor( Rtt_REAL_1 ),
+	fInterpolatedObjects(),
 	fIsCollecting( false )
 {
 }
@@ -83,6 +95,7 @@ Display::~Display()
 
     //Needs to be done before deletes, because it uses scene etc
     fTextureFactory->ReleaseByType( TextureResource::kTextureResource_Any );
+	fTextureFactory->GetAtlas().Empty();
     
 	Rtt_DELETE( fScreenSurface );
 	Rtt_DELETE( fStream );
@@ -90,7 +103,13 @@ Display::~Display()
     Rtt_DELETE( fProfilingState );
 	Rtt_DELETE( fTextureFactory );
 	Rtt_DELETE( fSpritePlayer );
+	if ( fRenderer )
+	{
+		fRenderer->SetProgramUsageObserver( NULL );
+	}
+	Rtt_DELETE( fShaderWarmup );
 	Rtt_DELETE( fShaderFactory );
+	Rtt_DELETE( fFramePacing );
 	Rtt_DELETE( fRenderer );
 	Rtt_DELETE( fDefaults );
 }
@@ -111,8 +130,17 @@ Display::Initialize( lua_State *L, int configIndex, const char * backend, void *
 	{
 		Rtt_Allocator *allocator = GetRuntime().GetAllocator();
 
+		String cachesDir( allocator );
+		GetRuntime().Platform().PathForFile( NULL, MPlatform::kCachesDir, MPlatform::kDefaultPathFlags, cachesDir );
+		ProgramBinaryCache::SetDirectory( cachesDir.GetString() );
+
+		if (strcmp( backend, "nullBackend" ) == 0)
+		{
+			// Any backend context is the path to record the command stream to
+			fRenderer = Rtt_NEW( allocator, NullRenderer( allocator, static_cast< const char * >( backendContext ) ) );
+		}
 #if defined( Rtt_WIN_ENV )
-		if (strcmp( backend, "glBackend" ) == 0)
+		else if (strcmp( backend, "glBackend" ) == 0)
 		{
 			fRenderer = Rtt_NEW( allocator, GLRenderer( allocator ) );
 		}
@@ -126,7 +154,10 @@ Display::Initialize( lua_State *L, int configIndex, const char * backend, void *
 			Rtt_ASSERT_NOT_REACHED();
 		}
 #else
-		fRenderer = Rtt_NEW( allocator, GLRenderer( allocator ) );
+		else
+		{
+			fRenderer = Rtt_NEW( allocator, GLRenderer( allocator ) );
+		}
 #endif
 
 		fRenderer->Initialize();
@@ -145,10 +176,69 @@ Display::Initialize( lua_State *L, int configIndex, const char * backend, void *
 		result = true;
 
 		fShaderFactory = Rtt_NEW( allocator, ShaderFactory( *this, programHeader, backend ) );
+
+		fShaderWarmup = Rtt_NEW( allocator, ShaderWarmup( *this ) );
+		fRenderer->SetProgramUsageObserver( fShaderWarmup );
+
+		if ( configIndex > 0 )
+		{
+			WarmUpShaders( L, configIndex );
+
+			lua_getfield( L, configIndex, "renderScale" );
+			RenderScale& renderScale = GetScene().GetRenderScale();
+			renderScale.Read( L, -1 );
+			lua_pop( L, 1 );
+
+			lua_getfield( L, configIndex, "imageAtlas" );
+			GetTextureFactory().GetAtlas().Read( L, -1 );
+			lua_pop( L, 1 );
+
+			// In megabytes
+			lua_getfield( L, configIndex, "textureMemoryBudget" );
+			if ( lua_type( L, -1 ) == LUA_TNUMBER )
+			{
+				lua_Number megabytes = Min( Max( lua_tonumber( L, -1 ), (lua_Number)0 ), (lua_Number)2047 );
+				GetTextureFactory().SetTextureMemoryBudget( (S32)( megabytes * 1024 * 1024 ) );
+			}
+			lua_pop( L, 1 );
+		}
 	}
 
     return result;
 }
+
+// content =
+// {
+//     prewarmEffects = { "filter.blur", ["composite.add"] = { 0, 1 } },
+//     shaderUsageManifest = true,
+// }
+// Programs for these effects (and, with the manifest, every effect and mask
+// count used in earlier runs) are compiled before the first frame instead of
+// when an object first uses them, avoiding hitches during gameplay.
+void
+Display::WarmUpShaders( lua_State *L, int index )
+{
+	ShaderWarmup::Usage usage;
+
+	lua_getfield( L, index, "prewarmEffects" );
+	ShaderWarmup::Read( L, -1, usage );
+	lua_pop( L, 1 );
+
+	lua_getfield( L, index, "shaderUsageManifest" );
+	bool usesManifest = lua_toboolean( L, -1 );
+	lua_pop( L, 1 );
+
+	if ( usesManifest )
+	{
+		fShaderWarmup->LoadManifest( usage );
+		fShaderWarmup->SetRecording( true );
+	}
+
+	if ( ! usage.empty() )
+	{
+		fShaderWarmup->Compile( usage );
+	}
+}
     
 void
 Display::Teardown()
@@ -246,6 +336,8 @@ Display::Update()
     PROFILING_BEGIN( *GetProfilingState(), up, Update );
 
     up.Add( "Display::Update Begin" );
+
+    fFramePacing->MarkFrame( FramePacing::kLogicStart );
     
     // Calculate delta time per logic tick, not per render tick.
     // Prior to render/logic decoupling, this lived in Render() because both
@@ -290,6 +382,8 @@ Display::Update()
     
 	Profiling::ResetSums();
 
+    fFramePacing->MarkFrame( FramePacing::kLogicEnd );
+
     up.Add( "Display::Update End" );
 }
 
@@ -300,8 +394,33 @@ Display::Render()
 
     rp.Add( "Display::Render Begin" );
     // fDeltaTimeInSeconds is now calculated in Update().
+
+    if ( GetDefaults().IsInterpolating() )
+    {
+        Real ticks = Rtt_AbsoluteToMilliseconds( GetRuntime().GetElapsedTime() - fPreviousTime ) * fOwner.GetFPS() / 1000.0f;
+        fInterpolationFactor = Min( ticks, Rtt_REAL_1 );
+    }
+    else
+    {
+        fInterpolationFactor = Rtt_REAL_1;
+    }
+
+    // Either moves them further along, or lets them drop their state
+    if ( ! fInterpolatedObjects.empty() )
+    {
+        std::unordered_set< DisplayObject * > objects;
+        objects.swap( fInterpolatedObjects );
+        for ( DisplayObject *object : objects )
+        {
+            object->Invalidate( DisplayObject::kTransformFlag );
+        }
+    }
+
 	GetScene().Render( * fRenderer, * fScreenSurface, &rp );
 
+    // New effect or mask usage is rare, so this seldom writes anything
+    fShaderWarmup->SaveManifest();
+
     rp.Add( "Display::Render End" );
 }
 
@@ -410,6 +529,9 @@ Display::Capture( DisplayObject *object,
         }
     }
 
+	// Captures read back right away, so they need the context here
+	RenderThreadLock lock( fRenderThread );
+
 	fRenderer->BeginFrame( 0.1f, 0.1f, GetDefaults().GetTimeTransform(), GetScreenToContentScale(), true );
 
     ////////////////////////////////////////////////////////////////////////////////
@@ -713,12 +835,16 @@ Display::Capture( DisplayObject *object,
 void
 Display::UnloadResources()
 {
+	RenderThreadLock lock( fRenderThread );
+
 	GetRenderer().ReleaseGPUResources();
 }
 
 void
 Display::ReloadResources()
 {
+	RenderThreadLock lock( fRenderThread );
+
 	GetRenderer().ReleaseGPUResources();
 	GetRenderer().Initialize();
 }
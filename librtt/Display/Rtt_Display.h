@@ -26,6 +26,8 @@
 
 #include "Rtt_MPlatform.h"
 
+#include <unordered_set>
+
 // ----------------------------------------------------------------------------
 
 struct lua_State;
@@ -43,9 +45,12 @@ class DisplayObject;
 class GroupObject;
 class ProgramHeader;
 class Renderer;
+class RenderThread;
 class Runtime;
 class Scene;
 class ShaderFactory;
+class ShaderWarmup;
+class FramePacing;
 class SpritePlayer;
 class StageObject;
 class String;
@@ -69,6 +74,7 @@ class Display
 
     protected:
         void ReadRenderingConfig( lua_State *L, int index, ProgramHeader& programHeader );
+        void WarmUpShaders( lua_State *L, int index );
 
 	public:
 		virtual void Start();
@@ -178,11 +184,29 @@ class Display
         float GetDeltaTimeInSeconds() const { return fDeltaTimeInSeconds; }
         Rtt_AbsoluteTime GetPreviousTime() const { return fPreviousTime; }
 
+        // How far Render() is between the last logic tick and the next one,
+        // from 0 to 1. Only maintained while interpolating.
+        Real GetInterpolationFactor() const { return fInterpolationFactor; }
+
+        // Objects still moving between the transforms of the last two logic
+        // ticks. Render() re-evaluates their transforms until they come to rest.
+        void AddInterpolatedObject( DisplayObject *object ) { fInterpolatedObjects.insert( object ); }
+        void RemoveInterpolatedObject( DisplayObject *object ) { fInterpolatedObjects.erase( object ); }
+
         Renderer& GetRenderer() { return *fRenderer; }
         const Renderer& GetRenderer() const { return *fRenderer; }
 
+        // Not owned. When set, the Scene hands Render() off to this thread;
+        // direct GPU access elsewhere must go through a RenderThreadLock.
+        RenderThread* GetRenderThread() const { return fRenderThread; }
+        void SetRenderThread( RenderThread* newValue ) { fRenderThread = newValue; }
+
         ShaderFactory& GetShaderFactory() const { return * fShaderFactory; }
 
+        ShaderWarmup& GetShaderWarmup() const { return * fShaderWarmup; }
+
+        FramePacing& GetFramePacing() const { return * fFramePacing; }
+
         SpritePlayer& GetSpritePlayer() const { return * fSpritePlayer; }
 
 		TextureFactory& GetTextureFactory() const { return * fTextureFactory; }
@@ -218,9 +242,12 @@ class Display
 		Runtime& fOwner;
 		DisplayDefaults *fDefaults;
 		float fDeltaTimeInSeconds;
+		FramePacing *fFramePacing;
 		Rtt_AbsoluteTime fPreviousTime;
 		Renderer *fRenderer;
+		RenderThread *fRenderThread;
 		ShaderFactory *fShaderFactory;
+		ShaderWarmup *fShaderWarmup;
 		SpritePlayer *fSpritePlayer;
 		TextureFactory *fTextureFactory;
 		Scene *fScene;
@@ -235,6 +262,9 @@ class Display
         int fObjectFactories;
         void * fFactoryFunc;
 
+		Real fInterpolationFactor;
+		std::unordered_set< DisplayObject * > fInterpolatedObjects;
+
 		bool fIsCollecting; // guards against nested calls to Collect()
 };
 
@@ -49,6 +49,8 @@ DisplayDefaults::DisplayDefaults()
     fEnableStencilInScene( false ),
     fAddDepthToResource( false ),
     fAddStencilToResource( false ),
+    fIsPartialRedraw( false ),
+    fIsInterpolating( false ),
     fSceneDepthClear( 1.0 ),
     fAddedDepthClear( 1.0 ),
     fSceneStencilClear( 0 ),
@@ -94,6 +94,15 @@ class DisplayDefaults
         U32 GetAddedStencilClearValue() const { return fAddedStencilClear; }
         void SetAddedStencilClearValue( float newValue ) { fAddedStencilClear = newValue; }
 
+        // When true, the scene only redraws the regions damaged by changed objects.
+        bool IsPartialRedraw() const { return fIsPartialRedraw; }
+        void SetPartialRedraw( bool newValue ) { fIsPartialRedraw = newValue; }
+
+        // When true, frames rendered between two logic ticks draw moving
+        // objects between their transforms from the last two ticks.
+        bool IsInterpolating() const { return fIsInterpolating; }
+        void SetInterpolating( bool newValue ) { fIsInterpolating = newValue; }
+
         const TimeTransform* GetTimeTransform() const;
         void SetTimeTransform( const TimeTransform *transform );
 
@@ -116,6 +125,8 @@ class DisplayDefaults
         bool fEnableStencilInScene;
         bool fAddDepthToResource;
         bool fAddStencilToResource;
+        bool fIsPartialRedraw;
+        bool fIsInterpolating;
         float fSceneDepthClear;
         float fAddedDepthClear;
         U32 fSceneStencilClear;
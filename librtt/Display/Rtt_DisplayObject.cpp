@@ -11,6 +11,7 @@
 
 #include "Display/Rtt_DisplayObject.h"
 #include "Display/Rtt_Display.h"
+#include "Display/Rtt_DisplayDefaults.h"
 #include "Display/Rtt_GroupObject.h"
 
 #include "Display/Rtt_BitmapMask.h"
@@ -22,6 +23,7 @@
 #include "Rtt_LuaProxy.h"
 #include "Rtt_LuaProxyVTable.h"
 #include "Rtt_RenderingStream.h"
+#include "Rtt_Runtime.h"
 #include "Core/Rtt_StringHash.h"
 #include "Renderer/Rtt_Uniform.h"
 
@@ -149,6 +151,56 @@ DisplayObject::DidChangePaint( RenderData& data )
 
 // ----------------------------------------------------------------------------
 
+// The parts of a Transform that are interpolated. A user matrix is not.
+struct TransformSample
+{
+	void Read( const Transform& transform )
+	{
+		fX = transform.GetX();
+		fY = transform.GetY();
+		fRotation = transform.GetRotation();
+		fScaleX = transform.GetSx();
+		fScaleY = transform.GetSy();
+	}
+
+	bool Equals( const TransformSample& rhs ) const
+	{
+		return Rtt_RealEqual( fX, rhs.fX ) && Rtt_RealEqual( fY, rhs.fY )
+			&& Rtt_RealEqual( fRotation, rhs.fRotation )
+			&& Rtt_RealEqual( fScaleX, rhs.fScaleX ) && Rtt_RealEqual( fScaleY, rhs.fScaleY );
+	}
+
+	Real fX;
+	Real fY;
+	Real fRotation;
+	Real fScaleX;
+	Real fScaleY;
+};
+
+static Real
+Lerp( Real a, Real b, Real t )
+{
+	return a + Rtt_RealMul( b - a, t );
+}
+
+struct DisplayObject::InterpolationState
+{
+	InterpolationState( Display& display, const Transform& transform, U32 tick )
+	:	fDisplay( display ),
+		fTick( tick )
+	{
+		fCurrent.Read( transform );
+		fPrevious = fCurrent;
+	}
+
+	Display& fDisplay;
+	TransformSample fPrevious; // as of the tick before fTick
+	TransformSample fCurrent; // as of fTick
+	U32 fTick;
+};
+
+// ----------------------------------------------------------------------------
+
 DisplayObject::DisplayObject()
 :	fParent( NULL ),
 	fSrcToDst(),
@@ -159,6 +211,7 @@ DisplayObject::DisplayObject()
     fObjectDesc("DisplayObject"),
     fWhereDefined(NULL),
     fWhereChanged(NULL),
+	fInterpolation( NULL ),
 	fMask( NULL ),
 	fMaskUniform( NULL ),
 	fAnchorX( Rtt_REAL_0 ),
@@ -197,6 +250,12 @@ DisplayObject::~DisplayObject()
 	QueueRelease( fMaskUniform );
 	Rtt_DELETE( fMask );
 
+	if ( fInterpolation )
+	{
+		fInterpolation->fDisplay.RemoveInterpolatedObject( this );
+		Rtt_DELETE( fInterpolation );
+	}
+
     // The final owner of fLuaProxy should be the Lua reference system
     // So LuaProxy should be deleted when shutting down Lua triggers a GC
     if ( fLuaProxy ) //if ( ! Rtt_VERIFY( ! fLuaProxy ) )
@@ -422,7 +481,10 @@ DisplayObject::UpdateTransform( const Matrix& parentToDstSpace )
 
             // Object's transform gets applied first, then parentToDstSpace
             fSrcToDst = parentToDstSpace;
-            fSrcToDst.Concat( GetMatrix() );
+            if ( ! ConcatInterpolatedMatrix( fSrcToDst ) )
+            {
+                fSrcToDst.Concat( GetMatrix() );
+            }
 
             // After applying transform, allow subclasses to further customize,
             // e.g. trimmed frames from imagesheets
@@ -1064,10 +1126,51 @@ DisplayObject::IsStageBoundsValid() const
 void
 DisplayObject::InvalidateDisplay()
 {
+    // Retained batches that include the receiver are out of date
+    for ( GroupObject* ancestor = GetParent(); ancestor; ancestor = ancestor->GetParent() )
+    {
+        ancestor->InvalidateStaticBatch();
+    }
+
     StageObject* canvas = GetStage();
      if ( canvas )
     {
-        canvas->InvalidateDisplay();
+        Scene& scene = canvas->GetScene();
+        if ( scene.IsDamageTrackingEnabled() && this != canvas )
+        {
+            // Objects that are not onscreen cannot damage what is presented
+            if ( canvas->IsOnscreen() )
+            {
+                // Damage the bounds last drawn. The new bounds are added
+                // in CollectDamage() once the receiver is prepared.
+                Rect lastDrawnBounds;
+                if ( ! IsProperty( kIsDamaged ) )
+                {
+                    SetProperty( kIsDamaged, true );
+                    lastDrawnBounds = fStageBounds;
+                }
+                scene.AddDamage( lastDrawnBounds );
+            }
+        }
+        else
+        {
+            canvas->InvalidateDisplay();
+        }
+    }
+}
+
+void
+DisplayObject::CollectDamage()
+{
+    if ( IsProperty( kIsDamaged ) )
+    {
+        SetProperty( kIsDamaged, false );
+
+        StageObject* canvas = GetStage();
+        if ( canvas && canvas->IsOnscreen() )
+        {
+            canvas->GetScene().AddDamage( StageBounds() );
+        }
     }
 }
 
@@ -1403,12 +1506,7 @@ DisplayObject::SetVisible( bool newValue )
     {
         SetProperty( kIsVisible, newValue );
         InvalidateStageBounds();
-
-        StageObject* canvas = GetStage();
-        if ( canvas )
-        {
-            canvas->InvalidateDisplay();
-        }
+        InvalidateDisplay();
     }
 }
 
@@ -1532,6 +1630,74 @@ DisplayObject::GetSrcToDstMatrix() const
     return fSrcToDst;
 }
 
+bool
+DisplayObject::ConcatInterpolatedMatrix( Matrix& srcToDst )
+{
+    StageObject *stage = GetStage();
+    if ( ! stage )
+    {
+        return false;
+    }
+
+    Display& display = stage->GetDisplay();
+    if ( ! display.GetDefaults().IsInterpolating() )
+    {
+        if ( fInterpolation )
+        {
+            display.RemoveInterpolatedObject( this );
+            Rtt_DELETE( fInterpolation );
+            fInterpolation = NULL;
+        }
+        return false;
+    }
+
+    U32 tick = display.GetRuntime().GetFrame();
+    if ( ! fInterpolation )
+    {
+        // Nothing to start from, so the first move after this snaps
+        fInterpolation = Rtt_NEW( display.GetAllocator(), InterpolationState( display, fTransform, tick ) );
+        return false;
+    }
+
+    InterpolationState& state = * fInterpolation;
+    if ( state.fTick != tick )
+    {
+        state.fPrevious = state.fCurrent;
+        state.fTick = tick;
+    }
+    state.fCurrent.Read( fTransform );
+
+    if ( state.fPrevious.Equals( state.fCurrent ) )
+    {
+        return false;
+    }
+
+    // Come back on the next frame, until the next tick brings it to rest
+    display.AddInterpolatedObject( this );
+
+    const TransformSample& from = state.fPrevious;
+    const TransformSample& to = state.fCurrent;
+    Real t = display.GetInterpolationFactor();
+
+    Transform transform( fTransform );
+    transform.SetProperty( kOriginX, Lerp( from.fX, to.fX, t ) );
+    transform.SetProperty( kOriginY, Lerp( from.fY, to.fY, t ) );
+    transform.SetProperty( kRotation, Lerp( from.fRotation, to.fRotation, t ) );
+    transform.SetProperty( kScaleX, Lerp( from.fScaleX, to.fScaleX, t ) );
+    transform.SetProperty( kScaleY, Lerp( from.fScaleY, to.fScaleY, t ) );
+
+    Vertex2 offset;
+    bool shouldOffset = ShouldOffsetWithAnchor();
+    if ( shouldOffset )
+    {
+        offset = GetAnchorOffset();
+    }
+
+    srcToDst.Concat( transform.GetMatrix( shouldOffset ? & offset : NULL ) );
+
+    return true;
+}
+
 const Matrix&
 DisplayObject::GetMatrix() const
 {
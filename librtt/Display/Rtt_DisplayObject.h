@@ -117,6 +117,7 @@ class DisplayObject : public MLuaProxyable
 			kIsRenderedOffscreen = 0x400,
             kSkipsCull = 0x1000,
             kSkipsHitTest = 0x2000,
+            kIsDamaged = 0x4000, // Changed since the last render (partial redraw)
 
             // NOTE: Current maximum of 16 PropertyMasks!!!
         };
@@ -285,6 +286,10 @@ class DisplayObject : public MLuaProxyable
         // Reblits display list to screen
         void InvalidateDisplay();
 
+        // Adds the new stage bounds of a damaged object to the scene's
+        // damaged region. Called once the object has been prepared.
+        void CollectDamage();
+
     protected:
         static void CalculateMaskMatrix( Matrix& dstToMask, const Matrix& srcToDst, const BitmapMask& mask );
         static void UpdateMaskUniform( Uniform& maskUniform, const Matrix& srcToDst, const BitmapMask& mask );
@@ -394,6 +399,11 @@ class DisplayObject : public MLuaProxyable
         // Instead, manipulate fTransform
         const Matrix& GetMatrix() const;
 
+    private:
+        // While the display interpolates, concats the matrix between the
+        // transforms of the last two logic ticks instead of GetMatrix().
+        bool ConcatInterpolatedMatrix( Matrix& srcToDst );
+
     public:
         // TODO: Do we need this anymore?  Get rid of if we remove snapshot orphanage
         // When dispatching events that propagate between a chain of listeners
@@ -445,6 +455,11 @@ class DisplayObject : public MLuaProxyable
         const char *fWhereDefined;
         const char *fWhereChanged;
 
+    private:
+        // Only allocated once the object is transformed while interpolating
+        struct InterpolationState;
+        InterpolationState *fInterpolation;
+
     private:
         BitmapMask *fMask;
         Uniform *fMaskUniform;
@@ -0,0 +1,268 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_FramePacing.h"
+
+#include "Rtt_Lua.h"
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// An interval this much longer than the budget means a refresh was skipped
+static const Real kMissedFrameFactor = 1.5f;
+
+static Real
+ElapsedMS( Rtt_AbsoluteTime start, Rtt_AbsoluteTime end )
+{
+	return end > start ? Rtt_AbsoluteToMicroseconds( end - start ) * 0.001f : Rtt_REAL_0;
+}
+
+// Nearest rank on sorted values
+static Real
+Percentile( const std::vector< Real >& sorted, Real p )
+{
+	size_t rank = (size_t)( p * sorted.size() + 0.5f );
+	rank = std::min( std::max( rank, (size_t)1 ), sorted.size() );
+	return sorted[rank - 1];
+}
+
+static void
+PushSummary( lua_State *L, const char *name, std::vector< Real >& values )
+{
+	if ( values.empty() )
+	{
+		return;
+	}
+
+	Real sum = Rtt_REAL_0;
+	for ( size_t i = 0, iMax = values.size(); i < iMax; i++ )
+	{
+		sum += values[i];
+	}
+
+	std::sort( values.begin(), values.end() );
+
+	lua_createtable( L, 0, 5 );
+	lua_pushnumber( L, sum / values.size() );
+	lua_setfield( L, -2, "mean" );
+	lua_pushnumber( L, Percentile( values, 0.50f ) );
+	lua_setfield( L, -2, "p50" );
+	lua_pushnumber( L, Percentile( values, 0.95f ) );
+	lua_setfield( L, -2, "p95" );
+	lua_pushnumber( L, Percentile( values, 0.99f ) );
+	lua_setfield( L, -2, "p99" );
+	lua_pushnumber( L, values.back() );
+	lua_setfield( L, -2, "max" );
+	lua_setfield( L, -2, name );
+}
+
+// ----------------------------------------------------------------------------
+
+FramePacing::FramePacing()
+:	fNext( 0 ),
+	fCount( 0 ),
+	fBudget( 1000.0f / 30.0f ),
+	fLatestInterval( Rtt_REAL_0 ),
+	fIsWarningEnabled( true ),
+	fTotalFrames( 0 ),
+	fMissedFrames( 0 ),
+	fWarningStart( 0 ),
+	fWarningFrames( 0 ),
+	fWarningMissed( 0 ),
+	fWarningWorst( Rtt_REAL_0 )
+{
+	memset( fFrames, 0, sizeof( fFrames ) );
+	memset( & fCurrent, 0, sizeof( fCurrent ) );
+}
+
+void
+FramePacing::MarkInput()
+{
+	if ( 0 == fCurrent.fInput )
+	{
+		fCurrent.fInput = Rtt_GetAbsoluteTime();
+	}
+}
+
+void
+FramePacing::MarkFrame( Mark mark )
+{
+	Rtt_ASSERT( mark >= 0 && mark < kNumMarks );
+
+	Rtt_AbsoluteTime now = Rtt_GetAbsoluteTime();
+
+	// The previous tick finished without presenting, e.g. the scene was
+	// valid. Start over from this tick, keeping only the pending input.
+	if ( kLogicStart == mark && fCurrent.fMarks[kLogicEnd] )
+	{
+		Rtt_AbsoluteTime input = fCurrent.fInput;
+
+		memset( & fCurrent, 0, sizeof( fCurrent ) );
+
+		fCurrent.fInput = input;
+		fCurrent.fFollowsIdle = true;
+	}
+
+	fCurrent.fMarks[mark] = now;
+
+	if ( kPresent == mark )
+	{
+		EndFrame( now );
+	}
+}
+
+void
+FramePacing::EndFrame( Rtt_AbsoluteTime now )
+{
+	Real interval = Rtt_REAL_0;
+	if ( fCount > 0 && ! fCurrent.fFollowsIdle )
+	{
+		interval = ElapsedMS( FrameAt( 0 ).fMarks[kPresent], now );
+	}
+
+	fLatestInterval = interval;
+
+	fFrames[fNext] = fCurrent;
+	fNext = ( fNext + 1 ) % kCapacity;
+	fCount = std::min( fCount + 1, (U32)kCapacity );
+	++fTotalFrames;
+
+	memset( & fCurrent, 0, sizeof( fCurrent ) );
+
+	if ( interval > fBudget * kMissedFrameFactor )
+	{
+		++fMissedFrames;
+		++fWarningMissed;
+		fWarningWorst = std::max( fWarningWorst, interval );
+	}
+	++fWarningFrames;
+
+	CheckBudget( now );
+}
+
+void
+FramePacing::CheckBudget( Rtt_AbsoluteTime now )
+{
+	if ( 0 == fWarningStart )
+	{
+		fWarningStart = now;
+		return;
+	}
+
+	if ( ElapsedMS( fWarningStart, now ) < kWarningInterval * 1000.0f )
+	{
+		return;
+	}
+
+	if ( fIsWarningEnabled && fWarningMissed > 0 )
+	{
+		Rtt_LogException( "WARNING: %u of the last %u frames missed the %.1f ms frame budget (worst %.1f ms). Use system.getFrameStats() for details.\n",
+			fWarningMissed, fWarningFrames, fBudget, fWarningWorst );
+	}
+
+	fWarningStart = now;
+	fWarningFrames = 0;
+	fWarningMissed = 0;
+	fWarningWorst = Rtt_REAL_0;
+}
+
+const FramePacing::Frame&
+FramePacing::FrameAt( U32 age ) const
+{
+	Rtt_ASSERT( age < fCount );
+
+	return fFrames[( fNext + kCapacity - 1 - age ) % kCapacity];
+}
+
+void
+FramePacing::Push( lua_State *L ) const
+{
+	std::vector< Real > interval, logic, render, present, input;
+	interval.reserve( fCount );
+
+	Real jitter = Rtt_REAL_0;
+	U32 jitterCount = 0;
+	Real previous = -Rtt_REAL_1;
+
+	// Oldest first, so consecutive intervals are adjacent for jitter
+	for ( S32 age = (S32)fCount - 1; age >= 0; age-- )
+	{
+		const Frame& frame = FrameAt( age );
+		const Rtt_AbsoluteTime *marks = frame.fMarks;
+
+		if ( frame.fFollowsIdle )
+		{
+			previous = -Rtt_REAL_1; // jitter only compares adjacent intervals
+		}
+		else if ( age + 1 < (S32)fCount )
+		{
+			Real value = ElapsedMS( FrameAt( age + 1 ).fMarks[kPresent], marks[kPresent] );
+			if ( previous >= Rtt_REAL_0 )
+			{
+				jitter += Rtt_RealAbs( value - previous );
+				++jitterCount;
+			}
+			interval.push_back( value );
+			previous = value;
+		}
+
+		if ( marks[kLogicStart] && marks[kLogicEnd] )
+		{
+			logic.push_back( ElapsedMS( marks[kLogicStart], marks[kLogicEnd] ) );
+		}
+		if ( marks[kRenderStart] && marks[kSwap] )
+		{
+			render.push_back( ElapsedMS( marks[kRenderStart], marks[kSwap] ) );
+		}
+		if ( marks[kSwap] )
+		{
+			present.push_back( ElapsedMS( marks[kSwap], marks[kPresent] ) );
+		}
+		if ( frame.fInput )
+		{
+			input.push_back( ElapsedMS( frame.fInput, marks[kPresent] ) );
+		}
+	}
+
+	lua_createtable( L, 0, 10 );
+
+	lua_pushinteger( L, fCount );
+	lua_setfield( L, -2, "frames" );
+	lua_pushnumber( L, (lua_Number)fTotalFrames );
+	lua_setfield( L, -2, "totalFrames" );
+	lua_pushnumber( L, (lua_Number)fMissedFrames );
+	lua_setfield( L, -2, "missedFrames" );
+	lua_pushnumber( L, fBudget );
+	lua_setfield( L, -2, "budget" );
+	lua_pushnumber( L, jitterCount > 0 ? jitter / jitterCount : Rtt_REAL_0 );
+	lua_setfield( L, -2, "jitter" );
+
+	PushSummary( L, "interval", interval );
+	PushSummary( L, "logic", logic );
+	PushSummary( L, "render", render );
+	PushSummary( L, "present", present );
+	PushSummary( L, "inputLatency", input );
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
@@ -0,0 +1,132 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_FramePacing_H__
+#define _Rtt_FramePacing_H__
+
+#include "Core/Rtt_Types.h"
+#include "Core/Rtt_Time.h"
+
+// ----------------------------------------------------------------------------
+
+struct lua_State;
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Keeps wall-clock timestamps of the last kCapacity presented frames, so
+// that missed frames, jitter and input latency can be summarized on demand
+// (system.getFrameStats()). A frame is recorded when it is presented; the
+// last logic tick and any input since the previous presented frame belong
+// to it. Logic ticks that present nothing, e.g. while the scene is static,
+// are idle: the interval across them is not a missed frame.
+//
+// Every kWarningInterval, a warning is logged if frames missed their budget
+// in that interval, so regressions show up in device logs.
+class FramePacing
+{
+	Rtt_CLASS_NO_COPIES( FramePacing )
+
+	public:
+		typedef FramePacing Self;
+
+		typedef enum _Mark
+		{
+			kLogicStart = 0,
+			kLogicEnd,
+			kRenderStart,
+			kSwap,
+			kPresent,
+
+			kNumMarks
+		}
+		Mark;
+
+		enum
+		{
+			kCapacity = 256,
+			kWarningInterval = 10, // seconds
+		};
+
+	public:
+		FramePacing();
+
+	public:
+		// Time per frame in ms, normally the effective timer interval.
+		Real GetBudget() const { return fBudget; }
+		void SetBudget( Real newValue ) { fBudget = newValue; }
+
+		// Present-to-present interval of the latest frame in ms, or 0 if
+		// there is none, e.g. when that frame followed idle ticks.
+		Real GetLatestInterval() const { return fLatestInterval; }
+
+		// Number of frames presented since launch.
+		U64 GetTotalFrames() const { return fTotalFrames; }
+
+		// Warnings are on by default.
+		bool IsWarningEnabled() const { return fIsWarningEnabled; }
+		void SetWarningEnabled( bool newValue ) { fIsWarningEnabled = newValue; }
+
+		// Called when an input event is dispatched. Only the first input
+		// before a frame counts towards its latency.
+		void MarkInput();
+
+		// Records the current time for the frame in progress. kPresent
+		// completes the frame.
+		void MarkFrame( Mark mark );
+
+	public:
+		// {
+		//   frames = <recorded>, totalFrames = <since launch>,
+		//   missedFrames = <since launch>, budget = <ms>, jitter = <ms>,
+		//   interval = { mean, p50, p95, p99, max }, -- present to present, idle gaps excluded
+		//   logic = {...}, render = {...}, present = {...}, inputLatency = {...}
+		// }
+		// All times in ms. Summaries of stages no frame went through are
+		// omitted.
+		void Push( lua_State *L ) const;
+
+	private:
+		struct Frame
+		{
+			Rtt_AbsoluteTime fMarks[kNumMarks]; // 0 if not reached
+			Rtt_AbsoluteTime fInput;
+			bool fFollowsIdle; // Interval since the previous frame is not meaningful
+		};
+
+		void EndFrame( Rtt_AbsoluteTime now );
+		void CheckBudget( Rtt_AbsoluteTime now );
+
+		const Frame& FrameAt( U32 age ) const; // 0 is the latest
+
+	private:
+		Frame fFrames[kCapacity];
+		U32 fNext;
+		U32 fCount;
+		Frame fCurrent;
+		Real fBudget;
+		Real fLatestInterval;
+		bool fIsWarningEnabled;
+		U64 fTotalFrames;
+		U64 fMissedFrames;
+		Rtt_AbsoluteTime fWarningStart;
+		U32 fWarningFrames;
+		U32 fWarningMissed;
+		Real fWarningWorst;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_FramePacing_H__
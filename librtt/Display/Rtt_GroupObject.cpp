@@ -16,6 +16,7 @@
 #include "Display/Rtt_Scene.h"
 #include "Display/Rtt_StageObject.h"
 #include "Renderer/Rtt_Renderer.h"
+#include "Renderer/Rtt_StaticBatch.h"
 #include "Rtt_LuaProxyVTable.h"
 
 #include "Rtt_Profiling.h"
@@ -97,6 +98,7 @@ GroupObject::GroupObject( Rtt_Allocator* pAllocator, StageObject* canvas )
     fSelfBoundsYMax( Rtt_REAL_0 ),
     fHasFixedSelfBounds( false ),
     fChildrenNeedTransformUpdate( false ),
+    fStaticBatch( NULL ),
     fChildren( pAllocator )
 {
     SetObjectDesc("GroupObject"); // for introspection
@@ -111,11 +113,17 @@ GroupObject::GroupObject( Rtt_Allocator* pAllocator, StageObject* canvas, Real w
     fSelfBoundsYMax( Rtt_RealDiv2( height > Rtt_REAL_0 ? height : Rtt_REAL_0 ) ),
     fHasFixedSelfBounds( true ),
     fChildrenNeedTransformUpdate( false ),
+    fStaticBatch( NULL ),
     fChildren( pAllocator )
 {
     SetObjectDesc( "GroupObject" ); // for introspection
 }
 
+GroupObject::~GroupObject()
+{
+    Rtt_DELETE( fStaticBatch );
+}
+
 GroupObject*
 GroupObject::AsGroupObject()
 {
@@ -251,6 +259,7 @@ GroupObject::Prepare( const Display& display )
                 }
 
                 child->Prepare( display );
+                child->CollectDamage();
             }
         }
 
@@ -280,15 +289,38 @@ GroupObject::Draw( Renderer& renderer ) const
             renderer.PushMask( texture, uniform );
         }
 
-        for ( S32 i = 0, iMax = fChildren.Length(); i < iMax; i++ )
+        // When an enclosing static group is recording, the children are
+        // drawn as usual so they become part of that batch instead.
+        StaticBatch *batch = ( renderer.IsRecordingStaticBatch() ? NULL : fStaticBatch );
+
+        if ( batch && batch->IsBaked() )
         {
-            const DisplayObject *child = fChildren[i];
+            batch->Draw( renderer );
+        }
+        else
+        {
+            bool shouldRecord = batch && batch->WillDrawContents();
 
-			if ( ! child->IsOffScreen() )
-			{
-				child->Draw( renderer );
-			}
-		}
+            if ( shouldRecord )
+            {
+                renderer.BeginStaticBatch( batch );
+            }
+
+            for ( S32 i = 0, iMax = fChildren.Length(); i < iMax; i++ )
+            {
+                const DisplayObject *child = fChildren[i];
+
+                if ( ! child->IsOffScreen() )
+                {
+                    child->Draw( renderer );
+                }
+            }
+
+            if ( shouldRecord )
+            {
+                renderer.EndStaticBatch();
+            }
+        }
 
         if ( mask )
         {
@@ -451,9 +483,39 @@ GroupObject::ShouldOffsetWithAnchor() const
     return IsProperty( kIsAnchorChildren );
 }
 
+void
+GroupObject::SetStatic( bool newValue )
+{
+    if ( newValue != IsStatic() )
+    {
+        if ( newValue )
+        {
+            fStaticBatch = Rtt_NEW( Allocator(), StaticBatch( Allocator() ) );
+        }
+        else
+        {
+            Rtt_DELETE( fStaticBatch );
+            fStaticBatch = NULL;
+        }
+
+        InvalidateDisplay();
+    }
+}
+
+void
+GroupObject::InvalidateStaticBatch()
+{
+    if ( fStaticBatch )
+    {
+        fStaticBatch->Invalidate();
+    }
+}
+
 void
 GroupObject::DidInsert( bool childParentChanged )
 {
+    InvalidateStaticBatch();
+
     if ( childParentChanged && StageBoundsDependsOnChildren() )
     {
         Invalidate( kStageBoundsFlag );
@@ -467,6 +529,8 @@ GroupObject::DidInsert( bool childParentChanged )
 void
 GroupObject::DidRemove()
 {
+    InvalidateStaticBatch();
+
     if ( StageBoundsDependsOnChildren() )
     {
         Invalidate( kStageBoundsFlag );
@@ -553,6 +617,8 @@ GroupObject::Insert( S32 index, DisplayObject* newChild, bool resetTransform )
 void
 GroupObject::Remove( S32 index )
 {
+    // Damage the area the child was drawn into
+    fChildren[index]->InvalidateDisplay();
     fChildren.Remove( index, 1 );
 
     //++TransactionId();
@@ -566,6 +632,8 @@ GroupObject::Release( S32 index )
 
     if (index < NumChildren())
     {
+        // Damage the area the child was drawn into
+        fChildren[index]->InvalidateDisplay();
         child = fChildren.Release( index );
         child->SetParent( NULL );
 
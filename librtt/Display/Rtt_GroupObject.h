@@ -19,6 +19,7 @@ namespace Rtt
 {
 
 class Scene;
+class StaticBatch;
 
 // ----------------------------------------------------------------------------
 
@@ -37,6 +38,7 @@ class GroupObject : public DisplayObject
 	public:
 		GroupObject( Rtt_Allocator* pAllocator, StageObject* canvas );
 		GroupObject( Rtt_Allocator* pAllocator, StageObject* canvas, Real width, Real height );
+		virtual ~GroupObject();
 
 	public:
 		// Super
@@ -88,6 +90,13 @@ class GroupObject : public DisplayObject
 	public:
 		Rtt_Allocator* Allocator() const { return fChildren.Allocator(); }
 
+	public:
+		// Static groups retain what their children draw in GPU buffers and
+		// redraw it as is, until anything in the subtree is invalidated.
+		bool IsStatic() const { return NULL != fStaticBatch; }
+		void SetStatic( bool newValue );
+		void InvalidateStaticBatch();
+
 	private:
 		void SetFixedSelfBounds( const Rect& rect );
 
@@ -99,6 +108,7 @@ class GroupObject : public DisplayObject
 		Real fSelfBoundsYMax;
 		bool fHasFixedSelfBounds;
 		bool fChildrenNeedTransformUpdate;
+		StaticBatch* fStaticBatch;
 
 	protected:
 		// Children are drawn in order, i.e. first child is drawn below the second
@@ -86,7 +86,7 @@ void ImageSheet::Initialize(lua_State *L) {
     Lua::InitializeMetatable(L, Self::kMetatableName, kVTable);
 }
 
-ImageSheet::ImageSheet(Rtt_Allocator *allocator, const SharedPtr<TextureResource> &resource) : fResource(resource), fFrames(allocator) {
+ImageSheet::ImageSheet(Rtt_Allocator *allocator, const SharedPtr<TextureResource> &resource) : fResource(resource), fFrames(allocator), fPaintCount(0) {
 	
 }
 
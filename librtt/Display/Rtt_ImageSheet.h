@@ -34,6 +34,8 @@ class PlatformBitmap;
 
 class ImageSheet
 {
+	friend class TextureAtlas;
+
 	public:
 		typedef ImageSheet Self;
 
@@ -72,9 +74,16 @@ class ImageSheet
 		const ImageFrame* GetFrame( int index ) const { return fFrames[index]; }
 		S32 GetNumFrames() const { return fFrames.Length(); }
 
+	public:
+		// Number of paints drawing from this sheet
+		U32 GetPaintCount() const { return fPaintCount; }
+		void DidAttachPaint() { ++fPaintCount; }
+		void WillDetachPaint() { Rtt_ASSERT( fPaintCount > 0 ); --fPaintCount; }
+
 	private:
 		SharedPtr< TextureResource > fResource;
 		PtrArray< ImageFrame > fFrames;
+		U32 fPaintCount;
 };
 
 // ----------------------------------------------------------------------------
@@ -59,10 +59,13 @@ ImageSheetPaint::ImageSheetPaint( const AutoPtr< ImageSheet >& sheet, int frameI
 	fFrameIndex( frameIndex )
 {
 	Initialize( kImageSheet );
+
+	fSheet->DidAttachPaint();
 }
 
 ImageSheetPaint::~ImageSheetPaint()
 {
+	fSheet->WillDetachPaint();
 }
 
 const Paint*
@@ -500,6 +500,15 @@ DisplayLibrary::PushImage(
 	Real width = Rtt_IntToReal( bitmap ? bitmap->Width() : texture->GetWidth() );
 	Real height = Rtt_IntToReal( bitmap ? bitmap->Height() : texture->GetHeight() );
 
+	// Images packed into the runtime atlas are a frame of a larger page
+	const ImageSheetPaint *sheetPaint = static_cast< const ImageSheetPaint * >( paint->AsPaint( Paint::kImageSheet ) );
+	if ( sheetPaint )
+	{
+		const ImageFrame *frame = sheetPaint->GetImageFrame();
+		width = Rtt_IntToReal( frame->GetWidth() );
+		height = Rtt_IntToReal( frame->GetHeight() );
+	}
+
     // Create the image object with the above dimensions.
     ShapeObject* v = PushImage( L, topLeft, paint, display, parent, width, height, replacement );
 
@@ -609,7 +618,7 @@ DisplayLibrary::newImage( lua_State *L )
         p = & topLeft;
 
 		Runtime& runtime = library->GetDisplay().GetRuntime();
-		BitmapPaint *paint = BitmapPaint::NewBitmap( runtime, imageName, baseDir, 0x0 );
+		BitmapPaint *paint = BitmapPaint::NewImage( runtime, imageName, baseDir, 0x0 );
 
         if ( paint && paint->GetBitmap() && paint->GetBitmap()->NumBytes() == 0 )
         {
@@ -721,7 +730,7 @@ DisplayLibrary::newImageRect( lua_State *L )
             Real h = luaL_toreal( L, nextArg++ );
 
 			Runtime& runtime = library->GetDisplay().GetRuntime();
-			BitmapPaint *paint = BitmapPaint::NewBitmap( runtime, imageName, baseDir, PlatformBitmap::kIsBitsFullResolution );
+			BitmapPaint *paint = BitmapPaint::NewImage( runtime, imageName, baseDir, PlatformBitmap::kIsBitsFullResolution );
 
             if ( paint && paint->GetBitmap() && paint->GetBitmap()->NumBytes() == 0 )
             {
@@ -1152,17 +1161,27 @@ DisplayLibrary::getDefault( lua_State *L )
     {
         lua_pushinteger( L, defaults.GetAddedStencilClearValue() );
     }
-#ifdef Rtt_WIN_ENV
+    else if ( ( Rtt_StringCompare( key, "partialRedraw" ) == 0 ) )
+    {
+        bool value = defaults.IsPartialRedraw();
+        lua_pushboolean( L, value ? 1 : 0 );
+    }
+    else if ( ( Rtt_StringCompare( key, "interpolation" ) == 0 ) )
+    {
+        bool value = defaults.IsInterpolating();
+        lua_pushboolean( L, value ? 1 : 0 );
+    }
     else if (Rtt_StringCompare(key, "renderSync") == 0)
     {
         // Returns true if render-only vsync ticks are enabled.
         // On Windows, this syncs the display to the monitor refresh rate
         // even when no logic tick has fired  reducing compositor jitter
-        // on high-refresh displays. Returns nil on other platforms.
+        // on high-refresh displays. Windows and Linux support it; false on
+        // other platforms.
         Runtime& runtime = *LuaContext::GetRuntime(L);
-        lua_pushboolean(L, runtime.GetTimer()->GetFrameSync() ? 1 : 0);
+        PlatformTimer* timer = runtime.GetTimer();
+        lua_pushboolean(L, timer && timer->GetFrameSync() ? 1 : 0);
     }
-#endif
     else if ( key )
     {
         luaL_error( L, "ERROR: display.getDefault() given invalid key (%s)", key );
@@ -1340,7 +1359,19 @@ DisplayLibrary::setDefault( lua_State *L )
         U32 stencil = lua_tointeger( L, index );
         defaults.SetAddedStencilClearValue( stencil );
     }
-#ifdef Rtt_WIN_ENV
+    else if ( ( Rtt_StringCompare( key, "partialRedraw" ) == 0 ) )
+    {
+        bool value = lua_toboolean( L, index ) ? true : false;
+        defaults.SetPartialRedraw( value );
+        display.Invalidate(); // Start from a fully drawn frame
+    }
+    else if ( ( Rtt_StringCompare( key, "interpolation" ) == 0 ) )
+    {
+        // Only has a visible effect with renderSync, i.e. when frames are
+        // rendered between logic ticks
+        bool value = lua_toboolean( L, index ) ? true : false;
+        defaults.SetInterpolating( value );
+    }
     else if (Rtt_StringCompare(key, "renderSync") == 0)
     {
         // When true, the render loop invalidates the display every vsync
@@ -1348,12 +1379,16 @@ DisplayLibrary::setDefault( lua_State *L )
         // refresh rate. This reduces compositor jitter on high-refresh displays
         // at the cost of ~1W additional GPU power draw.
         // When false, the display redraws only when a logic tick fires.
-        // Defaults to true on Windows. No-op on other platforms.
+        // Defaults to true on Windows and false on Linux. No-op on other
+        // platforms.
         bool value = lua_toboolean(L, index) ? true : false;
         Runtime& runtime = *LuaContext::GetRuntime(L);
-        runtime.GetTimer()->SetFrameSync(value);
+        PlatformTimer* timer = runtime.GetTimer();
+        if (timer)
+        {
+            timer->SetFrameSync(value);
+        }
     }
-#endif
     else if ( key )
     {
         luaL_error( L, "ERROR: display.setDefault() given invalid key (%s)", key );
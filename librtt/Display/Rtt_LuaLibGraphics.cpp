@@ -25,6 +25,7 @@
 #include "Display/Rtt_ImageSheetUserdata.h"
 #include "Display/Rtt_ShaderFactory.h"
 #include "Display/Rtt_ShaderTypes.h"
+#include "Display/Rtt_ShaderWarmup.h"
 #include "Display/Rtt_TextureResource.h"
 #include "Rtt_LuaAux.h"
 #include "Rtt_LuaLibSystem.h"
@@ -33,6 +34,8 @@
 #include "Rtt_LuaContext.h"
 #include "Rtt_LuaLibNative.h"
 #include "Renderer/Rtt_FormatExtensionList.h"
+#include "Renderer/Rtt_Renderer.h"
+#include "Rtt_Runtime.h"
 
 
 #include <float.h>
@@ -88,6 +91,9 @@ class GraphicsLibrary
 		static int defineShellTransform( lua_State *L );
 		static int defineVertexExtension( lua_State *L );
 		static int listEffects( lua_State *L );
+		static int getShaderUsage( lua_State *L );
+		static int precompileShaders( lua_State *L );
+		static int captureCommandStream( lua_State *L );
 		static int newTexture( lua_State *L );
 		static int releaseTextures( lua_State *L );
         static int undefineEffect( lua_State *L );
@@ -130,6 +136,9 @@ GraphicsLibrary::Open( lua_State *L )
         { "defineShellTransform", defineShellTransform },
         { "defineVertexExtension", defineVertexExtension },
 		{ "listEffects", listEffects },
+		{ "getShaderUsage", getShaderUsage },
+		{ "precompileShaders", precompileShaders },
+		{ "captureCommandStream", captureCommandStream },
 		{ "newTexture", newTexture },
 		{ "releaseTextures", releaseTextures },
         { "undefineEffect", undefineEffect },
@@ -815,6 +824,66 @@ GraphicsLibrary::listEffects( lua_State *L )
     factory.PushList( L, c );
     return 1;
 }
+
+// graphics.getShaderUsage()
+// Returns { ["filter.blur"] = { 0, 1 }, ... }, i.e. the mask counts each
+// effect has been drawn with so far.
+int
+GraphicsLibrary::getShaderUsage( lua_State *L )
+{
+    GraphicsLibrary *library = GraphicsLibrary::ToLibrary( L );
+
+    ShaderWarmup::Push( L, library->GetDisplay().GetShaderWarmup().GetUsage() );
+    return 1;
+}
+
+// graphics.precompileShaders( [usage] )
+// Compiles the effects in 'usage' (same format as getShaderUsage(), or an
+// array of effect names) now rather than on first use. Without arguments,
+// uses the manifest recorded by earlier runs. Returns the number compiled.
+int
+GraphicsLibrary::precompileShaders( lua_State *L )
+{
+    GraphicsLibrary *library = GraphicsLibrary::ToLibrary( L );
+    ShaderWarmup& warmup = library->GetDisplay().GetShaderWarmup();
+
+    ShaderWarmup::Usage usage;
+
+    if ( lua_istable( L, 1 ) )
+    {
+        ShaderWarmup::Read( L, 1, usage );
+    }
+    else
+    {
+        warmup.LoadManifest( usage );
+    }
+
+    lua_pushinteger( L, warmup.Compile( usage ) );
+    return 1;
+}
+
+// graphics.captureCommandStream( filename [, baseDir] )
+// Writes the render commands of the next frame, and everything they draw
+// with, to a file that the replay tool can run without the app. baseDir
+// defaults to system.DocumentsDirectory. Returns the full path.
+int
+GraphicsLibrary::captureCommandStream( lua_State *L )
+{
+    GraphicsLibrary *library = GraphicsLibrary::ToLibrary( L );
+    Display& display = library->GetDisplay();
+
+    const char *filename = luaL_checkstring( L, 1 );
+    MPlatform::Directory baseDir = LuaLibSystem::ToDirectory( L, 2, MPlatform::kDocumentsDir );
+
+    const MPlatform& platform = display.GetRuntime().Platform();
+    String path( & platform.GetAllocator() );
+    platform.PathForFile( filename, baseDir, MPlatform::kDefaultPathFlags, path );
+
+    display.GetRenderer().CaptureNextFrame( path.GetString() );
+
+    lua_pushstring( L, path.GetString() );
+    return 1;
+}
 //helper funciton to parse lua table to create bitmap resource
 SharedPtr<TextureResource> CreateResourceBitmapFromTable(Rtt::TextureFactory &factory, lua_State *L, int index)
 {
@@ -0,0 +1,322 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_RenderScale.h"
+
+#include "Display/Rtt_Display.h"
+#include "Display/Rtt_FramePacing.h"
+#include "Display/Rtt_Scene.h"
+#include "Display/Rtt_Shader.h"
+#include "Display/Rtt_ShaderFactory.h"
+#include "Display/Rtt_ShaderResource.h"
+#include "Display/Rtt_TextureFactory.h"
+#include "Display/Rtt_TextureResource.h"
+#include "Renderer/Rtt_FrameBufferObject.h"
+#include "Renderer/Rtt_Geometry_Renderer.h"
+#include "Renderer/Rtt_Matrix_Renderer.h"
+#include "Renderer/Rtt_Renderer.h"
+#include "Renderer/Rtt_Texture.h"
+#include "Rtt_Lua.h"
+
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Presents can't come faster than the budget, so the interval only shows
+// missed frames, not headroom. Scale down once the average interval exceeds
+// the budget by kHighWater. Scale back up only after kSteadyWindows in a row
+// within kLowWater of it, so a step down doesn't immediately undo itself.
+static const Real kHighWater = 1.1f;
+static const Real kLowWater = 1.02f;
+static const U32 kSteadyWindows = 5;
+
+static const Real kDefaultStep = 0.1f;
+
+static const U32 kAdjustInterval = 1000; // ms
+
+// ----------------------------------------------------------------------------
+
+RenderScale::RenderScale( Scene& owner )
+:	fOwner( owner ),
+	fMin( Rtt_REAL_1 ),
+	fMax( Rtt_REAL_1 ),
+	fStep( kDefaultStep ),
+	fScale( Rtt_REAL_1 ),
+	fIntervalSum( Rtt_REAL_0 ),
+	fIntervalCount( 0 ),
+	fLastFrame( 0 ),
+	fSteadyCount( 0 ),
+	fWindowStart( 0 ),
+	fTexture(),
+	fFrameBufferObject( NULL ),
+	fGeometry( NULL ),
+	fData(),
+	fSavedFrameBufferObject( NULL )
+{
+	memset( fSavedViewport, 0, sizeof( fSavedViewport ) );
+
+	// The offscreen texture replaces the window, so there is nothing to blend with
+	fData.fBlendEquation = RenderTypes::kDisabledEquation;
+}
+
+RenderScale::~RenderScale()
+{
+	ReleaseTarget();
+
+	if ( fGeometry )
+	{
+		fOwner.QueueRelease( fGeometry );
+	}
+}
+
+void
+RenderScale::Read( lua_State *L, int index )
+{
+	if ( lua_type( L, index ) == LUA_TNUMBER )
+	{
+		fMin = fMax = (Real)lua_tonumber( L, index );
+	}
+	else if ( lua_istable( L, index ) )
+	{
+		lua_getfield( L, index, "min" );
+		fMin = luaL_optnumber( L, -1, 0.5 );
+		lua_pop( L, 1 );
+
+		lua_getfield( L, index, "max" );
+		fMax = luaL_optnumber( L, -1, 1.0 );
+		lua_pop( L, 1 );
+
+		lua_getfield( L, index, "step" );
+		fStep = luaL_optnumber( L, -1, kDefaultStep );
+		lua_pop( L, 1 );
+	}
+	else
+	{
+		return;
+	}
+
+	// Below 1/4 of the window's resolution, text and thin lines are unreadable
+	const Real kLowest = 0.25f;
+	fMax = Min( Max( fMax, kLowest ), Rtt_REAL_1 );
+	fMin = Min( Max( fMin, kLowest ), fMax );
+	fStep = Max( fStep, 0.01f );
+	fScale = fMax;
+}
+
+bool
+RenderScale::Update( const FramePacing& pacing )
+{
+	if ( ! IsAdaptive() )
+	{
+		return false;
+	}
+
+	// Render() can run several times per present, e.g. when nothing was
+	// damaged, so only count each presented frame once
+	if ( pacing.GetTotalFrames() != fLastFrame )
+	{
+		fLastFrame = pacing.GetTotalFrames();
+
+		Real interval = pacing.GetLatestInterval();
+		if ( interval > Rtt_REAL_0 )
+		{
+			fIntervalSum += interval;
+			++fIntervalCount;
+		}
+	}
+
+	Rtt_AbsoluteTime now = Rtt_GetAbsoluteTime();
+	if ( 0 == fWindowStart )
+	{
+		fWindowStart = now;
+	}
+
+	if ( Rtt_AbsoluteToMilliseconds( now - fWindowStart ) < kAdjustInterval || 0 == fIntervalCount )
+	{
+		return false;
+	}
+
+	Real average = fIntervalSum / fIntervalCount;
+	fIntervalSum = Rtt_REAL_0;
+	fIntervalCount = 0;
+	fWindowStart = now;
+
+	Real budget = pacing.GetBudget();
+	Real scale = fScale;
+	if ( average > budget * kHighWater )
+	{
+		scale = Max( fScale - fStep, fMin );
+		fSteadyCount = 0;
+	}
+	else if ( average < budget * kLowWater )
+	{
+		if ( ++fSteadyCount >= kSteadyWindows )
+		{
+			scale = Min( fScale + fStep, fMax );
+			fSteadyCount = 0;
+		}
+	}
+	else
+	{
+		fSteadyCount = 0;
+	}
+
+	bool result = ( scale != fScale );
+	if ( result )
+	{
+		Rtt_TRACE( ( "Render scale %.2f -> %.2f (%.2f ms of %.2f ms)\n", fScale, scale, average, budget ) );
+		fScale = scale;
+	}
+
+	return result;
+}
+
+bool
+RenderScale::BeginOffscreen( Renderer& renderer )
+{
+	if ( fScale >= Rtt_REAL_1 )
+	{
+		ReleaseTarget();
+		return false;
+	}
+
+	const Display& display = fOwner.GetDisplay();
+
+	// The whole screen, including any letterbox area, which lies outside
+	// of the content area when screenOriginX/Y are negative
+	const Rect& bounds = display.GetScreenContentBounds();
+	Real toScreen = fScale / display.GetScreenToContentScale();
+
+	S32 width = Max( Rtt_RealToInt( ( bounds.xMax - bounds.xMin ) * toScreen + 0.5f ), 1 );
+	S32 height = Max( Rtt_RealToInt( ( bounds.yMax - bounds.yMin ) * toScreen + 0.5f ), 1 );
+	Resize( width, height );
+
+	// Save current state so we can restore it later
+	fSavedFrameBufferObject = renderer.GetFrameBufferObject();
+	renderer.GetFrustum( fSavedViewMatrix, fSavedProjMatrix );
+	renderer.GetViewport( fSavedViewport[0], fSavedViewport[1], fSavedViewport[2], fSavedViewport[3] );
+
+	// As with snapshots, y is not inverted, so that the texture's first row
+	// is the top of the screen.
+	Real viewMatrix[16];
+	CreateViewMatrix( 0.0f, 0.0f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, viewMatrix );
+
+	Real projMatrix[16];
+	CreateOrthoMatrix( bounds.xMin, bounds.xMax, bounds.yMin, bounds.yMax, 0.0f, 1.0f, projMatrix );
+
+	renderer.SetFrameBufferObject( fFrameBufferObject );
+	renderer.SetFrustum( viewMatrix, projMatrix );
+	renderer.SetViewport( 0, 0, width, height );
+
+	return true;
+}
+
+void
+RenderScale::EndOffscreen( Renderer& renderer )
+{
+	renderer.SetViewport( fSavedViewport[0], fSavedViewport[1], fSavedViewport[2], fSavedViewport[3] );
+	renderer.SetFrustum( fSavedViewMatrix, fSavedProjMatrix );
+	renderer.SetFrameBufferObject( fSavedFrameBufferObject );
+}
+
+void
+RenderScale::Present( Renderer& renderer )
+{
+	Rtt_ASSERT( fFrameBufferObject );
+
+	const Display& display = fOwner.GetDisplay();
+
+	if ( ! fGeometry )
+	{
+		Rtt_Allocator *allocator = display.GetAllocator();
+		fGeometry = Rtt_NEW( allocator, Geometry( allocator, Geometry::kTriangleStrip, 4, 0, false ) );
+	}
+
+	// Cover the same bounds BeginOffscreen() projected
+	const Rect& bounds = display.GetScreenContentBounds();
+
+	fGeometry->SetVerticesUsed( 0 );
+
+	Geometry::Vertex v;
+	v.Zero();
+	v.q = 1.f;
+	v.rs = v.gs = v.bs = v.as = 0xFF;
+
+	v.x = bounds.xMin; v.y = bounds.yMin; v.u = 0.f; v.v = 0.f;
+	fGeometry->Append( v );
+	v.x = bounds.xMin; v.y = bounds.yMax; v.u = 0.f; v.v = 1.f;
+	fGeometry->Append( v );
+	v.x = bounds.xMax; v.y = bounds.yMin; v.u = 1.f; v.v = 0.f;
+	fGeometry->Append( v );
+	v.x = bounds.xMax; v.y = bounds.yMax; v.u = 1.f; v.v = 1.f;
+	fGeometry->Append( v );
+
+	Shader& shader = display.GetShaderFactory().GetDefault();
+	shader.Prepare( fData, Rtt_RealToInt( bounds.xMax - bounds.xMin ), Rtt_RealToInt( bounds.yMax - bounds.yMin ), ShaderResource::kDefault );
+
+	fData.fGeometry = fGeometry;
+	fData.fFillTexture0 = fFrameBufferObject->GetTexture();
+
+	shader.Draw( renderer, fData );
+}
+
+void
+RenderScale::Resize( S32 width, S32 height )
+{
+	if ( fFrameBufferObject )
+	{
+		const Texture *texture = fFrameBufferObject->GetTexture();
+		if ( (S32)texture->GetWidth() == width && (S32)texture->GetHeight() == height )
+		{
+			return;
+		}
+
+		ReleaseTarget();
+	}
+
+	Display& display = fOwner.GetDisplay();
+	Rtt_Allocator *allocator = display.GetAllocator();
+
+	// Linear filtering, since the texture is always magnified
+	fTexture = display.GetTextureFactory().Create(
+		width,
+		height,
+		Texture::kRGBA,
+		Texture::kLinear,
+		Texture::kClampToEdge,
+		false );
+
+	fFrameBufferObject = Rtt_NEW( allocator, FrameBufferObject( allocator, & fTexture->GetTexture() ) );
+}
+
+void
+RenderScale::ReleaseTarget()
+{
+	if ( fFrameBufferObject )
+	{
+		fOwner.QueueRelease( fFrameBufferObject );
+		fFrameBufferObject = NULL;
+	}
+
+	fTexture = SharedPtr< TextureResource >();
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_RenderScale_H__
+#define _Rtt_RenderScale_H__
+
+#include "Core/Rtt_SharedPtr.h"
+#include "Core/Rtt_Time.h"
+#include "Core/Rtt_Types.h"
+#include "Renderer/Rtt_RenderData.h"
+
+// ----------------------------------------------------------------------------
+
+struct lua_State;
+
+namespace Rtt
+{
+
+class FrameBufferObject;
+class FramePacing;
+class Geometry;
+class Renderer;
+class Scene;
+class TextureResource;
+
+// ----------------------------------------------------------------------------
+
+// Dynamic resolution. When enabled, the stage is drawn into an offscreen
+// texture at a fraction of the window's resolution, which is then stretched
+// over the window. Once a second, the fraction is adjusted from the measured
+// present-to-present interval: lowered while frames miss the budget, and
+// raised again after a few seconds of meeting it.
+class RenderScale
+{
+	Rtt_CLASS_NO_COPIES( RenderScale )
+
+	public:
+		typedef RenderScale Self;
+
+	public:
+		RenderScale( Scene& owner );
+		~RenderScale();
+
+	public:
+		// content.renderScale in config.lua. Either a fixed scale, or
+		// { min = 0.5, max = 1 [, step = 0.1] }. Disabled by default.
+		void Read( lua_State *L, int index );
+
+		bool IsEnabled() const { return fMin < Rtt_REAL_1; }
+		bool IsAdaptive() const { return fMin < fMax; }
+		Real GetScale() const { return fScale; }
+
+	public:
+		// Feeds the frames presented so far. Returns true if the scale
+		// changed, in which case the whole window must be redrawn.
+		bool Update( const FramePacing& pacing );
+
+		// Returns false at full scale, in which case the frame is drawn as
+		// usual. Otherwise the renderer draws into the offscreen texture
+		// until EndOffscreen().
+		bool BeginOffscreen( Renderer& renderer );
+
+		// Restores the window as the target. The caller clears it, then
+		// calls Present() to stretch the offscreen texture over it.
+		void EndOffscreen( Renderer& renderer );
+		void Present( Renderer& renderer );
+
+	private:
+		void Resize( S32 width, S32 height );
+		void ReleaseTarget();
+
+	private:
+		Scene& fOwner;
+		Real fMin;
+		Real fMax;
+		Real fStep;
+		Real fScale;
+		Real fIntervalSum;
+		U32 fIntervalCount;
+		U64 fLastFrame;
+		U32 fSteadyCount;
+		Rtt_AbsoluteTime fWindowStart;
+		SharedPtr< TextureResource > fTexture;
+		FrameBufferObject *fFrameBufferObject;
+		Geometry *fGeometry;
+		RenderData fData;
+
+		// Window state saved by BeginOffscreen()
+		FrameBufferObject *fSavedFrameBufferObject;
+		S32 fSavedViewport[4];
+		Real fSavedViewMatrix[16];
+		Real fSavedProjMatrix[16];
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_RenderScale_H__
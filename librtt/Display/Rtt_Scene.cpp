@@ -13,9 +13,12 @@
 
 #include "Display/Rtt_Display.h"
 #include "Display/Rtt_DisplayDefaults.h"
+#include "Display/Rtt_FramePacing.h"
+#include "Display/Rtt_RenderScale.h"
 #include "Display/Rtt_TextureFactory.h"
 #include "Renderer/Rtt_Renderer.h"
 #include "Renderer/Rtt_CPUResource.h"
+#include "Renderer/Rtt_RenderThread.h"
 
 #include "Rtt_LuaContext.h"
 #include "Rtt_LuaUserdataProxy.h"
@@ -49,14 +52,21 @@ Scene::Scene( Rtt_Allocator* pAllocator, Display& owner)
 	fOrphanage( Rtt_NEW( pAllocator, StageObject( pAllocator, * this ) ) ),
 	fSnapshotOrphanage( Rtt_NEW( pAllocator, StageObject( pAllocator, * this ) ) ),
 	fProxyOrphanage( owner.GetAllocator() ),
+	fRenderScale( Rtt_NEW( owner.GetAllocator(), RenderScale( * this ) ) ),
 	fIsValid( false ),
-	fCounter( 0 )
+	fCounter( 0 ),
+	fDamageHistoryCount( 0 ),
+	fIsFullyDamaged( true )
 {
 	fOffscreenStage->SetRenderedOffScreen( true );
 }
 
 Scene::~Scene()
 {
+	// Queues its GPU resources, so it goes before the orphanages
+	Rtt_DELETE( fRenderScale );
+	fRenderScale = NULL;
+
 	Rtt_DELETE( fSnapshotOrphanage );
 	fSnapshotOrphanage = NULL;
 
@@ -150,6 +160,64 @@ void
 Scene::Invalidate()
 {
     fIsValid = false;
+    fIsFullyDamaged = true;
+}
+
+bool
+Scene::IsDamageTrackingEnabled() const
+{
+    return fOwner.GetDefaults().IsPartialRedraw();
+}
+
+void
+Scene::AddDamage( const Rect& stageBounds )
+{
+    fIsValid = false;
+    fDamage.Union( stageBounds );
+}
+
+// Returns false if nothing visible changed since the last render. Otherwise,
+// outRegion is the part of the stage that must be redrawn into the back buffer.
+bool
+Scene::UpdateDamagedRegion( const PlatformSurface& rTarget, Rect& outRegion )
+{
+    const Rect& screenBounds = fOwner.GetScreenContentBounds();
+
+    Rect damage = ( fIsFullyDamaged ? screenBounds : fDamage );
+    damage.Intersect( screenBounds );
+
+    fDamage.SetEmpty();
+    fIsFullyDamaged = false;
+
+    if ( damage.IsEmpty() )
+    {
+        return false;
+    }
+
+    // The back buffer also misses whatever was drawn into the frames presented
+    // since it was last on screen. An age of 0 means its contents are undefined.
+    S32 age = rTarget.BackBufferAge();
+    if ( age < 1 || age > fDamageHistoryCount + 1 )
+    {
+        outRegion = screenBounds;
+    }
+    else
+    {
+        outRegion = damage;
+        for ( S32 i = 0; i < age - 1; i++ )
+        {
+            outRegion.Union( fDamageHistory[i] );
+        }
+    }
+
+    for ( S32 i = kDamageHistoryLength - 1; i > 0; i-- )
+    {
+        fDamageHistory[i] = fDamageHistory[i - 1];
+    }
+    fDamageHistory[0] = damage;
+    fDamageHistoryCount = Min( fDamageHistoryCount + 1, (S32)kDamageHistoryLength );
+
+    return true;
 }
 
 void
@@ -179,11 +247,26 @@ Scene::Render( Renderer& renderer, PlatformSurface& rTarget, ProfilingEntryRAII*
 	Rtt_ASSERT( fCurrentStage );
 	if ( ! IsValid() )
 	{
+		const bool isTrackingDamage = IsDamageTrackingEnabled();
+		if ( ! isTrackingDamage )
+		{
+			fDamageHistoryCount = 0;
+		}
+
 		const Rtt::Real kMillisecondsPerSecond = 1000.0f;
 		Rtt_AbsoluteTime elapsedTime = fOwner.GetElapsedTime();
 		Rtt::Real totalTime = Rtt_AbsoluteToMilliseconds( elapsedTime ) / kMillisecondsPerSecond;
 		Rtt::Real deltaTime = Rtt_AbsoluteToMilliseconds( elapsedTime - fOwner.GetPreviousTime() ) / kMillisecondsPerSecond;
 
+		FramePacing& pacing = fOwner.GetFramePacing();
+		pacing.MarkFrame( FramePacing::kRenderStart );
+
+		RenderScale& renderScale = GetRenderScale();
+		if ( renderScale.Update( pacing ) )
+		{
+			fIsFullyDamaged = true;
+		}
+
 		renderer.BeginFrame( totalTime, deltaTime, fOwner.GetDefaults().GetTimeTransform(), fOwner.GetScreenToContentScale() );
 		
 		ADD_ENTRY( "Scene: Begin Render" );
@@ -201,21 +284,75 @@ Scene::Render( Renderer& renderer, PlatformSurface& rTarget, ProfilingEntryRAII*
 		renderer.SetFrustum( glm::value_ptr(viewMatrix), glm::value_ptr(projMatrix) );
 
 		ADD_ENTRY( "Scene: Setup" );
-		
-        Clear( renderer );
 
         Matrix identity;
         StageObject *canvas = fCurrentStage;
 
+		// Prepare() only touches CPU-side data, so it runs ahead of Clear()
+		// to let damaged objects report their new bounds first.
 		ENABLE_SUMMED_TIMING( true );
 
         canvas->UpdateTransform( identity );
         canvas->Prepare( fOwner );
 
-		ADD_ENTRY( "Scene: Issue Clear Command" );
-		
-		canvas->Draw( renderer );
 		ENABLE_SUMMED_TIMING( false );
+
+		ADD_ENTRY( "Scene: Prepare" );
+
+		bool shouldPresent = true;
+		if ( isTrackingDamage )
+		{
+			Rect region;
+			shouldPresent = UpdateDamagedRegion( rTarget, region );
+
+			// The damage added by UpdateTransform() and Prepare() above was just
+			// consumed, so only what's damaged from here on needs another frame.
+			fIsValid = true;
+
+			// The offscreen texture is stretched over the whole window
+			if ( shouldPresent && renderScale.GetScale() >= Rtt_REAL_1 && ! region.Encloses( fOwner.GetScreenContentBounds() ) )
+			{
+				// Pad for antialiased edges and round outward to whole pixels.
+				const Real padding = 2 * Max( Rtt_REAL_1, fOwner.GetScreenToContentScale() );
+				S32 xMin = (S32)floorf( region.xMin - padding );
+				S32 yMin = (S32)floorf( region.yMin - padding );
+				S32 xMax = (S32)ceilf( region.xMax + padding );
+				S32 yMax = (S32)ceilf( region.yMax + padding );
+
+				renderer.SetScissorEnabled( true );
+				renderer.SetScissor( xMin, yMin, xMax - xMin, yMax - yMin );
+			}
+		}
+
+		if ( shouldPresent )
+		{
+			bool isScaled = renderScale.BeginOffscreen( renderer );
+
+			Clear( renderer );
+
+			ADD_ENTRY( "Scene: Issue Clear Command" );
+
+			ENABLE_SUMMED_TIMING( true );
+			canvas->Draw( renderer );
+			ENABLE_SUMMED_TIMING( false );
+
+			if ( isScaled )
+			{
+				renderScale.EndOffscreen( renderer );
+
+				// Letterbox areas lie outside the texture
+				Clear( renderer );
+				renderScale.Present( renderer );
+
+				ADD_ENTRY( "Scene: Upscale" );
+			}
+		}
+
+		if ( renderer.GetScissorEnabled() )
+		{
+			renderer.SetScissorEnabled( false );
+		}
+
         renderer.EndFrame();
         
         // Some further analysis:
@@ -245,23 +382,58 @@ Scene::Render( Renderer& renderer, PlatformSurface& rTarget, ProfilingEntryRAII*
         // is cumbersome to convey precisely on the CPU side.)
         
 		ADD_ENTRY( "Scene: Issue Draw Commands" );
-		
-        renderer.Swap(); // Swap back and front command buffers
 
-		ADD_ENTRY( "Scene: Swap" );
-		
-        renderer.Render(); // Render front command buffer
-        
-//        renderer.GetFrameStatistics().Log();
+		bool addedUsesTime = false;
 
-		ADD_ENTRY( "Scene: Process Render Commands" );
+		RenderThread* renderThread = fOwner.GetRenderThread();
+		if ( renderThread && renderThread->IsRunning() )
+		{
+			// Swap() waits for the previous frame's Render() to finish, then
+			// Render() overlaps with preparing the next frame. The "uses time"
+			// flag comes from that previous Render(), i.e. is a frame late.
+			renderThread->Run( [&renderer, &addedUsesTime]()
+			{
+				addedUsesTime = renderer.AddedUsesTime(); // n.b. clears the flag
+				renderer.Swap();
+			} );
+
+			pacing.MarkFrame( FramePacing::kSwap );
+
+			ADD_ENTRY( "Scene: Swap" );
 
-		if ( renderer.AddedUsesTime() ) // n.b. clears the flag
+			renderThread->Post( [&renderer]() { renderer.Render(); } );
+
+			ADD_ENTRY( "Scene: Process Render Commands" );
+		}
+		else
+		{
+			renderer.Swap(); // Swap back and front command buffers
+
+			pacing.MarkFrame( FramePacing::kSwap );
+
+			ADD_ENTRY( "Scene: Swap" );
+
+			renderer.Render(); // Render front command buffer
+
+//			renderer.GetFrameStatistics().Log();
+
+			ADD_ENTRY( "Scene: Process Render Commands" );
+
+			addedUsesTime = renderer.AddedUsesTime(); // n.b. clears the flag
+		}
+
+		if ( addedUsesTime
+			|| ( isTrackingDamage && renderer.IsFrameTimeDependent() ) )
 		{
 			Invalidate();
 		}
 
-        rTarget.Flush();
+		if ( shouldPresent )
+		{
+			rTarget.Flush();
+
+			pacing.MarkFrame( FramePacing::kPresent );
+		}
 
 		ADD_ENTRY( "Scene: Flush" );
     }
@@ -269,8 +441,11 @@ Scene::Render( Renderer& renderer, PlatformSurface& rTarget, ProfilingEntryRAII*
 	// This needs to be done at the sync point (DMZ)
 	Collect();
 
-	// Always invalidate so the next frame renders even when nothing changed visually.
-	Invalidate();
+	if ( ! IsDamageTrackingEnabled() )
+	{
+		// Always invalidate so the next frame renders even when nothing changed visually.
+		Invalidate();
+	}
 	
 	ADD_ENTRY( "Scene: Collect" );
 }
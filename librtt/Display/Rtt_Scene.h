@@ -13,6 +13,7 @@
 #include <set>
 
 #include "Core/Rtt_Types.h"
+#include "Core/Rtt_Geometry.h"
 #include "Display/Rtt_Paint.h"
 #include "Display/Rtt_StageObject.h"
 #include "Renderer/Rtt_CPUResource.h"
@@ -26,6 +27,7 @@ namespace Rtt
 class Display;
 class PlatformSurface;
 class ProfilingEntryRAII;
+class RenderScale;
 class Runtime;
 
 // ----------------------------------------------------------------------------
@@ -57,6 +59,8 @@ class Scene
 		GroupObject& Orphanage() { return *fOrphanage; }
 		GroupObject& SnapshotOrphanage() { return *fSnapshotOrphanage; }
 
+		RenderScale& GetRenderScale() const { return *fRenderScale; }
+
 		// Collects various resources passed into QueueRelease() after every 3rd and 32nd call.
 		void Collect();
 
@@ -78,6 +82,16 @@ class Scene
 		void Render( Renderer& renderer, PlatformSurface& rTarget, ProfilingEntryRAII* profiling = NULL );
 		void Render( Renderer& renderer, PlatformSurface& rTarget, DisplayObject& object );
 
+	public:
+		// Partial redraw (the "partialRedraw" display default). Onscreen objects
+		// that change add their old and new stage bounds via AddDamage(), and
+		// only that region is redrawn. Invalidate() still damages everything.
+		bool IsDamageTrackingEnabled() const;
+		void AddDamage( const Rect& stageBounds );
+
+	private:
+		bool UpdateDamagedRegion( const PlatformSurface& rTarget, Rect& outRegion );
+
 	public:
 		StageObject* PushStage();
 		void PopStage();
@@ -91,8 +105,15 @@ class Scene
 		StageObject *fOrphanage; // For Lua-created display objects removed from a group
 		StageObject *fSnapshotOrphanage;
 		LightPtrArray< LuaUserdataProxy > fProxyOrphanage;
+		RenderScale *fRenderScale;
 		bool fIsValid;
 		U8 fCounter; // DO NOT change type --- must be U8
+
+		enum { kDamageHistoryLength = 3 };
+		Rect fDamage; // accumulated since the last render
+		Rect fDamageHistory[kDamageHistoryLength]; // most recently presented first
+		S32 fDamageHistoryCount;
+		bool fIsFullyDamaged;
 };
 
 // ----------------------------------------------------------------------------
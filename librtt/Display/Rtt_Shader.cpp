@@ -278,6 +278,14 @@ Shader::Draw( Renderer& renderer, const RenderData& objectData, const GeometryWr
     DoAnyAfterDraw( state, renderer, objectData );
 }
 
+bool
+Shader::Prewarm( Renderer& renderer, U32 versionMask ) const
+{
+    Program *program = fResource->GetProgramMod( ShaderResource::kDefault );
+
+    return program && renderer.QueuePrewarm( program, versionMask );
+}
+
 void
 Shader::PushProxy( lua_State *L ) const
 {
@@ -72,6 +72,12 @@ class Shader
         virtual void Prepare( RenderData& objectData, int w, int h, ShaderResource::ProgramMod mod );
 
         virtual void Draw( Renderer& renderer, const RenderData& objectData, const GeometryWriter* writers = NULL, U32 n = 1 ) const;
+
+        // Queue the program(s) so the given versions are compiled up front,
+        // instead of when first drawn. Returns false if they all are compiled
+        // or queued already.
+        virtual bool Prewarm( Renderer& renderer, U32 versionMask ) const;
+
         virtual void Log(std::string preprend, bool last);
         virtual void Log();
 
@@ -299,6 +299,27 @@ ShaderComposite::Prepare( RenderData& objectData, int w, int h, ShaderResource::
 
 }
 
+bool
+ShaderComposite::Prewarm( Renderer& renderer, U32 versionMask ) const
+{
+	bool result = Super::Prewarm( renderer, versionMask );
+
+	// Inputs are rendered to texture, which never involves masks
+	const U32 inputVersionMask = 1 << Program::kMaskCount0;
+
+	if ( fInput0.NotNull() )
+	{
+		result = fInput0->Prewarm( renderer, inputVersionMask ) || result;
+	}
+
+	if ( fInput1.NotNull() )
+	{
+		result = fInput1->Prewarm( renderer, inputVersionMask ) || result;
+	}
+
+	return result;
+}
+
 // public: ShapeObject calls this to get final output
 void
 ShaderComposite::Draw( Renderer& renderer, const RenderData& objectData, const GeometryWriter* writers, U32 n ) const
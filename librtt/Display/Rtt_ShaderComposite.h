@@ -55,6 +55,7 @@ class ShaderComposite : public Shader
 	public:
 		virtual void Prepare( RenderData& objectData, int w, int h, ShaderResource::ProgramMod mod );
 		virtual void Draw( Renderer& renderer, const RenderData& objectData, const GeometryWriter* writers = NULL, U32 n = 1 ) const;
+		virtual bool Prewarm( Renderer& renderer, U32 versionMask ) const;
 		
 	public:
 		virtual void PushProxy( lua_State *L ) const;
@@ -0,0 +1,295 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_ShaderWarmup.h"
+
+#include "Display/Rtt_Display.h"
+#include "Display/Rtt_Shader.h"
+#include "Display/Rtt_ShaderFactory.h"
+#include "Display/Rtt_ShaderName.h"
+#include "Display/Rtt_ShaderResource.h"
+#include "Display/Rtt_ShaderTypes.h"
+#include "Renderer/Rtt_ProgramBinaryCache.h"
+#include "Renderer/Rtt_Renderer.h"
+#include "Renderer/Rtt_RenderThread.h"
+#include "Rtt_Lua.h"
+#include "Rtt_Profiling.h"
+
+#include <stdio.h>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+static const char kManifestExtension[] = "manifest";
+
+// One "<category>.<name> <version mask>" line per effect
+static U64
+ManifestKey()
+{
+	return ProgramBinaryCache::Hash( "ShaderWarmup.manifest" );
+}
+
+ShaderWarmup::ShaderWarmup( Display& display )
+:	fDisplay( display ),
+	fUsage(),
+	fManifest(),
+	fLabels(),
+	fIsRecording( false ),
+	fIsDirty( false )
+{
+}
+
+ShaderWarmup::~ShaderWarmup()
+{
+	SaveManifest();
+}
+
+void
+ShaderWarmup::DidUseProgram( const Program& program, Program::Version version )
+{
+	const ShaderResource *resource = program.GetShaderResource();
+
+	// Only effects that can be found by name again are worth recording. The
+	// default shader, i.e. every plain masked object, is stored as "default".
+	if ( ! resource )
+	{
+		return;
+	}
+
+	std::string name( ShaderTypes::StringForCategory( resource->GetCategory() ) );
+
+	if ( ShaderTypes::kCategoryDefault != resource->GetCategory() )
+	{
+		if ( resource->GetName().empty() )
+		{
+			return;
+		}
+
+		name += '.';
+		name += resource->GetName();
+	}
+
+	U32 bit = 1 << version;
+
+	fUsage[name] |= bit;
+
+	if ( fIsRecording )
+	{
+		U32& versions = fManifest[name];
+
+		if ( ! ( versions & bit ) )
+		{
+			versions |= bit;
+			fIsDirty = true;
+		}
+	}
+}
+
+void
+ShaderWarmup::SetRecording( bool newValue )
+{
+	if ( newValue && ! fIsRecording )
+	{
+		// Keep what earlier runs used, so short sessions do not lose entries
+		fManifest.clear();
+		LoadManifest( fManifest );
+
+		for ( Usage::const_iterator iter = fUsage.begin(); iter != fUsage.end(); ++iter )
+		{
+			U32& versions = fManifest[iter->first];
+
+			fIsDirty = fIsDirty || ( iter->second & ~versions );
+			versions |= iter->second;
+		}
+	}
+
+	fIsRecording = newValue;
+}
+
+bool
+ShaderWarmup::LoadManifest( Usage& outUsage ) const
+{
+	std::vector< U8 > data;
+	if ( ! ProgramBinaryCache::Read( ManifestKey(), kManifestExtension, data ) )
+	{
+		return false;
+	}
+
+	data.push_back( '\0' );
+
+	for ( char *line = (char *)data.data(); line && *line; )
+	{
+		char *next = strchr( line, '\n' );
+		if ( next )
+		{
+			*next++ = '\0';
+		}
+
+		char *separator = strrchr( line, ' ' );
+		if ( separator )
+		{
+			*separator = '\0';
+
+			U32 versions = (U32)strtoul( separator + 1, NULL, 10 ) & ( ( 1 << Program::kNumVersions ) - 1 );
+			if ( versions && *line )
+			{
+				outUsage[line] |= versions;
+			}
+		}
+
+		line = next;
+	}
+
+	return true;
+}
+
+void
+ShaderWarmup::SaveManifest()
+{
+	if ( ! fIsDirty )
+	{
+		return;
+	}
+
+	std::string contents;
+
+	for ( Usage::const_iterator iter = fManifest.begin(); iter != fManifest.end(); ++iter )
+	{
+		char versions[16];
+		snprintf( versions, sizeof( versions ), " %u\n", (unsigned int)iter->second );
+
+		contents += iter->first;
+		contents += versions;
+	}
+
+	ProgramBinaryCache::Write( ManifestKey(), kManifestExtension, contents.data(), contents.size() );
+
+	fIsDirty = false;
+}
+
+int
+ShaderWarmup::Compile( const Usage& usage )
+{
+	Renderer& renderer = fDisplay.GetRenderer();
+	ShaderFactory& factory = fDisplay.GetShaderFactory();
+
+	RenderThreadLock lock( fDisplay.GetRenderThread() );
+
+	int result = 0;
+
+	PROFILING_BEGIN( * fDisplay.GetProfilingState(), sp, Shaders );
+
+	sp.Add( "ShaderWarmup::Compile Begin" );
+
+	for ( Usage::const_iterator iter = usage.begin(); iter != usage.end(); ++iter )
+	{
+		Shader *shader = factory.FindOrLoad( ShaderName( iter->first.c_str() ) );
+
+		if ( shader )
+		{
+			if ( shader->Prewarm( renderer, iter->second ) )
+			{
+				renderer.PrewarmQueuedPrograms();
+
+				// The entry's time stamp, relative to the previous one, is the compile time
+				fLabels.push_back( iter->first );
+				sp.Add( fLabels.back().c_str() );
+
+				++result;
+			}
+
+			Rtt_DELETE( shader );
+		}
+		else
+		{
+			Rtt_TRACE_SIM( ( "WARNING: Could not precompile unknown effect (%s).\n", iter->first.c_str() ) );
+		}
+	}
+
+	sp.Add( "ShaderWarmup::Compile End" );
+
+	return result;
+}
+
+void
+ShaderWarmup::Push( lua_State *L, const Usage& usage )
+{
+	lua_createtable( L, 0, (int)usage.size() );
+
+	for ( Usage::const_iterator iter = usage.begin(); iter != usage.end(); ++iter )
+	{
+		lua_createtable( L, Program::kNumVersions, 0 );
+
+		for ( int i = 0, index = 1; i < Program::kNumVersions; i++ )
+		{
+			if ( iter->second & ( 1 << i ) )
+			{
+				lua_pushinteger( L, i );
+				lua_rawseti( L, -2, index++ );
+			}
+		}
+
+		lua_setfield( L, -2, iter->first.c_str() );
+	}
+}
+
+void
+ShaderWarmup::Read( lua_State *L, int index, Usage& outUsage )
+{
+	if ( ! lua_istable( L, index ) )
+	{
+		return;
+	}
+
+	index = ( index > 0 ? index : lua_gettop( L ) + index + 1 );
+
+	lua_pushnil( L );
+	while ( lua_next( L, index ) )
+	{
+		if ( LUA_TSTRING == lua_type( L, -2 ) && lua_istable( L, -1 ) )
+		{
+			U32 versions = 0;
+
+			for ( int i = 1, iMax = (int)lua_objlen( L, -1 ); i <= iMax; i++ )
+			{
+				lua_rawgeti( L, -1, i );
+				int maskCount = (int)lua_tointeger( L, -1 );
+				if ( maskCount >= 0 && maskCount < Program::kNumVersions )
+				{
+					versions |= 1 << maskCount;
+				}
+				lua_pop( L, 1 );
+			}
+
+			if ( versions )
+			{
+				outUsage[lua_tostring( L, -2 )] |= versions;
+			}
+		}
+		else if ( LUA_TNUMBER == lua_type( L, -2 ) && LUA_TSTRING == lua_type( L, -1 ) )
+		{
+			outUsage[lua_tostring( L, -1 )] |= 1 << Program::kMaskCount0;
+		}
+
+		lua_pop( L, 1 );
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
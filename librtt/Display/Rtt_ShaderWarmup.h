@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_ShaderWarmup_H__
+#define _Rtt_ShaderWarmup_H__
+
+#include "Renderer/Rtt_MProgramUsageObserver.h"
+
+#include <list>
+#include <map>
+#include <string>
+
+// ----------------------------------------------------------------------------
+
+struct lua_State;
+
+namespace Rtt
+{
+
+class Display;
+
+// ----------------------------------------------------------------------------
+
+// Program versions (i.e. mask counts) are otherwise compiled the first time
+// an object is drawn with them, e.g. on the first setMask(). This records
+// which effects and versions an app actually uses into a manifest, so that
+// the next launch can compile them all before the first frame.
+class ShaderWarmup : public MProgramUsageObserver
+{
+	Rtt_CLASS_NO_COPIES( ShaderWarmup )
+
+	public:
+		typedef ShaderWarmup Self;
+
+		// Fully qualified effect name ("filter.blur", or "default" for the
+		// default shader) to a bitmask of Program::Version
+		typedef std::map< std::string, U32 > Usage;
+
+	public:
+		ShaderWarmup( Display& display );
+		virtual ~ShaderWarmup();
+
+	public:
+		virtual void DidUseProgram( const Program& program, Program::Version version );
+
+	public:
+		// While recording, usage is added to the manifest saved for the next
+		// run. Entries from earlier runs are kept.
+		bool IsRecording() const { return fIsRecording; }
+		void SetRecording( bool newValue );
+
+		// Usage seen during this run.
+		const Usage& GetUsage() const { return fUsage; }
+
+		// Usage recorded during a previous run.
+		bool LoadManifest( Usage& outUsage ) const;
+
+		// Writes the manifest if new usage was recorded since the last save.
+		void SaveManifest();
+
+		// Compiles the given effects now. Each compile is reported as an entry
+		// in the "shaders" profiling list. Effects whose versions are all
+		// compiled already are skipped. Returns the number of effects compiled.
+		int Compile( const Usage& usage );
+
+	public:
+		// { ["filter.blur"] = { 0, 1 }, ... }, i.e. the mask counts per effect
+		static void Push( lua_State *L, const Usage& usage );
+
+		// Accepts the format above; plain strings in the array part mean
+		// only the unmasked version, e.g. { "filter.blur", "composite.add" }
+		static void Read( lua_State *L, int index, Usage& outUsage );
+
+	private:
+		Display& fDisplay;
+		Usage fUsage;
+		Usage fManifest;
+		std::list< std::string > fLabels; // Profiling payloads need stable strings
+		bool fIsRecording;
+		bool fIsDirty;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_ShaderWarmup_H__
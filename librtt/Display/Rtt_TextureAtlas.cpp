@@ -0,0 +1,421 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Display/Rtt_TextureAtlas.h"
+
+#include "Display/Rtt_BufferBitmap.h"
+#include "Display/Rtt_Display.h"
+#include "Display/Rtt_ImageFrame.h"
+#include "Display/Rtt_ImageSheet.h"
+#include "Display/Rtt_TextureFactory.h"
+#include "Display/Rtt_TextureResource.h"
+#include "Renderer/Rtt_Texture.h"
+#include "Rtt_Lua.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+static const S32 kDefaultPageSize = 1024;
+static const S32 kDefaultMaxImageSize = 256;
+
+// Border around each image, filled with copies of its edge pixels, so that
+// linear filtering never samples a neighbouring image
+static const S32 kPadding = 1;
+
+// ----------------------------------------------------------------------------
+
+TextureAtlas::TextureAtlas( TextureFactory& owner )
+:	fOwner( owner ),
+	fPageSize( 0 ),
+	fMaxImageSize( kDefaultMaxImageSize ),
+	fPages(),
+	fCache()
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	Empty();
+}
+
+void
+TextureAtlas::Read( lua_State *L, int index )
+{
+	if ( lua_istable( L, index ) )
+	{
+		lua_getfield( L, index, "pageSize" );
+		fPageSize = (S32)luaL_optinteger( L, -1, kDefaultPageSize );
+		lua_pop( L, 1 );
+
+		lua_getfield( L, index, "maxImageSize" );
+		fMaxImageSize = (S32)luaL_optinteger( L, -1, kDefaultMaxImageSize );
+		lua_pop( L, 1 );
+	}
+	else if ( lua_toboolean( L, index ) )
+	{
+		fPageSize = kDefaultPageSize;
+	}
+
+	if ( IsEnabled() )
+	{
+		// Pages are the most common texture size limit at most
+		fPageSize = Max( Min( fPageSize, (S32)4096 ), (S32)64 );
+		fMaxImageSize = Max( Min( fMaxImageSize, fPageSize / 2 ), (S32)1 );
+	}
+}
+
+std::string
+TextureAtlas::Key( const std::string& path, U32 flags )
+{
+	// The flags decide the resolution the image is loaded at
+	char suffix[16];
+	snprintf( suffix, sizeof( suffix ), "#%x", (unsigned int)flags );
+
+	return path + suffix;
+}
+
+bool
+TextureAtlas::Find( const std::string& path, U32 flags, AutoPtr< ImageSheet >& outSheet, int& outFrameIndex )
+{
+	Cache::const_iterator element = fCache.find( Key( path, flags ) );
+	if ( element == fCache.end() )
+	{
+		return false;
+	}
+
+	const Entry& entry = element->second;
+	for ( size_t i = 0, iMax = fPages.size(); i < iMax; i++ )
+	{
+		if ( fPages[i]->fSheet == entry.fSheet )
+		{
+			outSheet = fPages[i]->fSheet;
+			outFrameIndex = entry.fFrameIndex;
+			return true;
+		}
+	}
+
+	Rtt_ASSERT_NOT_REACHED();
+	return false;
+}
+
+bool
+TextureAtlas::Add( const std::string& path, U32 flags, const PlatformBitmap& bitmap, AutoPtr< ImageSheet >& outSheet, int& outFrameIndex )
+{
+	if ( ! IsEnabled() )
+	{
+		return false;
+	}
+
+	// Rows are only tightly packed for 4 byte formats. Masks have their own
+	// shader and are never drawn from a sheet.
+	if ( bitmap.IsMask() || PlatformBitmap::BytesPerPixel( bitmap.GetFormat() ) != 4 )
+	{
+		return false;
+	}
+
+	// Repeating textures would wrap into their neighbours
+	if ( bitmap.GetWrapX() != RenderTypes::kClampToEdgeWrap || bitmap.GetWrapY() != RenderTypes::kClampToEdgeWrap )
+	{
+		return false;
+	}
+
+	S32 width = (S32)bitmap.Width();
+	S32 height = (S32)bitmap.Height();
+	if ( width <= 0 || height <= 0 || width > fMaxImageSize || height > fMaxImageSize )
+	{
+		return false;
+	}
+
+	const void *bits = bitmap.GetBits( fOwner.GetDisplay().GetAllocator() );
+	if ( ! bits )
+	{
+		return false;
+	}
+
+	S32 paddedWidth = width + 2 * kPadding;
+	S32 paddedHeight = height + 2 * kPadding;
+
+	// Newest pages first, since older ones are likely full
+	Page *page = NULL;
+	S32 x = 0, y = 0;
+	for ( size_t i = fPages.size(); i-- > 0 && ! page; )
+	{
+		if ( IsCompatible( * fPages[i], bitmap ) && Insert( * fPages[i], paddedWidth, paddedHeight, x, y ) )
+		{
+			page = fPages[i];
+		}
+	}
+
+	if ( ! page )
+	{
+		page = NewPage( bitmap );
+		if ( ! Insert( * page, paddedWidth, paddedHeight, x, y ) )
+		{
+			Rtt_ASSERT_NOT_REACHED();
+			return false;
+		}
+	}
+
+	Blit( * page, bitmap, x, y );
+	bitmap.FreeBits();
+
+	Rtt_Allocator *allocator = fOwner.GetDisplay().GetAllocator();
+	ImageSheet& sheet = * page->fSheet;
+	sheet.fFrames.Append( Rtt_NEW( allocator, ImageFrame( sheet, x + kPadding, y + kPadding, width, height, Rtt_REAL_1, Rtt_REAL_1, false ) ) );
+
+	Entry entry = { & sheet, sheet.GetNumFrames() - 1 };
+	fCache[Key( path, flags )] = entry;
+
+	outSheet = page->fSheet;
+	outFrameIndex = entry.fFrameIndex;
+
+	return true;
+}
+
+void
+TextureAtlas::Update()
+{
+	for ( size_t i = fPages.size(); i-- > 0; )
+	{
+		Page *page = fPages[i];
+		if ( 0 == page->fSheet->GetPaintCount() )
+		{
+			ImageSheet *sheet = page->fSheet;
+			for ( Cache::iterator it = fCache.begin(); it != fCache.end(); )
+			{
+				if ( it->second.fSheet == sheet )
+				{
+					fCache.erase( it++ );
+				}
+				else
+				{
+					++it;
+				}
+			}
+
+			fPages.erase( fPages.begin() + i );
+			Rtt_DELETE( page );
+		}
+		else if ( page->fIsDirty )
+		{
+			// Images added since the texture was created, or last updated
+			page->fSheet->GetTextureResource()->GetTexture().Invalidate();
+			page->fIsDirty = false;
+		}
+	}
+}
+
+void
+TextureAtlas::Empty()
+{
+	for ( size_t i = 0, iMax = fPages.size(); i < iMax; i++ )
+	{
+		Rtt_DELETE( fPages[i] );
+	}
+
+	fPages.clear();
+	fCache.clear();
+}
+
+bool
+TextureAtlas::IsCompatible( const Page& page, const PlatformBitmap& bitmap ) const
+{
+	return page.fFormat == bitmap.GetFormat()
+		&& page.fIsPremultiplied == bitmap.IsPremultiplied()
+		&& page.fMagFilter == bitmap.GetMagFilter()
+		&& page.fMinFilter == bitmap.GetMinFilter();
+}
+
+TextureAtlas::Page*
+TextureAtlas::NewPage( const PlatformBitmap& bitmap )
+{
+	Rtt_Allocator *allocator = fOwner.GetDisplay().GetAllocator();
+
+	BufferBitmap *pageBitmap = Rtt_NEW( allocator, BufferBitmap( allocator, fPageSize, fPageSize, bitmap.GetFormat() ) );
+	memset( pageBitmap->WriteAccess(), 0, pageBitmap->NumBytes() );
+	pageBitmap->SetProperty( PlatformBitmap::kIsPremultiplied, bitmap.IsPremultiplied() );
+	pageBitmap->SetMagFilter( bitmap.GetMagFilter() );
+	pageBitmap->SetMinFilter( bitmap.GetMinFilter() );
+	pageBitmap->SetWrapX( RenderTypes::kClampToEdgeWrap );
+	pageBitmap->SetWrapY( RenderTypes::kClampToEdgeWrap );
+
+	// Not cached by path; the page lives as long as its sheet
+	SharedPtr< TextureResource > texture = fOwner.FindOrCreate( pageBitmap, false );
+
+	Page *result = Rtt_NEW( allocator, Page );
+	result->fSheet = AutoPtr< ImageSheet >( allocator, Rtt_NEW( allocator, ImageSheet( allocator, texture ) ) );
+	result->fBitmap = pageBitmap;
+	result->fFormat = bitmap.GetFormat();
+	result->fIsPremultiplied = bitmap.IsPremultiplied();
+	result->fMagFilter = bitmap.GetMagFilter();
+	result->fMinFilter = bitmap.GetMinFilter();
+	result->fIsDirty = false;
+
+	SkylineNode node = { 0, 0, fPageSize };
+	result->fSkyline.push_back( node );
+
+	fPages.push_back( result );
+
+	return result;
+}
+
+// Skyline bottom-left: the lowest position, then the narrowest segment
+bool
+TextureAtlas::Insert( Page& page, S32 width, S32 height, S32& outX, S32& outY ) const
+{
+	S32 bestY = INT_MAX;
+	S32 bestWidth = INT_MAX;
+	size_t bestIndex = page.fSkyline.size();
+
+	for ( size_t i = 0, iMax = page.fSkyline.size(); i < iMax; i++ )
+	{
+		S32 y = Fit( page, i, width, height );
+		if ( y >= 0 )
+		{
+			const SkylineNode& node = page.fSkyline[i];
+			if ( y + height < bestY || ( y + height == bestY && node.width < bestWidth ) )
+			{
+				bestY = y + height;
+				bestWidth = node.width;
+				bestIndex = i;
+				outX = node.x;
+				outY = y;
+			}
+		}
+	}
+
+	if ( bestIndex == page.fSkyline.size() )
+	{
+		return false;
+	}
+
+	Place( page, bestIndex, outX, outY, width, height );
+	return true;
+}
+
+// Returns the y at which a rectangle starting at the given segment rests, or
+// -1 if it doesn't fit there
+S32
+TextureAtlas::Fit( const Page& page, size_t index, S32 width, S32 height ) const
+{
+	const std::vector< SkylineNode >& skyline = page.fSkyline;
+
+	S32 x = skyline[index].x;
+	if ( x + width > fPageSize )
+	{
+		return -1;
+	}
+
+	S32 y = skyline[index].y;
+	for ( S32 remaining = width; remaining > 0; index++ )
+	{
+		Rtt_ASSERT( index < skyline.size() );
+
+		y = Max( y, skyline[index].y );
+		if ( y + height > fPageSize )
+		{
+			return -1;
+		}
+		remaining -= skyline[index].width;
+	}
+
+	return y;
+}
+
+void
+TextureAtlas::Place( Page& page, size_t index, S32 x, S32 y, S32 width, S32 height ) const
+{
+	std::vector< SkylineNode >& skyline = page.fSkyline;
+
+	SkylineNode node = { x, y + height, width };
+	skyline.insert( skyline.begin() + index, node );
+
+	// Trim the segments now covered by the new one
+	for ( size_t i = index + 1; i < skyline.size(); )
+	{
+		SkylineNode& previous = skyline[i - 1];
+		SkylineNode& current = skyline[i];
+
+		S32 overlap = previous.x + previous.width - current.x;
+		if ( overlap <= 0 )
+		{
+			break;
+		}
+
+		current.x += overlap;
+		current.width -= overlap;
+		if ( current.width > 0 )
+		{
+			break;
+		}
+
+		skyline.erase( skyline.begin() + i );
+	}
+
+	// Merge neighbours at the same height
+	for ( size_t i = 0; i + 1 < skyline.size(); )
+	{
+		if ( skyline[i].y == skyline[i + 1].y )
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase( skyline.begin() + i + 1 );
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+void
+TextureAtlas::Blit( Page& page, const PlatformBitmap& bitmap, S32 x, S32 y ) const
+{
+	const S32 kBytesPerPixel = 4;
+
+	const U8 *src = static_cast< const U8 * >( bitmap.GetBits( fOwner.GetDisplay().GetAllocator() ) );
+	U8 *dst = static_cast< U8 * >( page.fBitmap->WriteAccess() );
+
+	S32 width = (S32)bitmap.Width();
+	S32 height = (S32)bitmap.Height();
+	size_t srcStride = width * kBytesPerPixel;
+	size_t dstStride = fPageSize * kBytesPerPixel;
+
+	for ( S32 row = -kPadding; row < height + kPadding; row++ )
+	{
+		const U8 *srcRow = src + Min( Max( row, (S32)0 ), height - 1 ) * srcStride;
+		U8 *dstRow = dst + ( y + kPadding + row ) * dstStride + ( x + kPadding ) * kBytesPerPixel;
+
+		memcpy( dstRow, srcRow, srcStride );
+
+		for ( S32 i = 1; i <= kPadding; i++ )
+		{
+			memcpy( dstRow - i * kBytesPerPixel, srcRow, kBytesPerPixel );
+			memcpy( dstRow + srcStride + ( i - 1 ) * kBytesPerPixel, srcRow + srcStride - kBytesPerPixel, kBytesPerPixel );
+		}
+	}
+
+	page.fIsDirty = true;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_TextureAtlas_H__
+#define _Rtt_TextureAtlas_H__
+
+#include "Core/Rtt_AutoPtr.h"
+#include "Core/Rtt_Types.h"
+#include "Display/Rtt_PlatformBitmap.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+struct lua_State;
+
+namespace Rtt
+{
+
+class BufferBitmap;
+class ImageSheet;
+class TextureFactory;
+
+// ----------------------------------------------------------------------------
+
+// Packs small images loaded by display.newImage() and display.newImageRect()
+// into shared pages, so that objects showing different images can still be
+// batched into one draw call. Each page is an ImageSheet, and each image
+// one of its frames, so objects draw with an ImageSheetPaint exactly as if
+// the app had built the sheet itself.
+//
+// Pages are filled with a skyline packer. Space isn't reclaimed when
+// individual images go away; a page is dropped once none of its images
+// are in use.
+class TextureAtlas
+{
+	Rtt_CLASS_NO_COPIES( TextureAtlas )
+
+	public:
+		typedef TextureAtlas Self;
+
+	public:
+		TextureAtlas( TextureFactory& owner );
+		~TextureAtlas();
+
+	public:
+		// content.imageAtlas in config.lua. Either true, or
+		// { pageSize = 1024, maxImageSize = 256 }. Disabled by default.
+		void Read( lua_State *L, int index );
+
+		bool IsEnabled() const { return fPageSize > 0; }
+
+	public:
+		// Looks up an image added earlier with the same path and load flags.
+		bool Find( const std::string& path, U32 flags, AutoPtr< ImageSheet >& outSheet, int& outFrameIndex );
+
+		// Copies the bitmap into a page. Returns false if the image is too
+		// large or in a format that isn't packed; the caller keeps ownership
+		// of the bitmap either way.
+		bool Add( const std::string& path, U32 flags, const PlatformBitmap& bitmap, AutoPtr< ImageSheet >& outSheet, int& outFrameIndex );
+
+		// Once per frame: uploads pages that changed and drops unused ones.
+		void Update();
+
+		// Drops all pages. Pages still drawn by paints live on until those go away.
+		void Empty();
+
+	private:
+		struct SkylineNode
+		{
+			S32 x;
+			S32 y;
+			S32 width;
+		};
+
+		struct Page
+		{
+			AutoPtr< ImageSheet > fSheet;
+			BufferBitmap *fBitmap; // owned by the sheet's texture
+			std::vector< SkylineNode > fSkyline;
+			PlatformBitmap::Format fFormat;
+			bool fIsPremultiplied;
+			U8 fMagFilter;
+			U8 fMinFilter;
+			bool fIsDirty;
+		};
+
+		struct Entry
+		{
+			ImageSheet *fSheet;
+			int fFrameIndex;
+		};
+
+		typedef std::map< std::string, Entry > Cache;
+
+		static std::string Key( const std::string& path, U32 flags );
+
+		bool IsCompatible( const Page& page, const PlatformBitmap& bitmap ) const;
+		Page* NewPage( const PlatformBitmap& bitmap );
+		bool Insert( Page& page, S32 width, S32 height, S32& outX, S32& outY ) const;
+		S32 Fit( const Page& page, size_t index, S32 width, S32 height ) const;
+		void Place( Page& page, size_t index, S32 x, S32 y, S32 width, S32 height ) const;
+		void Blit( Page& page, const PlatformBitmap& bitmap, S32 x, S32 y ) const;
+
+	private:
+		TextureFactory& fOwner;
+		S32 fPageSize;
+		S32 fMaxImageSize;
+		std::vector< Page* > fPages;
+		Cache fCache;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_TextureAtlas_H__
@@ -15,6 +15,7 @@
 #include "Display/Rtt_DisplayDefaults.h"
 #include "Display/Rtt_PlatformBitmap.h"
 #include "Display/Rtt_Scene.h"
+#include "Display/Rtt_TextureAtlas.h"
 #include "Display/Rtt_TextureFactory.h"
 #include "Display/Rtt_TextureResource.h"
 #include "Renderer/Rtt_Renderer.h"
@@ -29,6 +30,9 @@
 #include "Rtt_Runtime.h"
 #include "CoronaLua.h"
 
+#include <algorithm>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 
 namespace Rtt
@@ -41,13 +45,18 @@ TextureFactory::TextureFactory( Display& display )
 	fDisplay( display ),
 	fDefault(),
 	fContainerMask(),
+	fAtlas( NULL ),
 	fTextureMemoryUsed( 0 ),
+	fTextureMemoryBudget( 0 ),
+	fFrame( 0 ),
 	fPreloadQueue( display.GetAllocator() )
 {
+	fAtlas = Rtt_NEW( display.GetAllocator(), TextureAtlas( * this ) );
 }
 
 TextureFactory::~TextureFactory()
 {
+	Rtt_DELETE( fAtlas );
 	fPreloadQueue.Empty();
 }
 
@@ -149,6 +158,14 @@ TextureFactory::Find( const std::string& key )
 		{
 			// Found an entry
 			result = SharedPtr< TextureResource >( resource );
+			result->SetLastUsed( fFrame );
+
+			// Bring an evicted texture back before anything draws it
+			if ( result->IsEvicted() )
+			{
+				result->Restore();
+				AddToPreloadQueue( result );
+			}
 		}
 		else
 		{
@@ -171,6 +188,7 @@ TextureFactory::CreateAndAdd( const std::string& key, PlatformBitmap *bitmap, bo
 {
 	TextureResource *resource = TextureResourceBitmap::Create( * this, bitmap );
 	SharedPtr< TextureResource > result = SharedPtr< TextureResource >( resource );
+	result->SetLastUsed( fFrame );
 	AddToPreloadQueue( result );
 
 	if ( useCache )
@@ -186,6 +204,9 @@ TextureFactory::CreateAndAdd( const std::string& key, PlatformBitmap *bitmap, bo
 void
 TextureFactory::Preload( Renderer& renderer )
 {
+	fAtlas->Update();
+	EnforceBudget();
+
 	for ( int i = 0; i < fPreloadQueue.Length(); i++ )
 	{
 		const WeakPtr< TextureResource > item = fPreloadQueue[i];
@@ -205,6 +226,69 @@ TextureFactory::Preload( Renderer& renderer )
 		}
 	}
 	fPreloadQueue.Empty();
+
+	++fFrame;
+}
+
+static bool
+IsLessRecentlyUsed( const TextureResource *lhs, const TextureResource *rhs )
+{
+	return lhs->GetLastUsed() < rhs->GetLastUsed();
+}
+
+// Evicts cached images that nothing draws anymore, least recently used first,
+// until texture memory fits the budget. In practice, these are the images
+// preloaded with graphics.newTexture(); images loaded by display objects are
+// released with their last object.
+void
+TextureFactory::EnforceBudget()
+{
+	if ( fTextureMemoryBudget <= 0 )
+	{
+		return;
+	}
+
+	std::vector< TextureResource * > candidates;
+
+	for ( OwnedTextures::const_iterator it = fOwnedTextures.begin(); it != fOwnedTextures.end(); ++it )
+	{
+		const SharedPtr< TextureResource >& resource = it->second;
+		if ( resource.IsNull() )
+		{
+			continue;
+		}
+
+		// Anything besides this map holding the texture means it's in use
+		if ( resource.UseCount() > 1 )
+		{
+			resource->SetLastUsed( fFrame );
+			continue;
+		}
+
+		// Only images can be restored from their source. Textures looked up
+		// this frame may already be queued for upload.
+		if ( resource->IsEvicted()
+			 || resource->GetType() != TextureResource::kTextureResourceBitmap
+			 || resource->GetLastUsed() == fFrame
+			 || fCache.find( it->first ) == fCache.end() )
+		{
+			continue;
+		}
+
+		candidates.push_back( & ( * resource ) );
+	}
+
+	if ( fTextureMemoryUsed <= fTextureMemoryBudget || candidates.empty() )
+	{
+		return;
+	}
+
+	std::sort( candidates.begin(), candidates.end(), IsLessRecentlyUsed );
+
+	for ( size_t i = 0, iMax = candidates.size(); i < iMax && fTextureMemoryUsed > fTextureMemoryBudget; i++ )
+	{
+		candidates[i]->Evict();
+	}
 }
 
 SharedPtr< TextureResource >
@@ -248,6 +332,57 @@ TextureFactory::FindOrCreate(
 	return result;
 }
 
+SharedPtr< TextureResource >
+TextureFactory::FindOrCreateAtlased(
+	const char *filename,
+	MPlatform::Directory baseDir,
+	U32 flags,
+	AutoPtr< ImageSheet >& outSheet,
+	int& outFrameIndex )
+{
+	SharedPtr< TextureResource > result;
+
+	if( MPlatform::kVirtualTexturesDir == baseDir )
+	{
+		return Find(filename);
+	}
+
+	String filePath( fDisplay.GetAllocator() );
+	PathForFile( filePath, filename, baseDir );
+
+	if (filePath.IsEmpty())
+	{
+		CoronaLuaWarning(fDisplay.GetL(), "Failed to find image '%s'", filename);
+
+		Rtt_ASSERT( result.IsNull() );
+		return result;
+	}
+
+	std::string key( filePath.GetString() );
+	if ( fAtlas->Find( key, flags, outSheet, outFrameIndex ) )
+	{
+		return result;
+	}
+
+	// Images already loaded as standalone textures stay that way
+	result = Find( key );
+
+	if ( result.IsNull() )
+	{
+		PlatformBitmap *bitmap = CreateBitmap( filePath.GetString(), flags, false );
+		if ( bitmap && fAtlas->Add( key, flags, * bitmap, outSheet, outFrameIndex ) )
+		{
+			Rtt_DELETE( bitmap );
+		}
+		else
+		{
+			result = CreateAndAdd( key, bitmap, true );
+		}
+	}
+
+	return result;
+}
+
 SharedPtr< TextureResource >
 TextureFactory::FindOrCreate(
 	const FilePath& filePath,
@@ -583,6 +718,9 @@ void TextureFactory::RemoveFromTeardownList( const std::string &key )
 void TextureFactory::AddTextureToUpdateList( const std::string &key )
 {
 	fUpdateTextures.insert(key);
+
+	// Objects using the texture are not damaged individually, so redraw everything
+	fDisplay.Invalidate();
 }
 
 	
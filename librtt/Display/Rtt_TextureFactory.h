@@ -10,6 +10,7 @@
 #ifndef _Rtt_TextureResource_H__
 #define _Rtt_TextureResource_H__
 
+#include "Core/Rtt_AutoPtr.h"
 #include "Core/Rtt_SharedPtr.h"
 #include "Renderer/Rtt_Texture.h"
 #include "Display/Rtt_TextureResource.h"
@@ -30,6 +31,8 @@ namespace Rtt
 
 class Display;
 class FilePath;
+class ImageSheet;
+class TextureAtlas;
 class TextureResource;
 
 // ----------------------------------------------------------------------------
@@ -86,6 +89,17 @@ class TextureFactory
 			const CoronaExternalTextureCallbacks* callbacks,
 			void* context);
 
+		// Like FindOrCreate(), but small images go into the runtime atlas when
+		// it's enabled. In that case the result is null and outSheet/outFrameIndex
+		// identify the image instead.
+		SharedPtr< TextureResource > FindOrCreateAtlased(
+			const char *filename,
+			MPlatform::Directory baseDir,
+			U32 flags,
+			AutoPtr< ImageSheet >& outSheet,
+			int& outFrameIndex );
+
+		TextureAtlas& GetAtlas() const { return * fAtlas; }
 
 	// One-off texture resources
 	public:
@@ -110,7 +124,13 @@ class TextureFactory
 		void WillRemoveTexture( const TextureResource& resource );
 		S32 GetTextureMemoryUsed() const { return fTextureMemoryUsed; }
 
+		// content.textureMemoryBudget in config.lua, in bytes. 0 is unlimited.
+		S32 GetTextureMemoryBudget() const { return fTextureMemoryBudget; }
+		void SetTextureMemoryBudget( S32 newValue ) { fTextureMemoryBudget = newValue; }
+
 	protected:
+		void EnforceBudget();
+
 		class CacheEntry
 		{
 			public:
@@ -161,8 +181,11 @@ class TextureFactory
 		Display &fDisplay;
 		WeakPtr< TextureResource > fDefault;
 		WeakPtr< TextureResource > fContainerMask;
+		TextureAtlas *fAtlas;
 		
 		S32 fTextureMemoryUsed;
+		S32 fTextureMemoryBudget;
+		U32 fFrame;
 		
 };
 
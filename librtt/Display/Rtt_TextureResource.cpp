@@ -27,6 +27,8 @@ TextureResource::TextureResource(TextureFactory &factory, Texture *texture,  Pla
 	, fBitmap(bitmap)
 	, fType(type)
 	, fProxy(NULL)
+	, fLastUsed(0)
+	, fIsEvicted(false)
 {
 	if (fTexture)
 	{
@@ -36,7 +38,7 @@ TextureResource::TextureResource(TextureFactory &factory, Texture *texture,  Pla
 	
 TextureResource::~TextureResource()
 {
-	if (fTexture)
+	if (fTexture && ! fIsEvicted)
 	{
 		fFactory.WillRemoveTexture( (TextureResource&)* this );
 	}
@@ -98,6 +100,33 @@ TextureResource::GetHeight() const
 	return ( GetBitmap() ? GetBitmap()->Width() : GetTexture().GetHeight() );
 }
 
+size_t
+TextureResource::GetSizeInBytes() const
+{
+	return ( fTexture ? fTexture->GetSizeInBytes() : 0 );
+}
+
+void
+TextureResource::Evict()
+{
+	if ( fTexture && ! fIsEvicted )
+	{
+		fFactory.WillRemoveTexture( * this );
+		fIsEvicted = true;
+		fTexture->EvictGPUResource();
+	}
+}
+
+void
+TextureResource::Restore()
+{
+	if ( fIsEvicted )
+	{
+		fIsEvicted = false;
+		fFactory.DidAddTexture( * this );
+	}
+}
+
 	
 void
 TextureResource::PushProxy( lua_State *L )
@@ -68,6 +68,19 @@ class TextureResource
 		U32 GetHeight() const;
 	
 		TextureFactory &GetTextureFactory() const {return fFactory;}
+
+	// Texture memory budget (see TextureFactory::EnforceBudget)
+	public:
+		size_t GetSizeInBytes() const;
+
+		// An evicted texture has no GPU copy. It's re-uploaded, and its
+		// bitmap re-decoded if it was freed, the next time it's drawn.
+		bool IsEvicted() const { return fIsEvicted; }
+		void Evict();
+		void Restore();
+
+		U32 GetLastUsed() const { return fLastUsed; }
+		void SetLastUsed( U32 frame ) { fLastUsed = frame; }
 	
 	//Lua exposure
 		void PushProxy( lua_State *L );
@@ -93,6 +106,8 @@ class TextureResource
 		PlatformBitmap *fBitmap;
 		TextureResourceType fType;
 		mutable LuaUserdataProxy *fProxy;
+		U32 fLastUsed;
+		bool fIsEvicted;
 };
 
 // ----------------------------------------------------------------------------
@@ -35,9 +35,11 @@ StringHash *TextureResourceAdapter::GetHash( lua_State *L ) const
 		"baseDir",            //1
 		"type",               //2
 		"releaseSelf",        //3
+		"bytes",              //4
+		"isResident",         //5
 	};
 	
-	static StringHash sHash( *LuaContext::GetAllocator( L ), keys, sizeof( keys ) / sizeof( const char * ), 4, 1, 1, __FILE__, __LINE__ );
+	static StringHash sHash( *LuaContext::GetAllocator( L ), keys, sizeof( keys ) / sizeof( const char * ), 6, 2, 2, __FILE__, __LINE__ );
 	return &sHash;
 	
 }
@@ -94,6 +96,16 @@ int TextureResourceAdapter::ValueForKey(const LuaUserdataProxy& sender,
 			Lua::PushCachedFunction( L, Self::ReleaseStrongReference );
 			results = 1;
 			break;
+
+		case 4: //bytes
+			lua_pushinteger( L, (lua_Integer)entry->GetSizeInBytes() );
+			results = 1;
+			break;
+
+		case 5: //isResident
+			lua_pushboolean( L, ! entry->IsEvicted() );
+			results = 1;
+			break;
 			
 			
 		default:
@@ -88,6 +88,17 @@ CPUResource::ReleaseGPUResource()
 		fGPUResource = NULL;
 	}
 }
+void
+CPUResource::EvictGPUResource()
+{
+	if( fGPUResource && fRenderer )
+	{
+		DetachObserver();
+		fRenderer->QueueDestroy( fGPUResource );
+		fGPUResource = NULL;
+	}
+}
+
 void 
 CPUResource::Invalidate()
 {
@@ -82,6 +82,11 @@ class CPUResource
 		void SetGPUResource( GPUResource* resource );
 		
 		void ReleaseGPUResource();
+
+		// Queues the GPUResource for destruction to free GPU memory. Unlike
+		// destroying this CPUResource, it can still be drawn afterwards; the
+		// renderer creates a new GPUResource from its data when it does.
+		void EvictGPUResource();
 		
 		void AttachObserver(MCPUResourceObserver *cpuObserver);
 		void DetachObserver();
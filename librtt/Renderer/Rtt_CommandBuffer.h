@@ -121,7 +121,7 @@ class CommandBuffer
         virtual Real Execute( bool measureGPU ) = 0;
 
     public:
-        void PrepareTimeTransforms( float rawTime, const TimeTransform* transform );
+        virtual void PrepareTimeTransforms( float rawTime, const TimeTransform* transform );
 
     protected:
         void AcquireTimeTransform( ShaderResource* resource );
@@ -0,0 +1,959 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Renderer/Rtt_CommandCapture.h"
+
+#include "Renderer/Rtt_FrameBufferObject.h"
+#include "Renderer/Rtt_FormatExtensionList.h"
+#include "Renderer/Rtt_GPUResource.h"
+#include "Renderer/Rtt_Program.h"
+#include "Renderer/Rtt_Renderer.h"
+#include "Renderer/Rtt_TextureVolatile.h"
+#include "Renderer/Rtt_Uniform.h"
+#include "Display/Rtt_ShaderResource.h"
+#include "Core/Rtt_Allocator.h"
+#include "Core/Rtt_Assert.h"
+#include "Core/Rtt_FileSystem.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+    // Bump when the layout below changes; older captures are then rejected
+    const char kMagic[8] = { 'R', 'T', 'T', 'C', 'A', 'P', '0', '1' };
+
+    // File layout, native byte order:
+    //   kMagic
+    //   U32 resource count, then for each: U8 CPUResource type, payload
+    //   U32 command count, U32 command bytes, then the commands
+    enum Command
+    {
+        kCommandBindFrameBufferObject,
+        kCommandCaptureRect,
+        kCommandBindGeometry,
+        kCommandBindTexture,
+        kCommandBindUniform,
+        kCommandBindProgram,
+        kCommandBindVertexFormat,
+        kCommandClearUserUniforms,
+        kCommandPrepareTimeTransforms,
+        kCommandSetBlendEnabled,
+        kCommandSetBlendFunction,
+        kCommandSetBlendEquation,
+        kCommandSetViewport,
+        kCommandSetScissorEnabled,
+        kCommandSetScissorRegion,
+        kCommandClearDepth,
+        kCommandClearStencil,
+        kCommandClear,
+        kCommandDraw,
+        kCommandDrawIndexed,
+        kCommandWillRender,
+        kNumCommands
+    };
+
+    #define WRITE_COMMAND( command ) Write<U8>( command ); ++fNumCommands;
+
+    template < typename T >
+    void
+    Put( std::vector< U8 >& out, const T& value )
+    {
+        const U8* bytes = reinterpret_cast< const U8* >( &value );
+        out.insert( out.end(), bytes, bytes + sizeof( T ) );
+    }
+
+    void
+    PutBytes( std::vector< U8 >& out, const void* data, U32 size )
+    {
+        Put( out, size );
+        if ( size > 0 )
+        {
+            const U8* bytes = static_cast< const U8* >( data );
+            out.insert( out.end(), bytes, bytes + size );
+        }
+    }
+
+    void
+    PutString( std::vector< U8 >& out, const char* s )
+    {
+        PutBytes( out, s, s ? (U32)strlen( s ) : 0 );
+    }
+
+    // Bounds-checked reads over a loaded capture
+    class Reader
+    {
+        public:
+            Reader( const U8* data, size_t size ) : fCursor( data ), fEnd( data + size ), fFailed( false ) {}
+
+            template < typename T >
+            T Get()
+            {
+                T result = T();
+                GetBytes( &result, sizeof( T ) );
+                return result;
+            }
+
+            bool GetBytes( void* dst, size_t size )
+            {
+                if ( fFailed || (size_t)( fEnd - fCursor ) < size )
+                {
+                    fFailed = true;
+                    return false;
+                }
+                memcpy( dst, fCursor, size );
+                fCursor += size;
+                return true;
+            }
+
+            const U8* Skip( size_t size )
+            {
+                if ( fFailed || (size_t)( fEnd - fCursor ) < size )
+                {
+                    fFailed = true;
+                    return NULL;
+                }
+                const U8* result = fCursor;
+                fCursor += size;
+                return result;
+            }
+
+            std::string GetString()
+            {
+                U32 length = Get< U32 >();
+                const U8* bytes = Skip( length );
+                return bytes ? std::string( (const char*)bytes, length ) : std::string();
+            }
+
+            bool Failed() const { return fFailed; }
+
+        private:
+            const U8* fCursor;
+            const U8* fEnd;
+            bool fFailed;
+    };
+
+    // Texture that hands out a copy of the captured pixels
+    class CapturedTexture : public Rtt::TextureVolatile
+    {
+        public:
+            CapturedTexture( Rtt_Allocator* allocator, U32 width, U32 height, Format format, Filter filter, Wrap wrapX, Wrap wrapY, U8 alignment )
+            :   TextureVolatile( allocator, width, height, format, filter, wrapX, wrapY ),
+                fAlignment( alignment )
+            {
+            }
+
+            virtual size_t GetSizeInBytes() const { return fData.empty() ? Super::GetSizeInBytes() : fData.size(); }
+            virtual U8 GetByteAlignment() const { return fAlignment; }
+            virtual const U8* GetData() const { return fData.empty() ? NULL : fData.data(); }
+
+            std::vector< U8 > fData;
+
+        private:
+            U8 fAlignment;
+    };
+}
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+CaptureCommandBuffer::CaptureCommandBuffer( Rtt_Allocator* allocator, CommandBuffer* target )
+:   CommandBuffer( allocator ),
+    fTarget( target ),
+    fResources(),
+    fResourceIndices()
+{
+}
+
+CaptureCommandBuffer::~CaptureCommandBuffer()
+{
+}
+
+bool
+CaptureCommandBuffer::HasFramebufferBlit( bool * canScale ) const
+{
+    return fTarget->HasFramebufferBlit( canScale );
+}
+
+void
+CaptureCommandBuffer::GetVertexAttributes( VertexAttributeSupport & support ) const
+{
+    fTarget->GetVertexAttributes( support );
+}
+
+void
+CaptureCommandBuffer::Initialize()
+{
+    fTarget->Initialize();
+}
+
+void
+CaptureCommandBuffer::Denitialize()
+{
+    fTarget->Denitialize();
+}
+
+void
+CaptureCommandBuffer::InitializeFBO()
+{
+}
+
+void
+CaptureCommandBuffer::InitializeCachedParams()
+{
+}
+
+void
+CaptureCommandBuffer::CacheQueryParam( CommandBuffer::QueryableParams param )
+{
+}
+
+void
+CaptureCommandBuffer::ClearUserUniforms()
+{
+    WRITE_COMMAND( kCommandClearUserUniforms );
+    fTarget->ClearUserUniforms();
+}
+
+void
+CaptureCommandBuffer::BindFrameBufferObject( FrameBufferObject* fbo, bool asDrawBuffer )
+{
+    WRITE_COMMAND( kCommandBindFrameBufferObject );
+    Write<U32>( Reference( fbo ) );
+    Write<bool>( asDrawBuffer );
+    fTarget->BindFrameBufferObject( fbo, asDrawBuffer );
+}
+
+void
+CaptureCommandBuffer::CaptureRect( FrameBufferObject* fbo, Texture& texture, const Rect& rect, const Rect& rawRect )
+{
+    WRITE_COMMAND( kCommandCaptureRect );
+    Write<U32>( Reference( fbo ) );
+    Write<U32>( Reference( &texture ) );
+    Write<Rect>( rect );
+    Write<Rect>( rawRect );
+    fTarget->CaptureRect( fbo, texture, rect, rawRect );
+}
+
+void
+CaptureCommandBuffer::BindGeometry( Geometry* geometry )
+{
+    WRITE_COMMAND( kCommandBindGeometry );
+    Write<U32>( Reference( geometry ) );
+    fTarget->BindGeometry( geometry );
+}
+
+void
+CaptureCommandBuffer::BindTexture( Texture* texture, U32 unit )
+{
+    WRITE_COMMAND( kCommandBindTexture );
+    Write<U32>( Reference( texture ) );
+    Write<U32>( unit );
+    fTarget->BindTexture( texture, unit );
+}
+
+void
+CaptureCommandBuffer::BindUniform( Uniform* uniform, U32 unit )
+{
+    // Some uniforms, e.g. the texel size, are reused with different values
+    // over the frame, so the value is part of the command
+    WRITE_COMMAND( kCommandBindUniform );
+    Write<U32>( Reference( uniform ) );
+    Write<U32>( unit );
+    WriteBytes( uniform->GetData(), uniform->GetSizeInBytes() );
+    fTarget->BindUniform( uniform, unit );
+}
+
+void
+CaptureCommandBuffer::BindProgram( Program* program, Program::Version version )
+{
+    WRITE_COMMAND( kCommandBindProgram );
+    Write<U32>( Reference( program ) );
+    Write<U8>( version );
+    fTarget->BindProgram( program, version );
+}
+
+void
+CaptureCommandBuffer::BindInstancing( U32 count, Geometry::Vertex* instanceData )
+{
+    fTarget->BindInstancing( count, instanceData );
+}
+
+void
+CaptureCommandBuffer::BindVertexFormat( FormatExtensionList* list, U16 fullCount, U16 vertexSize, U32 offset )
+{
+    WRITE_COMMAND( kCommandBindVertexFormat );
+    Write<U16>( list->GetAttributeCount() > 0 ? 0 : fullCount );
+    Write<U32>( offset );
+    fTarget->BindVertexFormat( list, fullCount, vertexSize, offset );
+}
+
+void
+CaptureCommandBuffer::SetBlendEnabled( bool enabled )
+{
+    WRITE_COMMAND( kCommandSetBlendEnabled );
+    Write<bool>( enabled );
+    fTarget->SetBlendEnabled( enabled );
+}
+
+void
+CaptureCommandBuffer::SetBlendFunction( const BlendMode& mode )
+{
+    WRITE_COMMAND( kCommandSetBlendFunction );
+    Write<BlendMode>( mode );
+    fTarget->SetBlendFunction( mode );
+}
+
+void
+CaptureCommandBuffer::SetBlendEquation( RenderTypes::BlendEquation mode )
+{
+    WRITE_COMMAND( kCommandSetBlendEquation );
+    Write<U8>( mode );
+    fTarget->SetBlendEquation( mode );
+}
+
+void
+CaptureCommandBuffer::SetViewport( int x, int y, int width, int height )
+{
+    WRITE_COMMAND( kCommandSetViewport );
+    Write<S32>( x );
+    Write<S32>( y );
+    Write<S32>( width );
+    Write<S32>( height );
+    fTarget->SetViewport( x, y, width, height );
+}
+
+void
+CaptureCommandBuffer::SetScissorEnabled( bool enabled )
+{
+    WRITE_COMMAND( kCommandSetScissorEnabled );
+    Write<bool>( enabled );
+    fTarget->SetScissorEnabled( enabled );
+}
+
+void
+CaptureCommandBuffer::SetScissorRegion( int x, int y, int width, int height )
+{
+    WRITE_COMMAND( kCommandSetScissorRegion );
+    Write<S32>( x );
+    Write<S32>( y );
+    Write<S32>( width );
+    Write<S32>( height );
+    fTarget->SetScissorRegion( x, y, width, height );
+}
+
+void
+CaptureCommandBuffer::ClearDepth( Real depth )
+{
+    WRITE_COMMAND( kCommandClearDepth );
+    Write<Real>( depth );
+    fTarget->ClearDepth( depth );
+}
+
+void
+CaptureCommandBuffer::ClearStencil( U32 stencil )
+{
+    WRITE_COMMAND( kCommandClearStencil );
+    Write<U32>( stencil );
+    fTarget->ClearStencil( stencil );
+}
+
+void
+CaptureCommandBuffer::Clear( Real r, Real g, Real b, Real a )
+{
+    WRITE_COMMAND( kCommandClear );
+    Write<Real>( r );
+    Write<Real>( g );
+    Write<Real>( b );
+    Write<Real>( a );
+    fTarget->Clear( r, g, b, a );
+}
+
+void
+CaptureCommandBuffer::Draw( U32 offset, U32 count, Geometry::PrimitiveType type )
+{
+    WRITE_COMMAND( kCommandDraw );
+    Write<U32>( offset );
+    Write<U32>( count );
+    Write<U8>( type );
+    fTarget->Draw( offset, count, type );
+}
+
+void
+CaptureCommandBuffer::DrawIndexed( U32 offset, U32 count, Geometry::PrimitiveType type )
+{
+    WRITE_COMMAND( kCommandDrawIndexed );
+    Write<U32>( offset );
+    Write<U32>( count );
+    Write<U8>( type );
+    fTarget->DrawIndexed( offset, count, type );
+}
+
+S32
+CaptureCommandBuffer::GetCachedParam( CommandBuffer::QueryableParams param )
+{
+    return fTarget->GetCachedParam( param );
+}
+
+void
+CaptureCommandBuffer::AddCommand( const CoronaCommand * command )
+{
+    fTarget->AddCommand( command );
+}
+
+void
+CaptureCommandBuffer::IssueCommand( U16 id, const void * data, U32 size )
+{
+    fTarget->IssueCommand( id, data, size );
+}
+
+const unsigned char *
+CaptureCommandBuffer::GetBaseAddress() const
+{
+    return fTarget->GetBaseAddress();
+}
+
+bool
+CaptureCommandBuffer::WriteNamedUniform( const char * uniformName, const void * data, unsigned int size )
+{
+    return fTarget->WriteNamedUniform( uniformName, data, size );
+}
+
+void
+CaptureCommandBuffer::WillRender()
+{
+    WRITE_COMMAND( kCommandWillRender );
+    fTarget->WillRender();
+}
+
+void
+CaptureCommandBuffer::PrepareTimeTransforms( float rawTime, const TimeTransform* transform )
+{
+    // Transforms are Lua-defined, so only the result is kept
+    WRITE_COMMAND( kCommandPrepareTimeTransforms );
+    Write<Real>( transform->func ? transform->Apply( rawTime ) : rawTime );
+    fTarget->PrepareTimeTransforms( rawTime, transform );
+}
+
+Real
+CaptureCommandBuffer::Execute( bool measureGPU )
+{
+    Rtt_ASSERT_NOT_REACHED();
+    return fTarget->Execute( measureGPU );
+}
+
+template <typename T>
+void
+CaptureCommandBuffer::Write( T value )
+{
+    WriteBytes( &value, sizeof( T ) );
+}
+
+U32
+CaptureCommandBuffer::Reference( CPUResource* resource )
+{
+    if ( ! resource )
+    {
+        return 0;
+    }
+
+    std::unordered_map< const CPUResource*, U32 >::const_iterator it = fResourceIndices.find( resource );
+    if ( it != fResourceIndices.end() )
+    {
+        return it->second;
+    }
+
+    // Load order must allow FBOs to find their texture
+    if ( CPUResource::kFrameBufferObject == resource->GetType() )
+    {
+        Reference( static_cast< FrameBufferObject* >( resource )->GetTexture() );
+    }
+
+    fResources.push_back( resource );
+
+    U32 index = (U32)fResources.size();
+    fResourceIndices[resource] = index;
+    return index;
+}
+
+bool
+CaptureCommandBuffer::Save( const char* path ) const
+{
+    std::vector< U8 > out;
+    out.insert( out.end(), kMagic, kMagic + sizeof( kMagic ) );
+
+    Put<U32>( out, (U32)fResources.size() );
+    for ( size_t i = 0; i < fResources.size(); i++ )
+    {
+        CPUResource* resource = fResources[i];
+        Put<U8>( out, resource->GetType() );
+
+        switch ( resource->GetType() )
+        {
+            case CPUResource::kFrameBufferObject:
+            {
+                FrameBufferObject* fbo = static_cast< FrameBufferObject* >( resource );
+                std::unordered_map< const CPUResource*, U32 >::const_iterator it = fResourceIndices.find( fbo->GetTexture() );
+                Put<U32>( out, it != fResourceIndices.end() ? it->second : 0 );
+                break;
+            }
+            case CPUResource::kGeometry:
+            {
+                Geometry* geometry = static_cast< Geometry* >( resource );
+                Put<U8>( out, geometry->GetPrimitiveType() );
+                Put<bool>( out, geometry->GetStoredOnGPU() );
+                Put<U32>( out, geometry->GetVerticesAllocated() );
+                Put<U32>( out, geometry->GetIndicesAllocated() );
+                Put<U32>( out, geometry->GetVerticesUsed() );
+                Put<U32>( out, geometry->GetIndicesUsed() );
+                PutBytes( out, geometry->GetVertexData(), geometry->GetVerticesUsed() * sizeof( Geometry::Vertex ) );
+                PutBytes( out, geometry->GetIndexData(), geometry->GetIndicesUsed() * sizeof( Geometry::Index ) );
+                break;
+            }
+            case CPUResource::kProgram:
+            {
+                Program* program = static_cast< Program* >( resource );
+                PutString( out, program->GetHeaderSource() );
+                PutString( out, program->GetVertexShaderSource() );
+                PutString( out, program->GetFragmentShaderSource() );
+                break;
+            }
+            case CPUResource::kTexture:
+            {
+                Texture* texture = static_cast< Texture* >( resource );
+                Put<U32>( out, texture->GetWidth() );
+                Put<U32>( out, texture->GetHeight() );
+                Put<U8>( out, texture->GetFormat() );
+                Put<U8>( out, texture->GetFilter() );
+                Put<U8>( out, texture->GetWrapX() );
+                Put<U8>( out, texture->GetWrapY() );
+                Put<U8>( out, texture->GetByteAlignment() );
+
+                // Like GLTexture, release the bits again once copied; image
+                // backed textures reload them on demand
+                const U8* data = texture->GetData();
+                PutBytes( out, data, data ? (U32)texture->GetSizeInBytes() : 0 );
+                if ( data )
+                {
+                    texture->ReleaseData();
+                }
+                break;
+            }
+            case CPUResource::kUniform:
+            {
+                Put<U8>( out, static_cast< Uniform* >( resource )->GetDataType() );
+                break;
+            }
+            default:
+            {
+                Rtt_ASSERT_NOT_REACHED();
+                break;
+            }
+        }
+    }
+
+    Put<U32>( out, fNumCommands );
+    PutBytes( out, fBuffer, fBytesUsed );
+
+    FILE* f = Rtt_FileOpen( path, "wb" );
+    if ( ! f )
+    {
+        return false;
+    }
+    bool result = fwrite( out.data(), 1, out.size(), f ) == out.size();
+    Rtt_FileClose( f );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+CommandReplay::CommandReplay( Rtt_Allocator* allocator )
+:   fAllocator( allocator ),
+    fCommands(),
+    fCommandCount( 0 ),
+    fResources(),
+    fShaderResources()
+{
+}
+
+CommandReplay::~CommandReplay()
+{
+    Clear();
+}
+
+void
+CommandReplay::Clear()
+{
+    for ( size_t i = 0; i < fResources.size(); i++ )
+    {
+        CPUResource* resource = fResources[i];
+        resource->ReleaseGPUResource();
+
+        // Programs belong to their ShaderResource
+        if ( CPUResource::kProgram != resource->GetType() )
+        {
+            Rtt_DELETE( resource );
+        }
+    }
+    fResources.clear();
+
+    for ( size_t i = 0; i < fShaderResources.size(); i++ )
+    {
+        Rtt_DELETE( fShaderResources[i] );
+    }
+    fShaderResources.clear();
+
+    fCommands.clear();
+    fCommandCount = 0;
+}
+
+bool
+CommandReplay::Load( const char* path )
+{
+    Clear();
+
+    std::vector< U8 > file;
+    FILE* f = Rtt_FileOpen( path, "rb" );
+    if ( ! f )
+    {
+        return false;
+    }
+    U8 chunk[4096];
+    for ( size_t n; ( n = fread( chunk, 1, sizeof( chunk ), f ) ) > 0; )
+    {
+        file.insert( file.end(), chunk, chunk + n );
+    }
+    Rtt_FileClose( f );
+
+    Reader reader( file.data(), file.size() );
+
+    char magic[sizeof( kMagic )];
+    if ( ! reader.GetBytes( magic, sizeof( magic ) ) || 0 != memcmp( magic, kMagic, sizeof( kMagic ) ) )
+    {
+        return false;
+    }
+
+    U32 resourceCount = reader.Get< U32 >();
+    for ( U32 i = 0; i < resourceCount && ! reader.Failed(); i++ )
+    {
+        CPUResource* resource = NULL;
+
+        switch ( reader.Get< U8 >() )
+        {
+            case CPUResource::kFrameBufferObject:
+            {
+                U32 textureIndex = reader.Get< U32 >();
+                if ( textureIndex > 0 && textureIndex <= fResources.size()
+                    && CPUResource::kTexture == fResources[textureIndex - 1]->GetType() )
+                {
+                    Texture* texture = static_cast< Texture* >( fResources[textureIndex - 1] );
+                    resource = Rtt_NEW( fAllocator, FrameBufferObject( fAllocator, texture ) );
+                }
+                break;
+            }
+            case CPUResource::kGeometry:
+            {
+                Geometry::PrimitiveType type = (Geometry::PrimitiveType)reader.Get< U8 >();
+                bool storedOnGPU = reader.Get< bool >();
+                U32 verticesAllocated = reader.Get< U32 >();
+                U32 indicesAllocated = reader.Get< U32 >();
+                U32 verticesUsed = reader.Get< U32 >();
+                U32 indicesUsed = reader.Get< U32 >();
+                if ( reader.Failed() || verticesUsed > verticesAllocated || indicesUsed > indicesAllocated )
+                {
+                    break;
+                }
+
+                Geometry* geometry = Rtt_NEW( fAllocator, Geometry( fAllocator, type, verticesAllocated, indicesAllocated, storedOnGPU ) );
+                resource = geometry;
+
+                U32 size = reader.Get< U32 >();
+                const U8* vertices = reader.Skip( size );
+                if ( vertices && size == verticesUsed * sizeof( Geometry::Vertex ) )
+                {
+                    memcpy( geometry->GetVertexData(), vertices, size );
+                }
+                size = reader.Get< U32 >();
+                const U8* indices = reader.Skip( size );
+                if ( indices && size == indicesUsed * sizeof( Geometry::Index ) )
+                {
+                    memcpy( geometry->GetIndexData(), indices, size );
+                }
+                geometry->SetVerticesUsed( verticesUsed );
+                geometry->SetIndicesUsed( indicesUsed );
+                break;
+            }
+            case CPUResource::kProgram:
+            {
+                std::string header = reader.GetString();
+                std::string vertex = reader.GetString();
+                std::string fragment = reader.GetString();
+
+                Program* program = Rtt_NEW( fAllocator, Program( fAllocator ) );
+                if ( ! header.empty() )
+                {
+                    program->SetHeaderSource( header.c_str() );
+                }
+                program->SetVertexShaderSource( vertex.c_str() );
+                program->SetFragmentShaderSource( fragment.c_str() );
+
+                ShaderResource* shaderResource = Rtt_NEW( fAllocator, ShaderResource( program, ShaderTypes::kCategoryDefault ) );
+                program->SetShaderResource( shaderResource );
+                fShaderResources.push_back( shaderResource );
+
+                resource = program;
+                break;
+            }
+            case CPUResource::kTexture:
+            {
+                U32 width = reader.Get< U32 >();
+                U32 height = reader.Get< U32 >();
+                Texture::Format format = (Texture::Format)reader.Get< U8 >();
+                Texture::Filter filter = (Texture::Filter)reader.Get< U8 >();
+                Texture::Wrap wrapX = (Texture::Wrap)reader.Get< U8 >();
+                Texture::Wrap wrapY = (Texture::Wrap)reader.Get< U8 >();
+                U8 alignment = reader.Get< U8 >();
+
+                CapturedTexture* texture = Rtt_NEW( fAllocator, CapturedTexture( fAllocator, width, height, format, filter, wrapX, wrapY, alignment ) );
+                resource = texture;
+
+                U32 size = reader.Get< U32 >();
+                const U8* data = reader.Skip( size );
+                if ( data )
+                {
+                    texture->fData.assign( data, data + size );
+                }
+                break;
+            }
+            case CPUResource::kUniform:
+            {
+                resource = Rtt_NEW( fAllocator, Uniform( fAllocator, (Uniform::DataType)reader.Get< U8 >() ) );
+                break;
+            }
+            default:
+                break;
+        }
+
+        if ( ! resource )
+        {
+            Clear();
+            return false;
+        }
+        fResources.push_back( resource );
+    }
+
+    fCommandCount = reader.Get< U32 >();
+    U32 size = reader.Get< U32 >();
+    const U8* commands = reader.Skip( size );
+    if ( reader.Failed() || ! commands )
+    {
+        Clear();
+        return false;
+    }
+    fCommands.assign( commands, commands + size );
+
+    return true;
+}
+
+void
+CommandReplay::Prepare( Renderer& renderer )
+{
+    for ( size_t i = 0; i < fResources.size(); i++ )
+    {
+        CPUResource* resource = fResources[i];
+        GPUResource* gpuResource = renderer.Create( resource );
+        if ( gpuResource )
+        {
+            gpuResource->Create( resource );
+            resource->SetGPUResource( gpuResource );
+        }
+    }
+}
+
+Real
+CommandReplay::Execute( Renderer& renderer, bool measureGPU )
+{
+    CommandBuffer* buffer = renderer.fBackCommandBuffer;
+    Record( *buffer );
+    return buffer->Execute( measureGPU );
+}
+
+void
+CommandReplay::Record( CommandBuffer& buffer )
+{
+    Reader reader( fCommands.data(), fCommands.size() );
+
+    #define RESOURCE( Type, index ) \
+        ( (index) > 0 && (index) <= fResources.size() ? static_cast< Type* >( fResources[(index) - 1] ) : NULL )
+
+    for ( U32 i = 0; i < fCommandCount && ! reader.Failed(); i++ )
+    {
+        switch ( reader.Get< U8 >() )
+        {
+            case kCommandBindFrameBufferObject:
+            {
+                U32 fbo = reader.Get< U32 >();
+                bool asDrawBuffer = reader.Get< bool >();
+                buffer.BindFrameBufferObject( RESOURCE( FrameBufferObject, fbo ), asDrawBuffer );
+                break;
+            }
+            case kCommandCaptureRect:
+            {
+                U32 fbo = reader.Get< U32 >();
+                Texture* texture = RESOURCE( Texture, reader.Get< U32 >() );
+                Rect rect = reader.Get< Rect >();
+                Rect rawRect = reader.Get< Rect >();
+                if ( texture )
+                {
+                    buffer.CaptureRect( RESOURCE( FrameBufferObject, fbo ), *texture, rect, rawRect );
+                }
+                break;
+            }
+            case kCommandBindGeometry:
+            {
+                buffer.BindGeometry( RESOURCE( Geometry, reader.Get< U32 >() ) );
+                break;
+            }
+            case kCommandBindTexture:
+            {
+                Texture* texture = RESOURCE( Texture, reader.Get< U32 >() );
+                buffer.BindTexture( texture, reader.Get< U32 >() );
+                break;
+            }
+            case kCommandBindUniform:
+            {
+                Uniform* uniform = RESOURCE( Uniform, reader.Get< U32 >() );
+                U32 unit = reader.Get< U32 >();
+                if ( uniform && reader.GetBytes( uniform->GetData(), uniform->GetSizeInBytes() ) )
+                {
+                    buffer.BindUniform( uniform, unit );
+                }
+                break;
+            }
+            case kCommandBindProgram:
+            {
+                Program* program = RESOURCE( Program, reader.Get< U32 >() );
+                buffer.BindProgram( program, (Program::Version)reader.Get< U8 >() );
+                break;
+            }
+            case kCommandBindVertexFormat:
+            {
+                U16 fullCount = reader.Get< U16 >();
+                U32 offset = reader.Get< U32 >();
+                FormatExtensionList list;
+                buffer.BindVertexFormat( &list, fullCount, (U16)FormatExtensionList::GetVertexSize( NULL ), offset );
+                break;
+            }
+            case kCommandClearUserUniforms:
+            {
+                buffer.ClearUserUniforms();
+                break;
+            }
+            case kCommandPrepareTimeTransforms:
+            {
+                TimeTransform none;
+                buffer.PrepareTimeTransforms( reader.Get< Real >(), &none );
+                break;
+            }
+            case kCommandSetBlendEnabled:
+            {
+                buffer.SetBlendEnabled( reader.Get< bool >() );
+                break;
+            }
+            case kCommandSetBlendFunction:
+            {
+                buffer.SetBlendFunction( reader.Get< BlendMode >() );
+                break;
+            }
+            case kCommandSetBlendEquation:
+            {
+                buffer.SetBlendEquation( (RenderTypes::BlendEquation)reader.Get< U8 >() );
+                break;
+            }
+            case kCommandSetViewport:
+            {
+                S32 x = reader.Get< S32 >();
+                S32 y = reader.Get< S32 >();
+                S32 width = reader.Get< S32 >();
+                S32 height = reader.Get< S32 >();
+                buffer.SetViewport( x, y, width, height );
+                break;
+            }
+            case kCommandSetScissorEnabled:
+            {
+                buffer.SetScissorEnabled( reader.Get< bool >() );
+                break;
+            }
+            case kCommandSetScissorRegion:
+            {
+                S32 x = reader.Get< S32 >();
+                S32 y = reader.Get< S32 >();
+                S32 width = reader.Get< S32 >();
+                S32 height = reader.Get< S32 >();
+                buffer.SetScissorRegion( x, y, width, height );
+                break;
+            }
+            case kCommandClearDepth:
+            {
+                buffer.ClearDepth( reader.Get< Real >() );
+                break;
+            }
+            case kCommandClearStencil:
+            {
+                buffer.ClearStencil( reader.Get< U32 >() );
+                break;
+            }
+            case kCommandClear:
+            {
+                Real r = reader.Get< Real >();
+                Real g = reader.Get< Real >();
+                Real b = reader.Get< Real >();
+                Real a = reader.Get< Real >();
+                buffer.Clear( r, g, b, a );
+                break;
+            }
+            case kCommandDraw:
+            {
+                U32 offset = reader.Get< U32 >();
+                U32 count = reader.Get< U32 >();
+                buffer.Draw( offset, count, (Geometry::PrimitiveType)reader.Get< U8 >() );
+                break;
+            }
+            case kCommandDrawIndexed:
+            {
+                U32 offset = reader.Get< U32 >();
+                U32 count = reader.Get< U32 >();
+                buffer.DrawIndexed( offset, count, (Geometry::PrimitiveType)reader.Get< U8 >() );
+                break;
+            }
+            case kCommandWillRender:
+            {
+                buffer.WillRender();
+                break;
+            }
+            default:
+                Rtt_ASSERT_NOT_REACHED();
+                break;
+        }
+    }
+
+    #undef RESOURCE
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+#undef WRITE_COMMAND
+
+// ----------------------------------------------------------------------------
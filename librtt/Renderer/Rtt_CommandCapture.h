@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_CommandCapture_H__
+#define _Rtt_CommandCapture_H__
+
+#include "Renderer/Rtt_CommandBuffer.h"
+
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+struct CoronaCommand;
+
+namespace Rtt
+{
+
+class CPUResource;
+class Renderer;
+class ShaderResource;
+
+// ----------------------------------------------------------------------------
+
+// Sits in front of a Renderer's back CommandBuffer for one frame, passing
+// every call through while recording it. Save() then writes the calls
+// together with the geometry, textures, shader sources and uniform values
+// they refer to, so that CommandReplay can reproduce the frame without the
+// app that produced it.
+//
+// Custom commands, instancing and vertex extension data are passed through
+// but not recorded; such frames replay with stock vertex formats.
+class CaptureCommandBuffer : public CommandBuffer
+{
+    public:
+        typedef CommandBuffer Super;
+        typedef CaptureCommandBuffer Self;
+
+		bool HasFramebufferBlit( bool * canScale ) const;
+        void GetVertexAttributes( VertexAttributeSupport & support ) const;
+
+    public:
+        CaptureCommandBuffer( Rtt_Allocator* allocator, CommandBuffer* target );
+        virtual ~CaptureCommandBuffer();
+
+        CommandBuffer* GetTarget() const { return fTarget; }
+
+        // Must be called before any of the recorded resources change, i.e.
+        // at the end of the frame. Returns false if the file can't be written.
+        bool Save( const char* path ) const;
+
+    public:
+        virtual void Initialize();
+        virtual void Denitialize();
+        virtual void ClearUserUniforms();
+
+        virtual void BindFrameBufferObject( FrameBufferObject* fbo, bool asDrawBuffer );
+		virtual void CaptureRect( FrameBufferObject* fbo, Texture& texture, const Rect& rect, const Rect& rawRect );
+		virtual void BindGeometry( Geometry* geometry );
+        virtual void BindTexture( Texture* texture, U32 unit );
+        virtual void BindUniform( Uniform* uniform, U32 unit );
+        virtual void BindProgram( Program* program, Program::Version version );
+        virtual void BindInstancing( U32 count, Geometry::Vertex* instanceData );
+        virtual void BindVertexFormat( FormatExtensionList* list, U16 fullCount, U16 vertexSize, U32 offset );
+        virtual void SetBlendEnabled( bool enabled );
+        virtual void SetBlendFunction( const BlendMode& mode );
+        virtual void SetBlendEquation( RenderTypes::BlendEquation mode );
+        virtual void SetViewport( int x, int y, int width, int height );
+        virtual void SetScissorEnabled( bool enabled );
+        virtual void SetScissorRegion( int x, int y, int width, int height );
+        virtual void ClearDepth( Real depth );
+        virtual void ClearStencil( U32 stencil );
+        virtual void Clear( Real r, Real g, Real b, Real a );
+        virtual void Draw( U32 offset, U32 count, Geometry::PrimitiveType type );
+        virtual void DrawIndexed( U32 offset, U32 count, Geometry::PrimitiveType type );
+        virtual S32 GetCachedParam( CommandBuffer::QueryableParams param );
+
+        virtual void AddCommand( const CoronaCommand * command );
+        virtual void IssueCommand( U16 id, const void * data, U32 size );
+
+        virtual const unsigned char * GetBaseAddress() const;
+
+        virtual bool WriteNamedUniform( const char * uniformName, const void * data, unsigned int size );
+
+        virtual void WillRender();
+        virtual void PrepareTimeTransforms( float rawTime, const TimeTransform* transform );
+
+        // Never executed; the target is swapped back in before Render().
+        virtual Real Execute( bool measureGPU );
+
+    private:
+        virtual void InitializeFBO();
+        virtual void InitializeCachedParams();
+        virtual void CacheQueryParam( CommandBuffer::QueryableParams param );
+
+    private:
+        template <typename T>
+        void Write( T value );
+
+        // Index of the resource in the capture, 0 for NULL
+        U32 Reference( CPUResource* resource );
+
+        CommandBuffer* fTarget;
+        std::vector< CPUResource* > fResources;
+        std::unordered_map< const CPUResource*, U32 > fResourceIndices;
+};
+
+// Loads a capture written by CaptureCommandBuffer and issues it to a
+// Renderer's back CommandBuffer, as often as needed.
+class CommandReplay
+{
+    public:
+        typedef CommandReplay Self;
+
+    public:
+        CommandReplay( Rtt_Allocator* allocator );
+        ~CommandReplay();
+
+        // Returns false if the file is missing or not a capture.
+        bool Load( const char* path );
+
+        // Creates the GPU side of every captured resource. The rendering
+        // context must be current.
+        void Prepare( Renderer& renderer );
+
+        // Records the captured frame into the renderer's back CommandBuffer
+        // and executes it. Returns the GPU time, if measured.
+        Real Execute( Renderer& renderer, bool measureGPU );
+
+        U32 GetCommandCount() const { return fCommandCount; }
+        U32 GetResourceCount() const { return (U32)fResources.size(); }
+
+    private:
+        void Record( CommandBuffer& buffer );
+        void Clear();
+
+        Rtt_Allocator* fAllocator;
+        std::vector< U8 > fCommands;
+        U32 fCommandCount;
+        std::vector< CPUResource* > fResources;
+        std::vector< ShaderResource* > fShaderResources;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_CommandCapture_H__
@@ -101,6 +101,12 @@ void GLLogError( const char* message, const char* file, int line );
 
 #endif
     
+// Program binaries (GL 4.1 or ARB_get_program_binary) are only used on
+// desktop GL. Whether the driver supports any format is checked at runtime.
+#if ! defined( Rtt_OPENGLES ) && ! defined( Rtt_MAC_ENV ) && defined( GL_PROGRAM_BINARY_LENGTH )
+	#define Rtt_GL_PROGRAM_BINARY 1
+#endif
+
 // Enable GPU timer queries on supported platforms
 #if defined( Rtt_WIN_ENV )
     #define ENABLE_GPU_TIMER_QUERIES
@@ -12,6 +12,7 @@
 
 #include "Renderer/Rtt_CommandBuffer.h"
 #include "Renderer/Rtt_FormatExtensionList.h"
+#include "Renderer/Rtt_ProgramBinaryCache.h"
 //#include "Renderer/Rtt_Geometry_Renderer.h"
 #include "Renderer/Rtt_Texture.h"
 #include "Core/Rtt_Assert.h"
@@ -95,6 +96,107 @@ namespace /*anonymous*/
 			delete[] infoLog;
 		}
 	}
+
+#if defined( Rtt_GL_PROGRAM_BINARY )
+    const char kProgramBinaryExtension[] = "glprogram";
+
+    // Binaries are only valid for the driver that produced them
+    U64 DriverHash()
+    {
+        static U64 sHash = 0;
+
+        if ( 0 == sHash )
+        {
+            sHash = ProgramBinaryCache::Hash( "GLProgram.1" ); // bump when the attribute bindings change
+            sHash = ProgramBinaryCache::Hash( (const char *)glGetString( GL_VENDOR ), sHash );
+            sHash = ProgramBinaryCache::Hash( (const char *)glGetString( GL_RENDERER ), sHash );
+            sHash = ProgramBinaryCache::Hash( (const char *)glGetString( GL_VERSION ), sHash );
+        }
+
+        return sHash;
+    }
+
+    bool SupportsProgramBinaries()
+    {
+        static GLint sFormatCount = -1;
+
+        if ( sFormatCount < 0 )
+        {
+            sFormatCount = 0;
+            glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &sFormatCount );
+            glGetError(); // Unknown enum before GL 4.1
+        }
+
+        return sFormatCount > 0 && ProgramBinaryCache::IsEnabled();
+    }
+
+    // Key by the final source, i.e. after headers and shell transforms were applied
+    U64 ProgramBinaryKey( GLuint vertexShader, GLuint fragmentShader )
+    {
+        U64 result = DriverHash();
+
+        GLuint shaders[] = { vertexShader, fragmentShader };
+        std::vector< GLchar > source;
+
+        for ( size_t i = 0; i < sizeof( shaders ) / sizeof( shaders[0] ); i++ )
+        {
+            GLint length = 0;
+            glGetShaderiv( shaders[i], GL_SHADER_SOURCE_LENGTH, &length );
+
+            source.resize( length + 1 );
+            glGetShaderSource( shaders[i], (GLsizei)source.size(), NULL, source.data() );
+            source[length] = '\0';
+
+            result = ProgramBinaryCache::Hash( source.data(), result );
+        }
+
+        return result;
+    }
+
+    bool LoadProgramBinary( GLuint program, U64 key )
+    {
+        std::vector< U8 > data;
+        if ( ! ProgramBinaryCache::Read( key, kProgramBinaryExtension, data ) || data.size() <= sizeof( GLenum ) )
+        {
+            return false;
+        }
+
+        GLenum format;
+        memcpy( &format, data.data(), sizeof( format ) );
+        glProgramBinary( program, format, data.data() + sizeof( format ), (GLsizei)( data.size() - sizeof( format ) ) );
+
+        // Drivers reject binaries they no longer understand, so fall back to compiling
+        GLint result = GL_FALSE;
+        glGetProgramiv( program, GL_LINK_STATUS, &result );
+        glGetError();
+
+        return GL_TRUE == result;
+    }
+
+    void StoreProgramBinary( GLuint program, U64 key )
+    {
+        GLint isLinked = GL_FALSE;
+        GLint length = 0;
+        glGetProgramiv( program, GL_LINK_STATUS, &isLinked );
+        glGetProgramiv( program, GL_PROGRAM_BINARY_LENGTH, &length );
+
+        if ( GL_TRUE == isLinked && length > 0 )
+        {
+            std::vector< U8 > data( sizeof( GLenum ) + length );
+
+            GLenum format = 0;
+            GLsizei written = 0;
+            glGetProgramBinary( program, length, &written, &format, data.data() + sizeof( format ) );
+            GL_CHECK_ERROR();
+
+            if ( written > 0 )
+            {
+                memcpy( data.data(), &format, sizeof( format ) );
+                ProgramBinaryCache::Write( key, kProgramBinaryExtension, data.data(), sizeof( format ) + written );
+            }
+        }
+    }
+#endif
 }
 
 // ----------------------------------------------------------------------------
@@ -174,6 +276,28 @@ GLProgram::Create( CPUResource* resource )
     {
         fCleanupShellTransform = transform->cleanup;
     }
+
+    Prewarm( resource );
+}
+
+void
+GLProgram::Prewarm( CPUResource* resource )
+{
+    Rtt_ASSERT( resource == fResource );
+
+    #if DEFER_CREATION
+        // Pre-warmed versions are compiled (or loaded from the program
+        // binary cache) up front rather than on first use
+        Program* program = static_cast<Program*>( resource );
+
+        for( U32 i = 0; i < Program::kNumVersions; ++i )
+        {
+            if ( program->GetPrewarmVersions() & ( 1 << i ) )
+            {
+                CreateDeferred( (Program::Version)i );
+            }
+        }
+    #endif
 }
 
 void
@@ -220,25 +344,35 @@ GLProgram::Bind( Program::Version version )
     VersionData& data = fData[version];
     
     #if DEFER_CREATION
-        if( !data.fProgram )
-        {
-            Create( version, data );
-            
-            if ( fData[version].HasTime() )
-            {
-				Program* program = (Program*)fResource;
-				
-				program->GetShaderResource()->SetUsesTime( true );
-				
-				ShaderResource::SetAddedUsesTime( true );
-            }
-        }
+        CreateDeferred( version );
     #endif
     
     glUseProgram( data.fProgram );
     GL_CHECK_ERROR();
 }
 
+void
+GLProgram::CreateDeferred( Program::Version version )
+{
+    VersionData& data = fData[version];
+
+    if( !data.fProgram )
+    {
+        SUMMED_TIMING( glpd, "Program GPU Resource: Create Version" );
+
+        Create( version, data );
+
+        if ( data.HasTime() )
+        {
+            Program* program = (Program*)fResource;
+
+            program->GetShaderResource()->SetUsesTime( true );
+
+            ShaderResource::SetAddedUsesTime( true );
+        }
+    }
+}
+
 void
 GLProgram::Create( Program::Version version, VersionData& data )
 {
@@ -568,28 +702,58 @@ GLProgram::Update( Program::Version version, VersionData& data )
                         data );
 
 
-    bool isVerbose = program->IsCompilerVerbose(); 
-    int kernelStartLine = 0; 
+    bool isLinked = false;
+
+#if defined( Rtt_GL_PROGRAM_BINARY )
+    bool usesBinaryCache = SupportsProgramBinaries();
+    U64 binaryKey = 0;
 
-    glCompileShader( data.fVertexShader );
-    if ( isVerbose )
+    if ( usesBinaryCache )
     {
-        kernelStartLine = data.fHeaderNumLines + program->GetVertexShellNumLines();
+        binaryKey = ProgramBinaryKey( data.fVertexShader, data.fFragmentShader );
+        isLinked = LoadProgramBinary( data.fProgram, binaryKey );
     }
-    CheckShaderCompilationStatus( data.fVertexShader, isVerbose, "vertex", kernelStartLine );
-    GL_CHECK_ERROR();
+#endif
 
-    glCompileShader( data.fFragmentShader );
-    if ( isVerbose )
+    if ( ! isLinked )
     {
-        kernelStartLine = data.fHeaderNumLines + program->GetFragmentShellNumLines();
-    }
-    CheckShaderCompilationStatus( data.fFragmentShader, isVerbose, "fragment", kernelStartLine );
-    GL_CHECK_ERROR();
+        bool isVerbose = program->IsCompilerVerbose(); 
+        int kernelStartLine = 0; 
 
-	glLinkProgram( data.fProgram );
-	CheckProgramLinkStatus( data.fProgram, isVerbose );
-	GL_CHECK_ERROR();
+        glCompileShader( data.fVertexShader );
+        if ( isVerbose )
+        {
+            kernelStartLine = data.fHeaderNumLines + program->GetVertexShellNumLines();
+        }
+        CheckShaderCompilationStatus( data.fVertexShader, isVerbose, "vertex", kernelStartLine );
+        GL_CHECK_ERROR();
+
+        glCompileShader( data.fFragmentShader );
+        if ( isVerbose )
+        {
+            kernelStartLine = data.fHeaderNumLines + program->GetFragmentShellNumLines();
+        }
+        CheckShaderCompilationStatus( data.fFragmentShader, isVerbose, "fragment", kernelStartLine );
+        GL_CHECK_ERROR();
+
+#if defined( Rtt_GL_PROGRAM_BINARY )
+        if ( usesBinaryCache )
+        {
+            glProgramParameteri( data.fProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+        }
+#endif
+
+        glLinkProgram( data.fProgram );
+        CheckProgramLinkStatus( data.fProgram, isVerbose );
+        GL_CHECK_ERROR();
+
+#if defined( Rtt_GL_PROGRAM_BINARY )
+        if ( usesBinaryCache )
+        {
+            StoreProgramBinary( data.fProgram, binaryKey );
+        }
+#endif
+    }
 
     data.fUniformLocations[Uniform::kViewProjectionMatrix] = glGetUniformLocation( data.fProgram, "u_ViewProjectionMatrix" );
     GL_CHECK_ERROR();
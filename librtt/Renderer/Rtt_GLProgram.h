@@ -37,6 +37,7 @@ class GLProgram : public GPUResource
 
 		virtual void Create( CPUResource* resource );
 		virtual void Update( CPUResource* resource );
+		virtual void Prewarm( CPUResource* resource );
 		virtual void Destroy();
 		virtual void Bind( Program::Version version );
 
@@ -82,6 +83,7 @@ class GLProgram : public GPUResource
 		};
 
 		void Create( Program::Version version, VersionData& data );
+		void CreateDeferred( Program::Version version );
 		void Update( Program::Version version, VersionData& data );
 		void UpdateShaderSource( Program* program, Program::Version version, VersionData& data );
 		void Reset( VersionData& data );
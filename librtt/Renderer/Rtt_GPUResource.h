@@ -47,6 +47,11 @@ class GPUResource
         // Called when the source data for this GPUResource is manipulated. 
         // Derived classes should update their internal resources to match.
         virtual void Update( CPUResource* resource ) = 0;
+
+        // Called when more of the given data should be built up front than
+        // it was created with, e.g. additional Program versions. The default
+        // does nothing.
+        virtual void Prewarm( CPUResource* resource ) {}
         
         // Destroy any allocated internal resources. It is the responsibility
         // of the caller to ensure that this function is not invoked on a 
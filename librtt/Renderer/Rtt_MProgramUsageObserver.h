@@ -0,0 +1,38 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md 
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_MProgramUsageObserver_H__
+#define _Rtt_MProgramUsageObserver_H__
+
+#include "Renderer/Rtt_Program.h"
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+class MProgramUsageObserver
+{
+
+public:
+	virtual ~MProgramUsageObserver(){};
+
+	// Called the first time each version of a program is bound.
+	virtual void DidUseProgram( const Program& program, Program::Version version ) = 0;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_MProgramUsageObserver_H__
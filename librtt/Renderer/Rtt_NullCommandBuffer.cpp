@@ -0,0 +1,628 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Renderer/Rtt_NullCommandBuffer.h"
+
+#include "Renderer/Rtt_FrameBufferObject.h"
+#include "Renderer/Rtt_FormatExtensionList.h"
+#include "Renderer/Rtt_GPUResource.h"
+#include "Renderer/Rtt_Program.h"
+#include "Renderer/Rtt_Texture.h"
+#include "Renderer/Rtt_Uniform.h"
+#include "Display/Rtt_ObjectHandle.h"
+#include "Core/Rtt_Allocator.h"
+#include "Core/Rtt_Assert.h"
+#include "Core/Rtt_Math.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "Corona/CoronaGraphics.h"
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+    enum Command
+    {
+        kCommandBindFrameBufferObject,
+        kCommandUnBindFrameBufferObject,
+		kCommandCaptureRect,
+        kCommandBindGeometry,
+        kCommandBindTexture,
+        kCommandBindProgram,
+        kCommandBindInstancing,
+        kCommandResolveVertexFormat,
+        kCommandApplyUniform,
+        kCommandEnableBlend,
+        kCommandDisableBlend,
+        kCommandSetBlendFunction,
+        kCommandSetBlendEquation,
+        kCommandSetViewport,
+        kCommandEnableScissor,
+        kCommandDisableScissor,
+        kCommandSetScissorRegion,
+        kCommandClearDepth,
+        kCommandClearStencil,
+        kCommandClear,
+        kCommandDraw,
+        kCommandDrawIndexed,
+        kNumCommands
+    };
+
+    // As with GLCommandBuffer, the timestamps must be comparable across the
+    // front and back CommandBuffers.
+    static U32 gUniformTimestamp = 0;
+
+    // Frames executed so far, by either CommandBuffer
+    static U32 gFrameCount = 0;
+
+    #define WRITE_COMMAND( command ) Write<Command>( command ); ++fNumCommands;
+
+    // Position in creation order; see NullRenderer
+    U32
+    ResourceId( const Rtt::GPUResource* resource )
+    {
+        return resource ? (U32)(uintptr_t)resource->GetHandle() : 0;
+    }
+
+    const char*
+    PrimitiveName( Rtt::Geometry::PrimitiveType type )
+    {
+        switch( type )
+        {
+            case Rtt::Geometry::kTriangleStrip:     return "triangleStrip";
+            case Rtt::Geometry::kTriangleFan:       return "triangleFan";
+            case Rtt::Geometry::kTriangles:         return "triangles";
+            case Rtt::Geometry::kIndexedTriangles:  return "indexedTriangles";
+            case Rtt::Geometry::kLines:             return "lines";
+            case Rtt::Geometry::kLineLoop:          return "lineLoop";
+            default:                                return "unknown";
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+bool
+NullCommandBuffer::HasFramebufferBlit( bool * canScale ) const
+{
+	if ( canScale )
+	{
+		*canScale = false;
+	}
+	return false;
+}
+
+void
+NullCommandBuffer::GetVertexAttributes( VertexAttributeSupport & support ) const
+{
+    // The minimum OpenGL ES 2.0 guarantees, less the built-ins
+    support.maxCount = 8 - 4;
+    support.hasInstancing = false;
+    support.hasDivisors = false;
+    support.hasPerInstance = false;
+    support.suffix = NULL;
+}
+
+NullCommandBuffer::NullCommandBuffer( Rtt_Allocator* allocator, FILE* stream )
+:    CommandBuffer( allocator ),
+     fCustomCommands( allocator ),
+     fStream( stream )
+{
+    for(U32 i = 0; i < Uniform::kNumBuiltInVariables; ++i)
+    {
+        fUniforms[i] = NULL;
+        fUniformTimestamps[i] = 0;
+        fAppliedTimestamps[i] = 0;
+    }
+}
+
+NullCommandBuffer::~NullCommandBuffer()
+{
+}
+
+void
+NullCommandBuffer::Initialize()
+{
+    InitializeFBO();
+    InitializeCachedParams();
+}
+
+void
+NullCommandBuffer::InitializeFBO()
+{
+}
+
+void
+NullCommandBuffer::InitializeCachedParams()
+{
+}
+
+void
+NullCommandBuffer::CacheQueryParam( CommandBuffer::QueryableParams param )
+{
+}
+
+void
+NullCommandBuffer::Denitialize()
+{
+}
+
+void
+NullCommandBuffer::ClearUserUniforms()
+{
+    fUniforms[Uniform::kMaskMatrix0] = NULL;
+    fUniforms[Uniform::kMaskMatrix1] = NULL;
+    fUniforms[Uniform::kMaskMatrix2] = NULL;
+    fUniforms[Uniform::kUserData0] = NULL;
+    fUniforms[Uniform::kUserData1] = NULL;
+    fUniforms[Uniform::kUserData2] = NULL;
+    fUniforms[Uniform::kUserData3] = NULL;
+}
+
+void
+NullCommandBuffer::BindFrameBufferObject( FrameBufferObject* fbo, bool asDrawBuffer )
+{
+	if( fbo )
+	{
+		WRITE_COMMAND( kCommandBindFrameBufferObject );
+		Write<GPUResource*>( fbo->GetGPUResource() );
+		Write<bool>( asDrawBuffer );
+	}
+	else
+	{
+		WRITE_COMMAND( kCommandUnBindFrameBufferObject );
+	}
+}
+
+void
+NullCommandBuffer::CaptureRect( FrameBufferObject* fbo, Texture& texture, const Rect& rect, const Rect& unclipped )
+{
+	WRITE_COMMAND( kCommandCaptureRect );
+	Write<GPUResource*>( fbo ? NULL : texture.GetGPUResource() );
+	Write<Rect>( rect );
+}
+
+void
+NullCommandBuffer::BindGeometry( Geometry* geometry )
+{
+    WRITE_COMMAND( kCommandBindGeometry );
+    Write<GPUResource*>( geometry->GetGPUResource() );
+}
+
+void
+NullCommandBuffer::BindTexture( Texture* texture, U32 unit )
+{
+    WRITE_COMMAND( kCommandBindTexture );
+    Write<U32>( unit );
+    Write<GPUResource*>( texture->GetGPUResource() );
+}
+
+void
+NullCommandBuffer::BindProgram( Program* program, Program::Version version )
+{
+    WRITE_COMMAND( kCommandBindProgram );
+    Write<Program::Version>( version );
+    Write<GPUResource*>( program->GetGPUResource() );
+
+    AcquireTimeTransform( program->GetShaderResource() );
+}
+
+void
+NullCommandBuffer::BindInstancing( U32 count, Geometry::Vertex* instanceData )
+{
+    WRITE_COMMAND( kCommandBindInstancing );
+    Write<U32>( count );
+}
+
+void
+NullCommandBuffer::BindVertexFormat( FormatExtensionList* list, U16 fullCount, U16 vertexSize, U32 offset )
+{
+    WRITE_COMMAND( kCommandResolveVertexFormat );
+    Write<U16>( fullCount );
+    Write<U16>( vertexSize );
+    Write<U32>( offset );
+    Write<U16>( list->GetAttributeCount() );
+    Write<U16>( list->GetGroupCount() );
+}
+
+void
+NullCommandBuffer::BindUniform( Uniform* uniform, U32 unit )
+{
+    Rtt_ASSERT( unit < Uniform::kNumBuiltInVariables );
+    fUniforms[unit] = uniform;
+    fUniformTimestamps[unit] = ++gUniformTimestamp;
+}
+
+void
+NullCommandBuffer::SetBlendEnabled( bool enabled )
+{
+    WRITE_COMMAND( enabled ? kCommandEnableBlend : kCommandDisableBlend );
+}
+
+void
+NullCommandBuffer::SetBlendFunction( const BlendMode& mode )
+{
+    WRITE_COMMAND( kCommandSetBlendFunction );
+    Write<U8>( mode.fSrcColor );
+    Write<U8>( mode.fDstColor );
+    Write<U8>( mode.fSrcAlpha );
+    Write<U8>( mode.fDstAlpha );
+}
+
+void
+NullCommandBuffer::SetBlendEquation( RenderTypes::BlendEquation mode )
+{
+    WRITE_COMMAND( kCommandSetBlendEquation );
+    Write<U8>( mode );
+}
+
+void
+NullCommandBuffer::SetViewport( int x, int y, int width, int height )
+{
+    WRITE_COMMAND( kCommandSetViewport );
+    Write<S32>( x );
+    Write<S32>( y );
+    Write<S32>( width );
+    Write<S32>( height );
+}
+
+void
+NullCommandBuffer::SetScissorEnabled( bool enabled )
+{
+    WRITE_COMMAND( enabled ? kCommandEnableScissor : kCommandDisableScissor );
+}
+
+void
+NullCommandBuffer::SetScissorRegion( int x, int y, int width, int height )
+{
+    WRITE_COMMAND( kCommandSetScissorRegion );
+    Write<S32>( x );
+    Write<S32>( y );
+    Write<S32>( width );
+    Write<S32>( height );
+}
+
+void
+NullCommandBuffer::ClearDepth( Real depth )
+{
+    WRITE_COMMAND( kCommandClearDepth );
+    Write<Real>( depth );
+}
+
+void
+NullCommandBuffer::ClearStencil( U32 stencil )
+{
+    WRITE_COMMAND( kCommandClearStencil );
+    Write<U32>( stencil );
+}
+
+void
+NullCommandBuffer::Clear( Real r, Real g, Real b, Real a )
+{
+    WRITE_COMMAND( kCommandClear );
+    Write<Real>( r );
+    Write<Real>( g );
+    Write<Real>( b );
+    Write<Real>( a );
+}
+
+void
+NullCommandBuffer::Draw( U32 offset, U32 count, Geometry::PrimitiveType type )
+{
+    ApplyUniforms();
+
+    WRITE_COMMAND( kCommandDraw );
+    Write<U8>( type );
+    Write<U32>( offset );
+    Write<U32>( count );
+}
+
+void
+NullCommandBuffer::DrawIndexed( U32 offset, U32 count, Geometry::PrimitiveType type )
+{
+    ApplyUniforms();
+
+    WRITE_COMMAND( kCommandDrawIndexed );
+    Write<U8>( type );
+    Write<U32>( count );
+}
+
+S32
+NullCommandBuffer::GetCachedParam( CommandBuffer::QueryableParams param )
+{
+    S32 result = -1;
+    if ( kMaxTextureSize == param )
+    {
+        result = (S32)GetMaxTextureSize();
+    }
+    return result;
+}
+
+void
+NullCommandBuffer::AddCommand( const CoronaCommand* command )
+{
+    fCustomCommands.Append( command );
+}
+
+void
+NullCommandBuffer::IssueCommand( U16 id, const void * data, U32 size )
+{
+    OBJECT_HANDLE_SCOPE();
+
+    Command custom = Command( kNumCommands + id );
+
+    WRITE_COMMAND( custom );
+    Write< U32 >( size );
+
+    U8 * buffer = Reserve( size );
+
+    OBJECT_HANDLE_STORE( CommandBuffer, commandBuffer, this );
+
+    fCustomCommands[id]->writer( commandBuffer, buffer, data, size );
+}
+
+bool
+NullCommandBuffer::WriteNamedUniform( const char * uniformName, const void * data, unsigned int size )
+{
+    // Only valid from a custom command's reader, which never runs here
+    return false;
+}
+
+Real
+NullCommandBuffer::Execute( bool measureGPU )
+{
+	fOffset = fBuffer;
+
+	FILE* f = fStream;
+	if ( f )
+	{
+		fprintf( f, "frame %u\n", ++gFrameCount );
+	}
+
+    for( U32 i = 0; i < fNumCommands; ++i )
+    {
+        Command command = Read<Command>();
+
+        switch( command )
+        {
+            case kCommandBindFrameBufferObject:
+            {
+                U32 fbo = ResourceId( Read<GPUResource*>() );
+                bool asDrawBuffer = Read<bool>();
+                if ( f ) { fprintf( f, "BindFrameBufferObject %u%s\n", fbo, asDrawBuffer ? " draw" : "" ); }
+                break;
+            }
+            case kCommandUnBindFrameBufferObject:
+            {
+                if ( f ) { fprintf( f, "UnBindFrameBufferObject\n" ); }
+                break;
+            }
+            case kCommandCaptureRect:
+            {
+                U32 texture = ResourceId( Read<GPUResource*>() );
+                Rect rect = Read<Rect>();
+                if ( f ) { fprintf( f, "CaptureRect %u %g %g %g %g\n", texture, rect.xMin, rect.yMin, rect.xMax, rect.yMax ); }
+                break;
+            }
+            case kCommandBindGeometry:
+            {
+                U32 geometry = ResourceId( Read<GPUResource*>() );
+                if ( f ) { fprintf( f, "BindGeometry %u\n", geometry ); }
+                break;
+            }
+            case kCommandBindTexture:
+            {
+                U32 unit = Read<U32>();
+                U32 texture = ResourceId( Read<GPUResource*>() );
+                if ( f ) { fprintf( f, "BindTexture %u %u\n", unit, texture ); }
+                break;
+            }
+            case kCommandBindProgram:
+            {
+                Program::Version version = Read<Program::Version>();
+                U32 program = ResourceId( Read<GPUResource*>() );
+                if ( f ) { fprintf( f, "BindProgram %u %d\n", program, (int)version ); }
+                break;
+            }
+            case kCommandBindInstancing:
+            {
+                U32 count = Read<U32>();
+                if ( f ) { fprintf( f, "BindInstancing %u\n", count ); }
+                break;
+            }
+            case kCommandResolveVertexFormat:
+            {
+                U16 fullCount = Read<U16>();
+                U16 vertexSize = Read<U16>();
+                U32 offset = Read<U32>();
+                U16 attributeCount = Read<U16>();
+                U16 groupCount = Read<U16>();
+                if ( f ) { fprintf( f, "BindVertexFormat %u %u %u %u %u\n", fullCount, vertexSize, offset, attributeCount, groupCount ); }
+                break;
+            }
+            case kCommandApplyUniform:
+            {
+                U8 unit = Read<U8>();
+                U8 dataType = Read<U8>();
+                if ( f ) { fprintf( f, "ApplyUniform %u %u\n", unit, dataType ); }
+                break;
+            }
+            case kCommandEnableBlend:
+            case kCommandDisableBlend:
+            {
+                if ( f ) { fprintf( f, "SetBlendEnabled %d\n", kCommandEnableBlend == command ); }
+                break;
+            }
+            case kCommandSetBlendFunction:
+            {
+                U8 srcColor = Read<U8>();
+                U8 dstColor = Read<U8>();
+                U8 srcAlpha = Read<U8>();
+                U8 dstAlpha = Read<U8>();
+                if ( f ) { fprintf( f, "SetBlendFunction %u %u %u %u\n", srcColor, dstColor, srcAlpha, dstAlpha ); }
+                break;
+            }
+            case kCommandSetBlendEquation:
+            {
+                U8 equation = Read<U8>();
+                if ( f ) { fprintf( f, "SetBlendEquation %u\n", equation ); }
+                break;
+            }
+            case kCommandSetViewport:
+            case kCommandSetScissorRegion:
+            {
+                S32 x = Read<S32>();
+                S32 y = Read<S32>();
+                S32 width = Read<S32>();
+                S32 height = Read<S32>();
+                if ( f ) { fprintf( f, "%s %d %d %d %d\n", kCommandSetViewport == command ? "SetViewport" : "SetScissorRegion", x, y, width, height ); }
+                break;
+            }
+            case kCommandEnableScissor:
+            case kCommandDisableScissor:
+            {
+                if ( f ) { fprintf( f, "SetScissorEnabled %d\n", kCommandEnableScissor == command ); }
+                break;
+            }
+            case kCommandClearDepth:
+            {
+                Real depth = Read<Real>();
+                if ( f ) { fprintf( f, "ClearDepth %g\n", depth ); }
+                break;
+            }
+            case kCommandClearStencil:
+            {
+                U32 stencil = Read<U32>();
+                if ( f ) { fprintf( f, "ClearStencil %u\n", stencil ); }
+                break;
+            }
+            case kCommandClear:
+            {
+                Real r = Read<Real>();
+                Real g = Read<Real>();
+                Real b = Read<Real>();
+                Real a = Read<Real>();
+                if ( f ) { fprintf( f, "Clear %g %g %g %g\n", r, g, b, a ); }
+                break;
+            }
+            case kCommandDraw:
+            {
+                Geometry::PrimitiveType type = (Geometry::PrimitiveType)Read<U8>();
+                U32 offset = Read<U32>();
+                U32 count = Read<U32>();
+                if ( f ) { fprintf( f, "Draw %s %u %u\n", PrimitiveName( type ), offset, count ); }
+                break;
+            }
+            case kCommandDrawIndexed:
+            {
+                Geometry::PrimitiveType type = (Geometry::PrimitiveType)Read<U8>();
+                U32 count = Read<U32>();
+                if ( f ) { fprintf( f, "DrawIndexed %s %u\n", PrimitiveName( type ), count ); }
+                break;
+            }
+            default:
+            {
+                // Custom commands can only be read by the backend they were
+                // written for, so they are skipped
+                U16 id = command - kNumCommands;
+                Rtt_ASSERT( id < fCustomCommands.Length() );
+
+                U32 size = Read< U32 >();
+                fOffset += size;
+                if ( f ) { fprintf( f, "CustomCommand %u %u\n", id, size ); }
+                break;
+            }
+        }
+    }
+
+    fBytesUsed = 0;
+    fNumCommands = 0;
+
+    // Every frame starts without uniforms applied, so that frames in the
+    // stream do not depend on one another
+    for( U32 i = 0; i < Uniform::kNumBuiltInVariables; ++i )
+    {
+        fAppliedTimestamps[i] = 0;
+    }
+
+    return 0.0f;
+}
+
+template <typename T>
+T
+NullCommandBuffer::Read()
+{
+    Rtt_ASSERT( fOffset < fBuffer + fBytesAllocated );
+    T result;
+    memcpy( &result, fOffset, sizeof( T ) );
+    fOffset += sizeof( T );
+    return result;
+}
+
+template <typename T>
+void
+NullCommandBuffer::Write( T value )
+{
+    U8 * writePos = Reserve( sizeof( T ) );
+    memcpy( writePos, &value, sizeof( T ) );
+}
+
+void
+NullCommandBuffer::ApplyUniforms()
+{
+    for( U32 i = 0; i < Uniform::kNumBuiltInVariables; ++i )
+    {
+        if( fUniforms[i] && fUniformTimestamps[i] != fAppliedTimestamps[i] )
+        {
+            fAppliedTimestamps[i] = fUniformTimestamps[i];
+
+            WRITE_COMMAND( kCommandApplyUniform );
+            Write<U8>( i );
+            Write<U8>( fUniforms[i]->GetDataType() );
+        }
+    }
+}
+
+U8 *
+NullCommandBuffer::Reserve( U32 size )
+{
+    U32 bytesNeeded = fBytesUsed + size;
+    if( bytesNeeded > fBytesAllocated )
+    {
+        U32 doubleSize = fBytesUsed ? 2 * fBytesUsed : 4;
+        U32 newSize = Max( bytesNeeded, doubleSize );
+        U8* newBuffer = new U8[newSize];
+
+        memcpy( newBuffer, fBuffer, fBytesUsed );
+        delete [] fBuffer;
+
+        fBuffer = newBuffer;
+        fBytesAllocated = newSize;
+    }
+
+    U8 * buffer = fBuffer + fBytesUsed;
+
+    fBytesUsed += size;
+
+    return buffer;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+#undef WRITE_COMMAND
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_NullCommandBuffer_H__
+#define _Rtt_NullCommandBuffer_H__
+
+#include "Renderer/Rtt_CommandBuffer.h"
+#include "Renderer/Rtt_Uniform.h"
+
+#include "Core/Rtt_Array.h"
+
+#include <stdio.h>
+
+// ----------------------------------------------------------------------------
+
+struct CoronaCommand;
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Buffers commands exactly like a real backend, so that generating them
+// costs the same, but executing them only decodes the buffer. If a stream
+// is given, decoding writes each command to it as a line of text. Resources
+// are identified by the order in which they were created, which is stable
+// from run to run as long as the app is deterministic.
+class NullCommandBuffer : public CommandBuffer
+{
+    public:
+        typedef CommandBuffer Super;
+        typedef NullCommandBuffer Self;
+
+		bool HasFramebufferBlit( bool * canScale ) const;
+        void GetVertexAttributes( VertexAttributeSupport & support ) const;
+
+    public:
+        NullCommandBuffer( Rtt_Allocator* allocator, FILE* stream );
+        virtual ~NullCommandBuffer();
+
+        virtual void Initialize();
+
+        virtual void Denitialize();
+
+        virtual void ClearUserUniforms();
+
+        virtual void BindFrameBufferObject( FrameBufferObject* fbo, bool asDrawBuffer );
+		virtual void CaptureRect( FrameBufferObject* fbo, Texture& texture, const Rect& rect, const Rect& rawRect );
+		virtual void BindGeometry( Geometry* geometry );
+        virtual void BindTexture( Texture* texture, U32 unit );
+        virtual void BindUniform( Uniform* uniform, U32 unit );
+        virtual void BindProgram( Program* program, Program::Version version );
+        virtual void BindInstancing( U32 count, Geometry::Vertex* instanceData );
+        virtual void BindVertexFormat( FormatExtensionList* list, U16 fullCount, U16 vertexSize, U32 offset );
+        virtual void SetBlendEnabled( bool enabled );
+        virtual void SetBlendFunction( const BlendMode& mode );
+        virtual void SetBlendEquation( RenderTypes::BlendEquation mode );
+        virtual void SetViewport( int x, int y, int width, int height );
+        virtual void SetScissorEnabled( bool enabled );
+        virtual void SetScissorRegion( int x, int y, int width, int height );
+        virtual void ClearDepth( Real depth );
+        virtual void ClearStencil( U32 stencil );
+        virtual void Clear( Real r, Real g, Real b, Real a );
+        virtual void Draw( U32 offset, U32 count, Geometry::PrimitiveType type );
+        virtual void DrawIndexed( U32 offset, U32 count, Geometry::PrimitiveType type );
+        virtual S32 GetCachedParam( CommandBuffer::QueryableParams param );
+
+        virtual void AddCommand( const CoronaCommand * command );
+        virtual void IssueCommand( U16 id, const void * data, U32 size );
+
+        virtual const unsigned char * GetBaseAddress() const { return fBuffer; }
+
+        virtual bool WriteNamedUniform( const char * uniformName, const void * data, unsigned int size );
+
+        // Decode all buffered commands, writing them to the stream if any.
+        virtual Real Execute( bool measureGPU );
+
+    private:
+        virtual void InitializeFBO();
+        virtual void InitializeCachedParams();
+        virtual void CacheQueryParam( CommandBuffer::QueryableParams param );
+
+    private:
+        template <typename T>
+        T Read();
+
+		template <typename T>
+		void Write(T);
+
+		// Uniforms changed since the previous draw
+		void ApplyUniforms();
+
+        U8 * Reserve( U32 size );
+
+		Uniform* fUniforms[Uniform::kNumBuiltInVariables];
+		U32 fUniformTimestamps[Uniform::kNumBuiltInVariables];
+		U32 fAppliedTimestamps[Uniform::kNumBuiltInVariables];
+
+        LightPtrArray< const CoronaCommand > fCustomCommands;
+
+		FILE* fStream;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_NullCommandBuffer_H__
@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Renderer/Rtt_NullRenderer.h"
+
+#include "Renderer/Rtt_NullCommandBuffer.h"
+#include "Renderer/Rtt_GPUResource.h"
+#include "Renderer/Rtt_CPUResource.h"
+#include "Core/Rtt_Assert.h"
+#include "Core/Rtt_FileSystem.h"
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+	// Resources are numbered from 1 as they are created, and the number is
+	// stored as the handle. NullCommandBuffer prints these numbers.
+	static U32 gNextResourceId = 1;
+
+	class NullGPUResource : public GPUResource
+	{
+		public:
+			virtual void Create( CPUResource* resource ) { fHandle = (Handle)(uintptr_t)gNextResourceId++; }
+			virtual void Update( CPUResource* resource ) {}
+			virtual void Destroy() { fHandle = NULL; }
+	};
+}
+
+// ----------------------------------------------------------------------------
+
+NullRenderer::NullRenderer( Rtt_Allocator* allocator, const char* streamPath )
+:   Super( allocator ),
+	fStream( NULL )
+{
+	if ( streamPath )
+	{
+		fStream = Rtt_FileOpen( streamPath, "w" );
+		if ( ! fStream )
+		{
+			Rtt_LogException( "WARNING: Cannot write the command stream to %s\n", streamPath );
+		}
+	}
+
+	fFrontCommandBuffer = Rtt_NEW( allocator, NullCommandBuffer( allocator, fStream ) );
+	fBackCommandBuffer = Rtt_NEW( allocator, NullCommandBuffer( allocator, fStream ) );
+}
+
+NullRenderer::~NullRenderer()
+{
+	if ( fStream )
+	{
+		Rtt_FileClose( fStream );
+	}
+}
+
+GPUResource*
+NullRenderer::Create( const CPUResource* resource )
+{
+	switch( resource->GetType() )
+	{
+		case CPUResource::kFrameBufferObject:
+		case CPUResource::kGeometry:
+		case CPUResource::kProgram:
+		case CPUResource::kTexture: return new NullGPUResource;
+		case CPUResource::kUniform: return NULL;
+		default: Rtt_ASSERT_NOT_REACHED(); return NULL;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
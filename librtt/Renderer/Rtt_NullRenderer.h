@@ -0,0 +1,59 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_NullRenderer_H__
+#define _Rtt_NullRenderer_H__
+
+#include "Renderer/Rtt_Renderer.h"
+
+#include <stdio.h>
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+
+namespace Rtt
+{
+
+class GPUResource;
+class CPUResource;
+
+// ----------------------------------------------------------------------------
+
+// Renderer that goes through scene traversal, batching and command buffer
+// generation as usual, but never talks to a GPU. This isolates the CPU side
+// of the pipeline for measurement. Optionally, every executed frame is
+// written to a text file, one command per line, for diffing batching
+// behavior between builds.
+class NullRenderer : public Renderer
+{
+	public:
+		typedef Renderer Super;
+		typedef NullRenderer Self;
+
+	public:
+		// If streamPath is not NULL, the command stream is written to it.
+		NullRenderer( Rtt_Allocator* allocator, const char* streamPath = NULL );
+		virtual ~NullRenderer();
+
+	protected:
+		// Create a placeholder resource for the given CPUResource.
+		virtual GPUResource* Create( const CPUResource* resource );
+
+	private:
+		FILE* fStream;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_NullRenderer_H__
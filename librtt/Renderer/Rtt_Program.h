@@ -74,6 +74,7 @@ class Program : public CPUResource
 		void SetHeaderSource( const char *source );
 
 		ShaderResource *GetShaderResource() { return fResource; }
+		const ShaderResource *GetShaderResource() const { return fResource; }
 		void SetShaderResource( ShaderResource *resource ) { fResource = resource; }
 
 		int GetVertexShellNumLines() const { return fVertexShellNumLines; }
@@ -85,6 +86,21 @@ class Program : public CPUResource
 		bool IsCompilerVerbose() const { return fCompilerVerbose; }
 		void SetCompilerVerbose( bool newValue ) { fCompilerVerbose = newValue; }
 
+		// Bitmask of versions to compile when the GPU resource is created,
+		// rather than on first use.
+		U32 GetPrewarmVersions() const { return fPrewarmVersions; }
+		void AddPrewarmVersions( U32 versionMask ) { fPrewarmVersions |= versionMask; }
+
+		// Returns true the first time the given version is bound.
+		bool MarkVersionUsed( Version version )
+		{
+			U8 bit = (U8)( 1 << version );
+			bool result = ! ( fUsedVersions & bit );
+			fUsedVersions |= bit;
+			return result;
+		}
+		U32 GetUsedVersions() const { return fUsedVersions; }
+
 
 	private:
 		char *fVertexShaderSource;
@@ -95,6 +111,8 @@ class Program : public CPUResource
 		int fFragmentShellNumLines;
 		ShaderResource *fResource;
 		bool fCompilerVerbose;
+		U8 fPrewarmVersions;
+		U8 fUsedVersions;
 };
 
 // ----------------------------------------------------------------------------
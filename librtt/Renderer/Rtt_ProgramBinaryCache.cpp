@@ -0,0 +1,174 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Renderer/Rtt_ProgramBinaryCache.h"
+
+#include "Core/Rtt_FileSystem.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+	const char kSubdirectory[] = "shaderCache";
+
+#if defined( Rtt_WIN_ENV )
+	const char kDirSeparator = '\\';
+#else
+	const char kDirSeparator = '/';
+#endif
+
+	std::string sDirectory;
+
+	void PathForKey( U64 key, const char *extension, std::string& path )
+	{
+		char name[Rtt::ProgramBinaryCache::kNameLength + 1];
+		snprintf( name, sizeof( name ), "%016llx", (unsigned long long)key );
+
+		path = sDirectory;
+		path += name;
+		path += '.';
+		path += extension;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+void
+ProgramBinaryCache::SetDirectory( const char *cachesDir )
+{
+	sDirectory.clear();
+
+	if ( cachesDir && '\0' != *cachesDir )
+	{
+		std::string path( cachesDir );
+		path += kDirSeparator;
+		path += kSubdirectory;
+
+		if ( Rtt_IsDirectory( path.c_str() ) || Rtt_MakeDirectory( path.c_str() ) )
+		{
+			sDirectory = path + kDirSeparator;
+		}
+		else
+		{
+			Rtt_TRACE( ( "WARNING: Could not create the shader cache directory (%s)\n", path.c_str() ) );
+		}
+	}
+}
+
+bool
+ProgramBinaryCache::IsEnabled()
+{
+	return ! sDirectory.empty();
+}
+
+U64
+ProgramBinaryCache::Hash( const void *data, size_t length, U64 hash )
+{
+	const U8 *bytes = static_cast< const U8 * >( data );
+
+	for ( size_t i = 0; i < length; i++ )
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+U64
+ProgramBinaryCache::Hash( const char *str, U64 hash )
+{
+	return str ? Hash( str, strlen( str ) + 1, hash ) : hash; // include the terminator, to separate inputs
+}
+
+bool
+ProgramBinaryCache::Read( U64 key, const char *extension, std::vector< U8 >& outData )
+{
+	bool result = false;
+
+	if ( IsEnabled() )
+	{
+		std::string path;
+		PathForKey( key, extension, path );
+
+		FILE *f = Rtt_FileOpen( path.c_str(), "rb" );
+		if ( f )
+		{
+			if ( 0 == Rtt_FileSeek( f, 0, SEEK_END ) )
+			{
+				long length = Rtt_FileTell( f );
+				Rtt_FileRewind( f );
+
+				if ( length > 0 )
+				{
+					outData.resize( length );
+					result = ( (size_t)length == Rtt_FileRead( outData.data(), 1, length, f ) );
+				}
+			}
+
+			Rtt_FileClose( f );
+		}
+	}
+
+	return result;
+}
+
+bool
+ProgramBinaryCache::Write( U64 key, const char *extension, const void *data, size_t length )
+{
+	bool result = false;
+
+	if ( IsEnabled() && data && length > 0 )
+	{
+		std::string path;
+		PathForKey( key, extension, path );
+
+		// Write to a temporary file first, so an interrupted write never
+		// leaves a truncated entry behind
+		std::string tmpPath( path );
+		tmpPath += ".tmp";
+
+		FILE *f = Rtt_FileOpen( tmpPath.c_str(), "wb" );
+		if ( f )
+		{
+			result = ( length == fwrite( data, 1, length, f ) );
+			result = ( 0 == Rtt_FileClose( f ) ) && result;
+
+			if ( result )
+			{
+				Rtt_DeleteFile( path.c_str() );
+				result = ( 0 == rename( tmpPath.c_str(), path.c_str() ) );
+			}
+
+			if ( ! result )
+			{
+				Rtt_DeleteFile( tmpPath.c_str() );
+			}
+		}
+	}
+
+	return result;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,61 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_ProgramBinaryCache_H__
+#define _Rtt_ProgramBinaryCache_H__
+
+#include "Core/Rtt_Types.h"
+
+#include <stddef.h>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Persists compiled programs (or pipeline caches) between launches, so that
+// effects do not have to be compiled from source again on first use. Entries
+// are plain files in a subdirectory of the caches directory; callers name
+// them by hashing the final source together with the driver identification,
+// which makes stale entries simply go unused after a driver update.
+class ProgramBinaryCache
+{
+	public:
+		enum
+		{
+			kNameLength = 16 // hex digits of a 64-bit key
+		};
+
+	public:
+		// Caching is disabled until a directory is given.
+		static void SetDirectory( const char *cachesDir );
+		static bool IsEnabled();
+
+		// 64-bit FNV-1a. Pass a previous result as 'hash' to combine inputs.
+		static U64 Hash( const void *data, size_t length, U64 hash = kHashSeed );
+		static U64 Hash( const char *str, U64 hash = kHashSeed );
+
+		// Read or replace the entry stored under the given key.
+		static bool Read( U64 key, const char *extension, std::vector< U8 >& outData );
+		static bool Write( U64 key, const char *extension, const void *data, size_t length );
+
+	private:
+		static const U64 kHashSeed = 14695981039346656037ULL;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_ProgramBinaryCache_H__
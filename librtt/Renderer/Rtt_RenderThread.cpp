@@ -0,0 +1,186 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Renderer/Rtt_RenderThread.h"
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+RenderThread::RenderThread()
+:	fThread(),
+	fMutex(),
+	fCondition(),
+	fJobs(),
+	fSynchronousCount( 0 ),
+	fIsRunning( false ),
+	fShouldStop( false )
+{
+}
+
+RenderThread::~RenderThread()
+{
+	// Subclasses are gone by now, so they must have stopped the thread
+	Rtt_ASSERT( ! fIsRunning );
+}
+
+void
+RenderThread::Start()
+{
+	Rtt_ASSERT( ! fIsRunning );
+
+	ReleaseCurrent();
+
+	fShouldStop = false;
+	fIsRunning = true;
+	fThread = std::thread( &RenderThread::Loop, this );
+}
+
+void
+RenderThread::Stop()
+{
+	if ( ! fIsRunning )
+	{
+		return;
+	}
+
+	Rtt_ASSERT( 0 == fSynchronousCount );
+
+	{
+		std::lock_guard< std::mutex > lock( fMutex );
+		fShouldStop = true;
+	}
+	fCondition.notify_all();
+
+	fThread.join();
+	fIsRunning = false;
+
+	MakeCurrent();
+}
+
+void
+RenderThread::Post( const Job& job )
+{
+	if ( ! fIsRunning || fSynchronousCount > 0 )
+	{
+		job();
+		return;
+	}
+
+	{
+		std::lock_guard< std::mutex > lock( fMutex );
+		fJobs.push_back( job );
+	}
+	fCondition.notify_all();
+}
+
+void
+RenderThread::Run( const Job& job )
+{
+	if ( ! fIsRunning || fSynchronousCount > 0 )
+	{
+		job();
+		return;
+	}
+
+	bool isDone = false;
+
+	Post( [this, &job, &isDone]()
+	{
+		job();
+
+		std::lock_guard< std::mutex > lock( fMutex );
+		isDone = true;
+	} );
+
+	std::unique_lock< std::mutex > lock( fMutex );
+	fCondition.wait( lock, [&isDone]() { return isDone; } );
+}
+
+void
+RenderThread::BeginSynchronous()
+{
+	if ( fIsRunning && 0 == fSynchronousCount++ )
+	{
+		Run( [this]() { ReleaseCurrent(); } );
+		MakeCurrent();
+	}
+}
+
+void
+RenderThread::EndSynchronous()
+{
+	if ( fIsRunning && 0 == --fSynchronousCount )
+	{
+		ReleaseCurrent();
+		Post( [this]() { MakeCurrent(); } );
+	}
+}
+
+void
+RenderThread::Loop()
+{
+	MakeCurrent();
+
+	for ( ;; )
+	{
+		Job job;
+
+		{
+			std::unique_lock< std::mutex > lock( fMutex );
+			fCondition.wait( lock, [this]() { return fShouldStop || ! fJobs.empty(); } );
+
+			// Stopping still drains the queue
+			if ( fJobs.empty() )
+			{
+				break;
+			}
+
+			job = fJobs.front();
+			fJobs.pop_front();
+		}
+
+		job();
+
+		// Run() waits on the same condition
+		fCondition.notify_all();
+	}
+
+	ReleaseCurrent();
+}
+
+// ----------------------------------------------------------------------------
+
+RenderThreadLock::RenderThreadLock( RenderThread* thread )
+:	fThread( thread )
+{
+	if ( fThread )
+	{
+		fThread->BeginSynchronous();
+	}
+}
+
+RenderThreadLock::~RenderThreadLock()
+{
+	if ( fThread )
+	{
+		fThread->EndSynchronous();
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_RenderThread_H__
+#define _Rtt_RenderThread_H__
+
+#include "Core/Rtt_Macros.h"
+#include "Core/Rtt_Types.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Owns the rendering context on a thread of its own, and runs jobs on it in
+// the order they were submitted. The Scene uses it to Swap() synchronously and
+// then Render() the front CommandBuffer in the background, while Lua and the
+// Scene prepare the next frame into the back CommandBuffer.
+//
+// Subclasses make the platform's context current, or release it, on
+// whichever thread calls them.
+class RenderThread
+{
+	Rtt_CLASS_NO_COPIES( RenderThread )
+
+	public:
+		typedef std::function< void () > Job;
+
+	public:
+		RenderThread();
+		virtual ~RenderThread();
+
+	public:
+		// The context must be current on the calling thread, which gives it up.
+		void Start();
+
+		// Finishes all jobs. The context is current on the calling thread again.
+		void Stop();
+
+		bool IsRunning() const { return fIsRunning; }
+
+		// Queues a job behind everything submitted so far.
+		void Post( const Job& job );
+
+		// Same, but returns once the job has run.
+		void Run( const Job& job );
+
+		// Finishes all jobs and moves the context to the calling thread, e.g.
+		// for captures, until the matching EndSynchronous(). Jobs submitted
+		// in between run right away on the calling thread.
+		void BeginSynchronous();
+		void EndSynchronous();
+
+	protected:
+		virtual void MakeCurrent() = 0;
+		virtual void ReleaseCurrent() = 0;
+
+	private:
+		void Loop();
+
+	private:
+		std::thread fThread;
+		std::mutex fMutex;
+		std::condition_variable fCondition;
+		std::deque< Job > fJobs;
+		U32 fSynchronousCount;
+		bool fIsRunning;
+		bool fShouldStop;
+};
+
+// Scoped BeginSynchronous() / EndSynchronous(); does nothing without a thread.
+class RenderThreadLock
+{
+	Rtt_CLASS_NO_COPIES( RenderThreadLock )
+
+	public:
+		RenderThreadLock( RenderThread* thread );
+		~RenderThreadLock();
+
+	private:
+		RenderThread* fThread;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_RenderThread_H__
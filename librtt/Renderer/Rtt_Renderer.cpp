@@ -10,6 +10,7 @@
 #include "Renderer/Rtt_Renderer.h"
 
 #include "Renderer/Rtt_CommandBuffer.h"
+#include "Renderer/Rtt_CommandCapture.h"
 #include "Renderer/Rtt_FrameBufferObject.h"
 #include "Renderer/Rtt_FormatExtensionList.h"
 #include "Renderer/Rtt_Geometry_Renderer.h"
@@ -20,6 +21,7 @@
 #include "Renderer/Rtt_Program.h"
 #include "Renderer/Rtt_RenderData.h"
 #include "Renderer/Rtt_CPUResource.h"
+#include "Renderer/Rtt_StaticBatch.h"
 #include "Renderer/Rtt_Texture.h"
 #include "Renderer/Rtt_Uniform.h"
 #include "Core/Rtt_Allocator.h"
@@ -27,6 +29,7 @@
 #include "Core/Rtt_Math.h"
 #include "Core/Rtt_Types.h"
 #include "Renderer/Rtt_MCPUResourceObserver.h"
+#include "Renderer/Rtt_MProgramUsageObserver.h"
 #include "Display/Rtt_ObjectHandle.h"
 #include "Display/Rtt_ShaderData.h"
 #include "Display/Rtt_ShaderResource.h"
@@ -135,8 +138,10 @@ Renderer::Renderer( Rtt_Allocator* allocator )
 :	 fAllocator( allocator ),
 	fCreateQueue( allocator ),
 	fUpdateQueue( allocator ),
+	fPrewarmQueue( allocator ),
 	fDestroyQueue( allocator ),
 	fCPUResourceObserver(NULL),
+	fProgramUsageObserver( NULL ),
 	fGeometryPool( Rtt_NEW( fAllocator, GeometryPool( fAllocator ) ) ),
     fInstancingGeometryPool( Rtt_NEW( fAllocator, GeometryPool( fAllocator ) ) ),
 	fFrontCommandBuffer( NULL ),
@@ -161,13 +166,19 @@ Renderer::Renderer( Rtt_Allocator* allocator )
 	fMaskCount( allocator ),
 	fCurrentProgramMaskCount( 0 ),
 	fStatisticsEnabled( false ),
+	fLastRenderTimeGPU( Rtt_REAL_0 ),
+	fLastRenderTimeCPU( Rtt_REAL_0 ),
 	fScissorEnabled( false ),
 	fFrameBufferObject( NULL ),
     fInsertionLimit( (std::numeric_limits<U32>::max)() ),
     fRenderDataCount( 0 ),
 	fVertexOffset( 0 ),
 	fCurrentGeometry( NULL ),
-	fTimeDependencyCount( 0 )
+	fTimeDependencyCount( 0 ),
+	fStaticBatch( NULL ),
+	fStaticBatchFailed( false ),
+	fCapturePath(),
+	fCapture( NULL )
 {
     // Always have at least 1 mask count.
     fMaskCount.Append( 0 );
@@ -179,6 +190,12 @@ Renderer::~Renderer()
     Rtt_DELETE( fInstancingGeometryPool );
 
     DestroyQueuedGPUResources();
+
+    if ( fCapture )
+    {
+        fBackCommandBuffer = fCapture->GetTarget();
+        Rtt_DELETE( fCapture );
+    }
     
     Rtt_DELETE( fBackCommandBuffer );
     Rtt_DELETE( fFrontCommandBuffer );
@@ -211,6 +228,13 @@ Renderer::BeginFrame( Real totalTime, Real deltaTime, const TimeTransform *defTi
 
     // NOTE: No nested calls allowed
 
+    // Display captures render into a texture, so leave them out
+    if ( ! fCapturePath.empty() && ! isCapture )
+    {
+        fCapture = Rtt_NEW( fAllocator, CaptureCommandBuffer( fAllocator, fBackCommandBuffer ) );
+        fBackCommandBuffer = fCapture;
+    }
+
     fPrevious = RenderData();
     fVertexOffset = 0;
     fVertexCount = 0;
@@ -265,10 +289,33 @@ Renderer::EndFrame()
     RestoreDefaultBlocks();
 
     fStatistics.fPreparationTime = STOP_TIMING(fStartTime);
+
+    if ( fCapture )
+    {
+        if ( fCapture->Save( fCapturePath.c_str() ) )
+        {
+            Rtt_Log( "Captured the command stream to %s\n", fCapturePath.c_str() );
+        }
+        else
+        {
+            Rtt_LogException( "WARNING: Cannot write the command stream to %s\n", fCapturePath.c_str() );
+        }
+
+        fBackCommandBuffer = fCapture->GetTarget();
+        Rtt_DELETE( fCapture );
+        fCapture = NULL;
+        fCapturePath.clear();
+    }
     
     DEBUG_PRINT( "--End Frame: Renderer--\n\n" );
 }
 
+void
+Renderer::CaptureNextFrame( const char* path )
+{
+    fCapturePath = path ? path : "";
+}
+
 
 void
 Renderer::BeginDrawing()
@@ -304,6 +351,7 @@ Renderer::SetFrustum( const Real* viewMatrix, const Real* projMatrix )
     memcpy( fViewMatrix, viewMatrix, ELEMENTS_PER_MAT4 * sizeof( Real ) );
     memcpy( fProjMatrix, projMatrix, ELEMENTS_PER_MAT4 * sizeof( Real ) );
 
+    AbandonStaticBatch();
     CheckAndInsertDrawCommand();
     Real* data = reinterpret_cast<Real*>( fViewProjectionMatrix->GetData() );
     Multiply4x4( projMatrix, viewMatrix, data );
@@ -330,6 +378,7 @@ Renderer::SetViewport( S32 x, S32 y, S32 width, S32 height )
     fViewport[2] = width;
     fViewport[3] = height;
 
+    AbandonStaticBatch();
     CheckAndInsertDrawCommand();
     fBackCommandBuffer->SetViewport( x, y, width, height );
     
@@ -370,10 +419,11 @@ Renderer::SetScissor( S32 x, S32 y, S32 width, S32 height )
 
     CheckAndInsertDrawCommand();
 
-    S32 x0 = static_cast<S32>( windowCoord0[0] );
-    S32 y0 = static_cast<S32>( windowCoord0[1] );
-    S32 x1 = static_cast<S32>( windowCoord1[0] );
-    S32 y1 = static_cast<S32>( windowCoord1[1] );
+    // Window coordinates are relative to the viewport's origin
+    S32 x0 = fViewport[0] + static_cast<S32>( windowCoord0[0] );
+    S32 y0 = fViewport[1] + static_cast<S32>( windowCoord0[1] );
+    S32 x1 = fViewport[0] + static_cast<S32>( windowCoord1[0] );
+    S32 y1 = fViewport[1] + static_cast<S32>( windowCoord1[1] );
     fBackCommandBuffer->SetScissorRegion( x0, Min( y0, y1 ), x1 - x0, abs( y1 - y0 ) );
     
     DEBUG_PRINT( "Set scissor window: x=%i, y=%i, width=%i, height=%i\n", x, y, width, height );
@@ -406,8 +456,16 @@ Renderer::SetFrameBufferObject( FrameBufferObject* fbo )
 {
     fFrameBufferObject = fbo;
 
+    AbandonStaticBatch();
     FlushBatch();
 
+    // The scissor region is in window coordinates, so it must not clip
+    // offscreen passes, e.g. snapshots and multi-pass filters.
+    if ( fScissorEnabled )
+    {
+        fBackCommandBuffer->SetScissorEnabled( NULL == fbo );
+    }
+
     if( fbo )
     {
         Texture* texture = fbo->GetTexture();
@@ -429,6 +487,7 @@ Renderer::SetFrameBufferObject( FrameBufferObject* fbo )
 void
 Renderer::Clear( Real r, Real g, Real b, Real a, const ExtraClearOptions * extraOptions ) 
 {
+    AbandonStaticBatch();
     CheckAndInsertDrawCommand();
 
     if (extraOptions && extraOptions->clearDepth)
@@ -453,6 +512,7 @@ Renderer::Clear( Real r, Real g, Real b, Real a, const ExtraClearOptions * extra
 void
 Renderer::PushMask( Texture* maskTexture, Uniform* maskMatrix )
 {
+    AbandonStaticBatch();
     CheckAndInsertDrawCommand();
     
     ++MaskCount();
@@ -511,6 +571,7 @@ Renderer::Insert( const RenderData* data, const ShaderData * shaderData )
     // For debug visualization, the number of insertions may be limited
     if( fInsertionCount++ > fInsertionLimit )
     {
+        AbandonStaticBatch();
         return;
     }
     
@@ -567,6 +628,12 @@ Renderer::Insert( const RenderData* data, const ShaderData * shaderData )
     bool isInstanced = Geometry::UsesInstancing( block, extensionList );
 	bool mustReconcileFormats = formatsDirty;
 
+    if ( fStaticBatch )
+    {
+        bool isExtended = isInstanced || extensionList || programList || dirtyIndices.Length() > 0;
+        RecordStaticBatch( data, shaderData, isExtended );
+    }
+
     // Geometry that is stored on the GPU does not need to be copied
     // over each frame. As a consequence, they can not be batched.
     U32 previousVerticesUsed = 0;
@@ -814,6 +881,11 @@ Renderer::Insert( const RenderData* data, const ShaderData * shaderData )
 
         Program::Version version = static_cast<Program::Version>( MaskCount() );
         fBackCommandBuffer->BindProgram( data->fProgram, version );
+
+        if ( fProgramUsageObserver && data->fProgram->MarkVersionUsed( version ) )
+        {
+            fProgramUsageObserver->DidUseProgram( * data->fProgram, version );
+        }
         fPrevious.fProgram = data->fProgram;
         INCREMENT( fStatistics.fProgramBindCount );
         fCurrentProgramMaskCount = MaskCount();
@@ -910,8 +982,8 @@ void
 Renderer::Render()
 {
     Rtt_AbsoluteTime start = START_TIMING();
-    fStatistics.fRenderTimeGPU = fFrontCommandBuffer->Execute( fStatisticsEnabled );
-    fStatistics.fRenderTimeCPU = STOP_TIMING(start);
+    fLastRenderTimeGPU = fFrontCommandBuffer->Execute( fStatisticsEnabled );
+    fLastRenderTimeCPU = STOP_TIMING(start);
 }
 
 void
@@ -921,13 +993,8 @@ Renderer::Swap()
 
     // Create GPUResources
     Rtt_AbsoluteTime start = START_TIMING();
-    for(S32 i = 0; i < fCreateQueue.Length(); ++i)
-    {
-        CPUResource* data = fCreateQueue[i];
-        GPUResource* gpuResource = data->GetGPUResource();
-        gpuResource->Create( data );
-    }
-    fCreateQueue.Remove(0, fCreateQueue.Length(), false);
+    CreateQueuedGPUResources();
+    PrewarmQueuedPrograms();
     fStatistics.fResourceCreateTime = STOP_TIMING(start);
 
     // Update GPUResources
@@ -947,6 +1014,10 @@ Renderer::Swap()
     DestroyQueuedGPUResources();
     fStatistics.fResourceDestroyTime = STOP_TIMING(start);
 
+    // The previous Render() is done by now, and preparation is waiting on us
+    fStatistics.fRenderTimeGPU = fLastRenderTimeGPU;
+    fStatistics.fRenderTimeCPU = fLastRenderTimeCPU;
+
     CommandBuffer* temp = fFrontCommandBuffer;
     fFrontCommandBuffer = fBackCommandBuffer;
     fBackCommandBuffer = temp;
@@ -980,6 +1051,73 @@ Renderer::QueueCreate( CPUResource* resource )
     }
 }
 
+void
+Renderer::CreateQueuedGPUResources()
+{
+    for(S32 i = 0; i < fCreateQueue.Length(); ++i)
+    {
+        CPUResource* data = fCreateQueue[i];
+        GPUResource* gpuResource = data->GetGPUResource();
+        gpuResource->Create( data );
+    }
+    fCreateQueue.Remove(0, fCreateQueue.Length(), false);
+}
+
+bool
+Renderer::QueuePrewarm( Program* program, U32 versionMask )
+{
+    U32 missing = versionMask & ~( program->GetPrewarmVersions() | program->GetUsedVersions() );
+
+    if ( program->GetGPUResource() && ! missing )
+    {
+        return false;
+    }
+
+    program->AddPrewarmVersions( versionMask );
+
+    if ( ! program->GetGPUResource() )
+    {
+        QueueCreate( program );
+    }
+
+    fPrewarmQueue.Append( program );
+
+    return true;
+}
+
+void
+Renderer::PrewarmQueuedPrograms()
+{
+    for(S32 i = 0; i < fPrewarmQueue.Length(); ++i)
+    {
+        CPUResource* data = fPrewarmQueue[i];
+        GPUResource* gpuResource = data->GetGPUResource();
+
+        if ( ! gpuResource )
+        {
+            continue; // evicted since
+        }
+
+        // A newly created program compiles its pre-warmed versions in Create()
+        S32 index = fCreateQueue.Length() - 1;
+        while ( index >= 0 && fCreateQueue[index] != data )
+        {
+            --index;
+        }
+
+        if ( index >= 0 )
+        {
+            fCreateQueue.Remove( index, 1, false );
+            gpuResource->Create( data );
+        }
+        else
+        {
+            gpuResource->Prewarm( data );
+        }
+    }
+    fPrewarmQueue.Remove(0, fPrewarmQueue.Length(), false);
+}
+
 void
 Renderer::SetCPUResourceObserver(MCPUResourceObserver *resourceObserver)
 {
@@ -1005,9 +1143,123 @@ Renderer::TallyTimeDependency( bool usesTime )
 	if ( usesTime )
 	{
 		++fTimeDependencyCount;
+
+		if ( fStaticBatch )
+		{
+			fStaticBatch->SetUsesTime();
+		}
 	}
 }
 
+void
+Renderer::BeginStaticBatch( StaticBatch* batch )
+{
+    Rtt_ASSERT( batch );
+    Rtt_ASSERT( NULL == fStaticBatch );
+
+    fStaticBatch = batch;
+    fStaticBatchFailed = false;
+    batch->Begin();
+}
+
+bool
+Renderer::EndStaticBatch()
+{
+    Rtt_ASSERT( fStaticBatch );
+
+    bool result = ! fStaticBatchFailed;
+    fStaticBatch->End( result );
+    result = result && fStaticBatch->IsBaked();
+
+    fStaticBatch = NULL;
+    fStaticBatchFailed = false;
+
+    return result;
+}
+
+void
+Renderer::RecordStaticBatch( const RenderData* data, const ShaderData * shaderData, bool isExtended )
+{
+    if ( fStaticBatchFailed )
+    {
+        return;
+    }
+
+    Geometry* geometry = data->fGeometry;
+    const CoronaEffectCallbacks * effectCallbacks = data->fProgram->GetShaderResource()->GetEffectCallbacks();
+
+    // Only plain vertex data can be flattened. Effect callbacks may bind
+    // state of their own, and captures read back what is drawn before them.
+    if ( isExtended
+        || geometry->GetStoredOnGPU()
+        || effectCallbacks
+        || fCaptureGroups.Length() > 0 )
+    {
+        AbandonStaticBatch();
+        return;
+    }
+
+    const U32 verticesUsed = geometry->GetVerticesUsed();
+    const Geometry::Index* indices = NULL;
+    U32 triangleCount = 0;
+
+    Geometry::PrimitiveType primitiveType = geometry->GetPrimitiveType();
+    switch( primitiveType )
+    {
+        case Geometry::kTriangleStrip:
+        case Geometry::kTriangleFan:
+            triangleCount = verticesUsed > 2 ? verticesUsed - 2 : 0;
+            break;
+        case Geometry::kTriangles:
+            triangleCount = verticesUsed / 3;
+            break;
+        case Geometry::kIndexedTriangles:
+            triangleCount = geometry->GetIndicesUsed() / 3;
+            indices = geometry->GetIndexData();
+            break;
+        default:
+            // Lines are not flattened into the triangle list
+            AbandonStaticBatch();
+            return;
+    }
+
+    if ( 0 == triangleCount )
+    {
+        return;
+    }
+
+    // Every run is a plain triangle list, so strips and fans are unrolled.
+    // The geometry writers are honored, as they would be when batching.
+    const U32 vertexSize = sizeof( Geometry::Vertex );
+    const Geometry::Vertex* vertices = geometry->GetVertexData();
+    Geometry::Vertex* destination = fStaticBatch->Reserve( * data, 3 * triangleCount );
+
+    for ( U32 i = 0; i < triangleCount; i++ )
+    {
+        for ( U32 j = 0; j < 3; j++ )
+        {
+            U32 index;
+            switch( primitiveType )
+            {
+                case Geometry::kTriangleStrip:
+                    index = i + j;
+                    break;
+                case Geometry::kTriangleFan:
+                    index = ( 0 == j ? 0 : i + j );
+                    break;
+                case Geometry::kIndexedTriangles:
+                    index = indices[3 * i + j];
+                    break;
+                default:
+                    index = 3 * i + j;
+                    break;
+            }
+
+            WriteGeometry( destination++, vertices, vertexSize, index );
+        }
+    }
+}
+
 U16
 Renderer::AddCustomCommand( const CoronaCommand & command )
 {
@@ -1030,6 +1282,8 @@ Renderer::IssueCustomCommand( U16 id, const void * data, U32 size )
 {
     if ( id < (U16)fCustomInfo->fCommands.Length() )
     {
+        AbandonStaticBatch();
+
         fBackCommandBuffer->IssueCommand( id, data, size );
 
         return true;
@@ -1043,6 +1297,8 @@ Renderer::InsertCaptureRect( FrameBufferObject * fbo, Texture * texture, const R
 {
 	RectPair pair = {};
 	
+	AbandonStaticBatch();
+
 	pair.fClipped = clipped;
 	pair.fUnclipped = unclipped;
 	
@@ -1145,6 +1401,11 @@ Renderer::GetStateBlockInfo( U16 id, U8 *& start, U32 & size, bool mightDirty )
         size = info->fSize;
 
         fMaybeDirty = mightDirty && size > 0;
+
+        if ( fMaybeDirty )
+        {
+            AbandonStaticBatch();
+        }
         
         return true;
     }
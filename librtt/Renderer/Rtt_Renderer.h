@@ -22,6 +22,8 @@
 #include "Core/Rtt_Real.h"
 #include "Core/Rtt_Time.h"
 
+#include <string>
+
 // ----------------------------------------------------------------------------
 
 struct Rtt_Allocator;
@@ -31,14 +33,18 @@ struct CoronaStateBlock;
 namespace Rtt
 {
 
+class CaptureCommandBuffer;
 class CommandBuffer;
 class FrameBufferObject;
 class GeometryPool;
+class Program;
 class Texture;
 class Uniform;
 class RenderingStream;
 class BufferBitmap;
 class ShaderData;
+class StaticBatch;
+class MProgramUsageObserver;
 struct CustomGraphicsInfo;
 struct TimeTransform;
 
@@ -46,6 +52,8 @@ struct TimeTransform;
 
 class Renderer
 {
+    friend class CommandReplay;
+
     public:
         typedef Renderer Self;
 
@@ -66,6 +74,11 @@ class Renderer
         // Perform any per-frame finalization.
         virtual void EndFrame();
 
+        // Record the commands of the next frame, along with the resources
+        // they use, and write them to the given file when that frame ends.
+        // See CaptureCommandBuffer.
+        void CaptureNextFrame( const char* path );
+
         void BeginDrawing();
 
         virtual void CaptureFrameBuffer( RenderingStream & stream, BufferBitmap & bitmap, S32 x_in_pixels, S32 y_in_pixels, S32 w_in_pixels, S32 h_in_pixels );
@@ -143,6 +156,15 @@ class Renderer
         // RenderData is properly drawn on the next call to Render().
         void Insert( const RenderData* data, const ShaderData * shaderData = NULL );
 
+        // Record everything inserted until EndStaticBatch() into the given
+        // batch, in addition to drawing it as usual. Recording is abandoned
+        // if anything is encountered that cannot be replayed from a retained
+        // vertex buffer, e.g. offscreen passes, group masks, custom commands
+        // or effects with callbacks. Returns true if the batch was baked.
+        void BeginStaticBatch( StaticBatch* batch );
+        bool EndStaticBatch();
+        bool IsRecordingStaticBatch() const { return NULL != fStaticBatch; }
+
         // Render all data added since the last call to swap(). It is both safe
         // and expected that Render() is called while another thread is adding
         // new RenderData and preparing it for the subsequent call to Render().
@@ -208,7 +230,8 @@ class Renderer
         void SetStatisticsEnabled( bool enabled );
 
         // Get the previous frame's statistics. For accurate results, do not
-        // call this function during preparation or rendering.
+        // call this function during preparation or rendering. The render times
+        // are those of the last Render() to finish before the Swap().
         const Statistics& GetFrameStatistics() const;
 
         // Get the maximum number of RenderData that may be inserted each frame.
@@ -222,6 +245,20 @@ class Renderer
         void SetCPUResourceObserver(MCPUResourceObserver *resourceObserver);
         void ReleaseGPUResources();
 
+        // Notified the first time each program version is bound. Not owned.
+        void SetProgramUsageObserver( MProgramUsageObserver *observer ) { fProgramUsageObserver = observer; }
+
+        // The given versions of the program will be compiled the next time a
+        // valid rendering context is available, whether or not its GPU
+        // resource exists yet. Returns false if they are all compiled or
+        // queued already.
+        bool QueuePrewarm( Program* program, U32 versionMask );
+
+        // Compiles the programs passed to QueuePrewarm() so far, instead of
+        // waiting for the next Swap(). Nothing else queued is created. The
+        // rendering context must be current.
+        void PrewarmQueuedPrograms();
+
         // When there is a GPU-dependency on time, e.g. the shader code,
         // we need to ensure re-blitting. These functions help tally each
         // time such a situation occurs.
@@ -262,6 +299,9 @@ class Renderer
         void WriteGeometry ( void * dstGeomComp, const void* srcGeom, U32 stride, U32 index, U32 count = 1, GeometryWriter::MaskBits validBits = GeometryWriter::kMain );
 
     protected:
+        // Creates all queued GPU resources passed into the QueueCreate() method.
+        void CreateQueuedGPUResources();
+
         // Destroys all queued GPU resources passed into the DestroyQueue() method.
         void DestroyQueuedGPUResources();
 
@@ -283,6 +323,8 @@ class Renderer
         void RestoreDefaultBlocks();
         void InsertInstancing( const Geometry::ExtensionBlock* block, const FormatExtensionList* programList, const FormatExtensionList* geometryList );
         void FlushBatch();
+        void RecordStaticBatch( const RenderData* data, const ShaderData * shaderData, bool isExtended );
+        void AbandonStaticBatch() { fStaticBatchFailed = true; }
     
     protected:
         void UpdateBatch( bool batch, bool enoughSpace, bool storedOnGPU, U32 verticesRequired );
@@ -316,9 +358,11 @@ class Renderer
 		Rtt_Allocator* fAllocator;
 		
 		MCPUResourceObserver *fCPUResourceObserver;
+		MProgramUsageObserver *fProgramUsageObserver;
 		
 		LightPtrArray<CPUResource> fCreateQueue;
 		LightPtrArray<CPUResource> fUpdateQueue;
+		LightPtrArray<CPUResource> fPrewarmQueue;
 		Array<GPUResource*> fDestroyQueue;
 
         GeometryPool* fGeometryPool;
@@ -341,6 +385,11 @@ class Renderer
         Statistics fStatistics;
         Rtt_AbsoluteTime fStartTime;
 
+        // Written by Render(), possibly on the render thread, and only copied
+        // into fStatistics by Swap(), once that Render() has finished.
+        Real fLastRenderTimeGPU;
+        Real fLastRenderTimeCPU;
+
         Real fViewMatrix[16];
         Real fProjMatrix[16];
         S32 fViewport[4];
@@ -368,6 +417,9 @@ class Renderer
         Real fContentScaleX; // Temporary holder.
 
         U32 fTimeDependencyCount;
+
+        StaticBatch* fStaticBatch;
+        bool fStaticBatchFailed;
     
         struct RectPair {
             Rect fClipped;
@@ -396,6 +448,9 @@ class Renderer
         Array< GeometryWriter > fGeometryWriters;
         const GeometryWriter* fCurrentGeometryWriterList; // to detect change in writer; assumed to be stable object, i.e. either NULL (default) or some static array
         bool fCanAddGeometryWriters;
+
+        std::string fCapturePath;
+        CaptureCommandBuffer* fCapture;
 };
 
 // ----------------------------------------------------------------------------
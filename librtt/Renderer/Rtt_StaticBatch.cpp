@@ -0,0 +1,203 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Renderer/Rtt_StaticBatch.h"
+
+#include "Renderer/Rtt_Renderer.h"
+#include "Core/Rtt_Allocator.h"
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+	// Smallest number of vertices allocated for a run
+	const U32 kMinimumRunVertexCount = 64;
+
+	// True if both RenderData result in the same bindings when inserted,
+	// i.e. everything but the Geometry matches.
+	bool HasSameState( const Rtt::RenderData& lhs, const Rtt::RenderData& rhs )
+	{
+		return lhs.fProgram == rhs.fProgram
+			&& lhs.fFillTexture0 == rhs.fFillTexture0
+			&& lhs.fFillTexture1 == rhs.fFillTexture1
+			&& lhs.fMaskTexture == rhs.fMaskTexture
+			&& lhs.fMaskUniform == rhs.fMaskUniform
+			&& lhs.fUserUniform0 == rhs.fUserUniform0
+			&& lhs.fUserUniform1 == rhs.fUserUniform1
+			&& lhs.fUserUniform2 == rhs.fUserUniform2
+			&& lhs.fUserUniform3 == rhs.fUserUniform3
+			&& lhs.fBlendMode == rhs.fBlendMode
+			&& lhs.fBlendEquation == rhs.fBlendEquation;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+StaticBatch::StaticBatch( Rtt_Allocator* allocator )
+:	fAllocator( allocator ),
+	fRuns( allocator ),
+	fState( kUnsettled ),
+	fUsesTime( false ),
+	fIsStale( false )
+{
+}
+
+StaticBatch::~StaticBatch()
+{
+	ReleaseRuns();
+}
+
+void
+StaticBatch::ReleaseRuns()
+{
+	for ( S32 i = 0, iMax = fRuns.Length(); i < iMax; i++ )
+	{
+		Rtt_DELETE( fRuns[i].fGeometry );
+	}
+
+	fRuns.Clear();
+	fUsesTime = false;
+}
+
+void
+StaticBatch::Invalidate()
+{
+	if ( kRecording == fState )
+	{
+		// Abandon the recording in progress once it ends
+		fIsStale = true;
+	}
+	else
+	{
+		ReleaseRuns();
+		fState = kUnsettled;
+	}
+}
+
+bool
+StaticBatch::WillDrawContents()
+{
+	bool result = false;
+
+	switch ( fState )
+	{
+		case kUnsettled:
+			fState = kSettled;
+			break;
+		case kSettled:
+			result = true;
+			break;
+		default:
+			break;
+	}
+
+	return result;
+}
+
+void
+StaticBatch::Draw( Renderer& renderer ) const
+{
+	Rtt_ASSERT( IsBaked() );
+
+	renderer.TallyTimeDependency( fUsesTime );
+
+	for ( S32 i = 0, iMax = fRuns.Length(); i < iMax; i++ )
+	{
+		renderer.Insert( & fRuns[i].fData );
+	}
+}
+
+void
+StaticBatch::Begin()
+{
+	Rtt_ASSERT( kSettled == fState );
+
+	ReleaseRuns();
+	fState = kRecording;
+	fIsStale = false;
+}
+
+Geometry::Vertex*
+StaticBatch::Reserve( const RenderData& data, U32 vertexCount )
+{
+	Rtt_ASSERT( kRecording == fState );
+
+	S32 last = fRuns.Length() - 1;
+
+	if ( last < 0 || ! HasSameState( fRuns[last].fData, data ) )
+	{
+		const U32 indexCount = 0;
+		const bool storeOnGPU = true;
+
+		Run run;
+		run.fData = data;
+		run.fGeometry = Rtt_NEW( fAllocator, Geometry( fAllocator, Geometry::kTriangles,
+			Max( kMinimumRunVertexCount, vertexCount ), indexCount, storeOnGPU ) );
+		run.fData.fGeometry = run.fGeometry;
+
+		fRuns.Append( run );
+		++last;
+	}
+
+	Geometry* geometry = fRuns[last].fGeometry;
+	const U32 verticesUsed = geometry->GetVerticesUsed();
+
+	if ( verticesUsed + vertexCount > geometry->GetVerticesAllocated() )
+	{
+		geometry->Resize( Max( verticesUsed + vertexCount, 2 * geometry->GetVerticesAllocated() ), true );
+	}
+
+	geometry->SetVerticesUsed( verticesUsed + vertexCount );
+
+	return geometry->GetVertexData() + verticesUsed;
+}
+
+void
+StaticBatch::End( bool succeeded )
+{
+	Rtt_ASSERT( kRecording == fState );
+
+	if ( fIsStale )
+	{
+		ReleaseRuns();
+		fState = kUnsettled;
+	}
+	else if ( succeeded && fRuns.Length() > 0 )
+	{
+		// Trim the slack so only what is drawn gets uploaded
+		for ( S32 i = 0, iMax = fRuns.Length(); i < iMax; i++ )
+		{
+			Geometry* geometry = fRuns[i].fGeometry;
+			if ( geometry->GetVerticesUsed() < geometry->GetVerticesAllocated() )
+			{
+				geometry->Resize( geometry->GetVerticesUsed(), true );
+			}
+		}
+
+		fState = kBaked;
+	}
+	else
+	{
+		ReleaseRuns();
+
+		// Nothing inserted is not worth retrying either
+		fState = kUnbakeable;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_StaticBatch_H__
+#define _Rtt_StaticBatch_H__
+
+#include "Core/Rtt_Config.h"
+#include "Core/Rtt_Macros.h" // TODO: Needed by Rtt_Math.h
+#include "Core/Rtt_Types.h"
+#include "Core/Rtt_Math.h" // TODO: Needed by Rtt_Array.h
+#include "Core/Rtt_Array.h"
+#include "Renderer/Rtt_Geometry_Renderer.h"
+#include "Renderer/Rtt_RenderData.h"
+
+// ----------------------------------------------------------------------------
+
+struct Rtt_Allocator;
+
+namespace Rtt
+{
+
+class Renderer;
+
+// ----------------------------------------------------------------------------
+
+// Retained copy of everything a subtree inserts into the Renderer. Consecutive
+// RenderData that share render state are flattened into a single triangle
+// list whose vertices are already in content space, and kept in Geometry that
+// is stored on the GPU. As long as nothing in the subtree changes, redrawing
+// it costs one draw call per run without any per-frame vertex copies.
+class StaticBatch
+{
+	Rtt_CLASS_NO_COPIES( StaticBatch )
+
+	public:
+		StaticBatch( Rtt_Allocator* allocator );
+		~StaticBatch();
+
+	public:
+		// Discard the baked data. The contents are only recorded again once
+		// they have been drawn for a full frame without changing.
+		void Invalidate();
+
+		// True if Draw() can be used in place of drawing the contents.
+		bool IsBaked() const { return kBaked == fState; }
+
+		// Called whenever the contents are drawn directly. Returns true if
+		// that draw should be recorded via Renderer::BeginStaticBatch().
+		bool WillDrawContents();
+
+		// Insert the baked runs.
+		void Draw( Renderer& renderer ) const;
+
+		U32 GetRunCount() const { return fRuns.Length(); }
+
+	public:
+		// Used by the Renderer while recording.
+		void Begin();
+		Geometry::Vertex* Reserve( const RenderData& data, U32 vertexCount );
+		void SetUsesTime() { fUsesTime = true; }
+		void End( bool succeeded );
+
+	private:
+		void ReleaseRuns();
+
+	private:
+		enum State
+		{
+			kUnsettled = 0, // Contents changed since they were last drawn
+			kSettled,       // Contents drawn once without changing
+			kRecording,
+			kBaked,
+			kUnbakeable,    // Contents use features that cannot be replayed
+
+			kNumStates
+		};
+
+		struct Run
+		{
+			RenderData fData;
+			Geometry* fGeometry;
+		};
+
+		Rtt_Allocator* fAllocator;
+		Array< Run > fRuns;
+		State fState;
+		bool fUsesTime;
+		bool fIsStale;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_StaticBatch_H__
@@ -13,6 +13,7 @@
 #include "Renderer/Rtt_FrameBufferObject.h"
 #include "Renderer/Rtt_VulkanFrameBufferObject.h"
 #include "Renderer/Rtt_VulkanGeometry.h"
+#include "Renderer/Rtt_VulkanPassRecorder.h"
 #include "Renderer/Rtt_VulkanProgram.h"
 #include "Renderer/Rtt_VulkanTexture.h"
 #include "Renderer/Rtt_VulkanRenderer.h"
@@ -154,7 +155,8 @@ VulkanCommandBuffer::VulkanCommandBuffer( Rtt_Allocator* allocator, VulkanRender
 	fRenderer( renderer ),
 	fContentSize( allocator, Uniform::kVec2 ),
 	fPipeline( VK_NULL_HANDLE ),
-	fSwapchain( VK_NULL_HANDLE )
+	fSwapchain( VK_NULL_HANDLE ),
+	fPassRecorder( Rtt_NEW( allocator, VulkanPassRecorder ) )
 {
 	for(U32 i = 0; i < Uniform::kNumBuiltInVariables; ++i)
 	{
@@ -173,6 +175,7 @@ VulkanCommandBuffer::VulkanCommandBuffer( Rtt_Allocator* allocator, VulkanRender
 VulkanCommandBuffer::~VulkanCommandBuffer()
 {
 //	delete [] fTimerQueries;
+	Rtt_DELETE( fPassRecorder );
 }
 
 void
@@ -684,6 +687,14 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 
 		vkResetCommandPool( device, fFrameResources->fCommands, 0U );
 
+		for (VkCommandPool pool : fFrameResources->fRecordingPools)
+		{
+			if (VK_NULL_HANDLE != pool)
+			{
+				vkResetCommandPool( device, pool, 0U );
+			}
+		}
+
 		VkCommandBufferAllocateInfo allocInfo = {};
 
 		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -725,6 +736,16 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 
 	std::sort( fOffscreenSequence.begin(), fOffscreenSequence.end() );
 
+	// A lone offscreen pass gains nothing from being recorded elsewhere.
+	bool deferOffscreenPasses = VK_NULL_HANDLE != commandBuffer && fOffscreenSequence.size() > 1U;
+
+	for (U32 i = 0; deferOffscreenPasses && i < FrameResources::kMaxRecordingThreads; ++i)
+	{
+		deferOffscreenPasses = VK_NULL_HANDLE != fFrameResources->fRecordingPools[i];
+	}
+
+	fPassRecorder->Reset();
+
 	VulkanUniforms uniforms;
 	VulkanUserData userData;
 	PushConstantState pushConstants;
@@ -754,9 +775,17 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 		fRenderer.ResetPipelineInfo();
 
 		bool isPrimaryPass = fOffscreenSequence.empty(), isCapture = false;
+		VulkanPassRecorder * recorder = NULL;
 
 		if (isPrimaryPass)
 		{
+			// Everything offscreen has been decoded by now; record it.
+			if (fPassRecorder->GetRenderPassCount() > 0U)
+			{
+				fPassRecorder->Record( device, fFrameResources->fRecordingPools, FrameResources::kMaxRecordingThreads, context->GetRecordingWorkers() );
+				fPassRecorder->Execute( fRenderer, commandBuffer );
+			}
+
 			// Reset the offset pointer to the start of the buffer.
 			// This is safe to do here, as preparation work is done
 			// on another CommandBuffer while this one is executing.
@@ -774,6 +803,11 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 			fNumCommands = current.fNumCommands;
 
 			fOffscreenSequence.pop_back();
+
+			if (deferOffscreenPasses)
+			{
+				recorder = fPassRecorder;
+			}
 		}
 
 		std::vector< VkDescriptorImageInfo > descriptorImageInfo( kNumTextures, VkDescriptorImageInfo{} );
@@ -837,7 +871,15 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 				{
 					Rtt_ASSERT( renderPassBeginInfo.renderPass );
 
-					vkCmdEndRenderPass( commandBuffer );
+					if (recorder)
+					{
+						recorder->EndRenderPass();
+					}
+
+					else
+					{
+						vkCmdEndRenderPass( commandBuffer );
+					}
 
 					renderPassBeginInfo.renderPass = VK_NULL_HANDLE;
 
@@ -859,7 +901,10 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 					{
 						index = clearValues.empty(); // use the buffer / pass for the desired clear behavior
 
-						fbo->BeginOffscreenPass( fRenderer, commandBuffer, clearValues.empty() );
+						if (!recorder)
+						{
+							fbo->BeginOffscreenPass( fRenderer, commandBuffer, clearValues.empty() );
+						}
 
 						DEBUG_PRINT( "Offscreen pass: %s", clearValues.empty() ? "load" : "clear" );
 					}
@@ -869,13 +914,26 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 					renderPassBeginInfo.clearValueCount = clearValues.size();
 					renderPassBeginInfo.pClearValues = clearValues.data();
 		
-					vkCmdBeginRenderPass( commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE );
-					vkCmdSetViewport( commandBuffer, 0U, 1U, &viewport );
-					vkCmdSetScissor( commandBuffer, 0U, 1U, &renderPassBeginInfo.renderArea );
+					if (recorder)
+					{
+						recorder->BeginRenderPass( fbo, clearValues.empty(), renderPassBeginInfo, viewport );
 
-					if (geometry)
+						if (geometry)
+						{
+							geometry->Bind( fRenderer, *recorder );
+						}
+					}
+
+					else
 					{
-						geometry->Bind( fRenderer, commandBuffer );
+						vkCmdBeginRenderPass( commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE );
+						vkCmdSetViewport( commandBuffer, 0U, 1U, &viewport );
+						vkCmdSetScissor( commandBuffer, 0U, 1U, &renderPassBeginInfo.renderArea );
+
+						if (geometry)
+						{
+							geometry->Bind( fRenderer, commandBuffer );
+						}
 					}
 
 					Buffer( 0 ).ResetMark();
@@ -895,7 +953,15 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 
 					if (vg != geometry)
 					{
-						vg->Bind( fRenderer, commandBuffer );
+						if (recorder)
+						{
+							vg->Bind( fRenderer, *recorder );
+						}
+
+						else
+						{
+							vg->Bind( fRenderer, commandBuffer );
+						}
 
 						geometry = vg;
 					}
@@ -1380,9 +1446,17 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 					U32 offset = Read<U32>();
 					U32 count = Read<U32>();
 
-					if (PrepareDraw( commandBuffer, mode, descriptorImageInfo, pushConstants, stages ))
+					if (PrepareDraw( commandBuffer, recorder, mode, descriptorImageInfo, pushConstants, stages ))
 					{
-						vkCmdDraw( commandBuffer, count, 1U, offset, 0U );
+						if (recorder)
+						{
+							recorder->Draw( count, offset );
+						}
+
+						else
+						{
+							vkCmdDraw( commandBuffer, count, 1U, offset, 0U );
+						}
 					}
 
 					DEBUG_PRINT( "Draw: mode=%i, offset=%u, count=%u", mode, offset, count );
@@ -1393,12 +1467,20 @@ VulkanCommandBuffer::Execute( bool measureGPU )
 					VkPrimitiveTopology mode = Read<VkPrimitiveTopology>();
 					U32 count = Read<U32>();
 
-					if (PrepareDraw( commandBuffer, mode, descriptorImageInfo, pushConstants, stages ))
+					if (PrepareDraw( commandBuffer, recorder, mode, descriptorImageInfo, pushConstants, stages ))
 					{
 						// The first argument, offset, is currently unused. If support for non-
 						// VBO based indexed rendering is added later, an offset may be needed.
 
-						vkCmdDrawIndexed( commandBuffer, count, 1U, 0U, 0U, 0U );
+						if (recorder)
+						{
+							recorder->DrawIndexed( count );
+						}
+
+						else
+						{
+							vkCmdDrawIndexed( commandBuffer, count, 1U, 0U, 0U, 0U );
+						}
 					}
 
 					DEBUG_PRINT( "Draw indexed: mode=%i, count=%u", mode, count );
@@ -1574,7 +1656,7 @@ VulkanCommandBuffer::BeginFrame()
 	fSwapchain = VK_NULL_HANDLE;
 }
 
-bool VulkanCommandBuffer::PrepareDraw( VkCommandBuffer commandBuffer, VkPrimitiveTopology topology, std::vector< VkDescriptorImageInfo > & descriptorImageInfo, PushConstantState & pushConstants, U32 stages )
+bool VulkanCommandBuffer::PrepareDraw( VkCommandBuffer commandBuffer, VulkanPassRecorder * recorder, VkPrimitiveTopology topology, std::vector< VkDescriptorImageInfo > & descriptorImageInfo, PushConstantState & pushConstants, U32 stages )
 {
 	bool canDraw = VK_NULL_HANDLE != commandBuffer;
 
@@ -1590,7 +1672,15 @@ bool VulkanCommandBuffer::PrepareDraw( VkCommandBuffer commandBuffer, VkPrimitiv
 		{
 			if (pipeline != fPipeline)
 			{
-				vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline );
+				if (recorder)
+				{
+					recorder->BindPipeline( pipeline );
+				}
+
+				else
+				{
+					vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline );
+				}
 
 				fPipeline = pipeline;
 			}
@@ -1642,8 +1732,22 @@ bool VulkanCommandBuffer::PrepareDraw( VkCommandBuffer commandBuffer, VkPrimitiv
 					Rtt_ASSERT( 0U == first );
 					Rtt_ASSERT( 1U == count );
 
-					vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0U, 1U, &sets[0], 1U, dynamicOffsets );
-					vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 2U, 1U, &sets[1], 0U, NULL );
+					if (recorder)
+					{
+						recorder->BindDescriptorSets( pipelineLayout, 0U, 1U, &sets[0], 1U, dynamicOffsets );
+						recorder->BindDescriptorSets( pipelineLayout, 2U, 1U, &sets[1], 0U, NULL );
+					}
+
+					else
+					{
+						vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0U, 1U, &sets[0], 1U, dynamicOffsets );
+						vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 2U, 1U, &sets[1], 0U, NULL );
+					}
+				}
+
+				else if (recorder)
+				{
+					recorder->BindDescriptorSets( pipelineLayout, first, nsets, sets, count, dynamicOffsets );
 				}
 
 				else
@@ -1656,7 +1760,15 @@ bool VulkanCommandBuffer::PrepareDraw( VkCommandBuffer commandBuffer, VkPrimitiv
 			{
 				U32 offset = pushConstants.Offset(), size = pushConstants.Range();
 
-				vkCmdPushConstants( commandBuffer, pipelineLayout, stages, offset, size, pushConstants.GetData( offset ) );
+				if (recorder)
+				{
+					recorder->PushConstants( pipelineLayout, stages, offset, size, pushConstants.GetData( offset ) );
+				}
+
+				else
+				{
+					vkCmdPushConstants( commandBuffer, pipelineLayout, stages, offset, size, pushConstants.GetData( offset ) );
+				}
 			}
 		}
 	}
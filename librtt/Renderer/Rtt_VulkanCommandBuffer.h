@@ -22,6 +22,7 @@ namespace Rtt
 // ----------------------------------------------------------------------------
 
 class VulkanFrameBufferObject;
+class VulkanPassRecorder;
 class VulkanProgram;
 class VulkanRenderer;
 class VulkanContext;
@@ -137,7 +138,7 @@ class VulkanCommandBuffer : public CommandBuffer
 		
 		void BeginFrame();
 		void ClearExecuteResult() { fExecuteResult = VK_SUCCESS; }
-		bool PrepareDraw( VkCommandBuffer commandBuffer, VkPrimitiveTopology topology, std::vector< VkDescriptorImageInfo > & imageInfo, PushConstantState & pushConstants, U32 stages );
+		bool PrepareDraw( VkCommandBuffer commandBuffer, VulkanPassRecorder * recorder, VkPrimitiveTopology topology, std::vector< VkDescriptorImageInfo > & imageInfo, PushConstantState & pushConstants, U32 stages );
 
 	public:
 		VkDescriptorSet AddTextureSet( const std::vector< VkDescriptorImageInfo > & imageInfo );
@@ -215,6 +216,7 @@ class VulkanCommandBuffer : public CommandBuffer
 
 		std::vector< FBONode > fFBOStack;
 		std::vector< OffscreenNode > fOffscreenSequence;
+		VulkanPassRecorder * fPassRecorder;
 		Geometry * fCurrentGeometry;
 		Texture * fCurrentTextures[kNumTextures];
 //		dynamic uniform buffers - as a list?
@@ -8,10 +8,12 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "Renderer/Rtt_VulkanContext.h"
+#include "Renderer/Rtt_VulkanPassRecorder.h"
 #include "Renderer/Rtt_VulkanProgram.h"
 #include "Renderer/Rtt_VulkanRenderer.h"
 #include "Renderer/Rtt_VulkanTexture.h"
 #include "Renderer/Rtt_VulkanExports.h"
+#include "Renderer/Rtt_ProgramBinaryCache.h"
 #include "Core/Rtt_Assert.h"
 #include <shaderc/shaderc.h>
 #include <pthread.h>
@@ -147,14 +149,28 @@ VulkanContext::VulkanContext()
 	fSwapchain( VK_NULL_HANDLE ),
 	fSampleCountFlags( VK_SAMPLE_COUNT_1_BIT ),
 	fCompiler( NULL ),
-	fCompileOptions( NULL )
+	fCompileOptions( NULL ),
+	fRecordingWorkers( NULL )
 {
+	// The thread recording the frame takes a share of the offscreen passes too
+	U32 threadCount = std::min( std::max( std::thread::hardware_concurrency(), 1U ), U32( FrameResources::kMaxRecordingThreads ) );
+
+	fRecordingWorkers = Rtt_NEW( NULL, VulkanRecordingWorkers( threadCount - 1U ) );
 }
 
 VulkanContext::~VulkanContext()
 {
+	Rtt_DELETE( fRecordingWorkers );
+
 	VulkanProgram::CleanUpCompiler( fCompiler, fCompileOptions );
 
+	if (VK_NULL_HANDLE != fPipelineCache)
+	{
+		SavePipelineCache();
+
+		vkDestroyPipelineCache( fDevice, fPipelineCache, fAllocator );
+	}
+
 	for (auto & renderPass : fRenderPasses)
 	{
 		vkDestroyRenderPass( fDevice, renderPass.second.fPass, fAllocator );
@@ -176,6 +192,71 @@ VulkanContext::~VulkanContext()
 	// allocator?
 }
 
+static const char kPipelineCacheExtension[] = "vkcache";
+
+VkPipelineCache
+VulkanContext::GetPipelineCache()
+{
+	// Created on first use, since the caches directory is only known once the display initializes
+	if (VK_NULL_HANDLE == fPipelineCache)
+	{
+		VkPipelineCacheCreateInfo createPipelineCacheInfo = {};
+
+		createPipelineCacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+		std::vector< U8 > data;
+
+		if (ProgramBinaryCache::Read( GetPipelineCacheKey(), kPipelineCacheExtension, data ))
+		{
+			createPipelineCacheInfo.initialDataSize = data.size();
+			createPipelineCacheInfo.pInitialData = data.data();
+		}
+
+		// Drivers ignore incompatible data, but be defensive about ones that reject it outright
+		if (VK_SUCCESS != vkCreatePipelineCache( fDevice, &createPipelineCacheInfo, fAllocator, &fPipelineCache ) && createPipelineCacheInfo.initialDataSize)
+		{
+			createPipelineCacheInfo.initialDataSize = 0U;
+			createPipelineCacheInfo.pInitialData = NULL;
+
+			if (VK_SUCCESS != vkCreatePipelineCache( fDevice, &createPipelineCacheInfo, fAllocator, &fPipelineCache ))
+			{
+				fPipelineCache = VK_NULL_HANDLE;
+			}
+		}
+	}
+
+	return fPipelineCache;
+}
+
+U64
+VulkanContext::GetPipelineCacheKey() const
+{
+	const VkPhysicalDeviceProperties & properties = GetProperties();
+
+	U64 key = ProgramBinaryCache::Hash( "VulkanPipelineCache.1" );
+
+	key = ProgramBinaryCache::Hash( properties.pipelineCacheUUID, sizeof( properties.pipelineCacheUUID ), key );
+	key = ProgramBinaryCache::Hash( &properties.driverVersion, sizeof( properties.driverVersion ), key );
+
+	return key;
+}
+
+void
+VulkanContext::SavePipelineCache()
+{
+	size_t size = 0U;
+
+	if (VK_SUCCESS == vkGetPipelineCacheData( fDevice, fPipelineCache, &size, NULL ) && size)
+	{
+		std::vector< U8 > data( size );
+
+		if (VK_SUCCESS == vkGetPipelineCacheData( fDevice, fPipelineCache, &size, data.data() ))
+		{
+			ProgramBinaryCache::Write( GetPipelineCacheKey(), kPipelineCacheExtension, data.data(), size );
+		}
+	}
+}
+
 const RenderPassData *
 VulkanContext::AddRenderPass( const RenderPassKey & key, VkRenderPass renderPass )
 {
@@ -25,6 +25,7 @@ namespace Rtt
 {
 
 struct VulkanSurfaceParams;
+class VulkanRecordingWorkers;
 
 // ----------------------------------------------------------------------------
 
@@ -92,7 +93,7 @@ class VulkanContext
 		VkQueue GetPresentQueue() const { return fPresentQueue; }
 		VkCommandPool GetSingleTimeCommandsPool() const { return fSingleTimeCommandsPool; }
 		VkSurfaceKHR GetSurface() const { return fSurface; }
-		VkPipelineCache GetPipelineCache() const { return fPipelineCache; }
+		VkPipelineCache GetPipelineCache();
 		VkSampleCountFlagBits GetSampleCountFlags() const { return fSampleCountFlags; }
 		VkSwapchainKHR GetSwapchain() const { return fSwapchain; }
 		const std::vector< uint32_t > & GetQueueFamilies() const { return fQueueFamilies; }
@@ -121,6 +122,8 @@ class VulkanContext
 		shaderc_compiler * GetCompiler() const { return fCompiler; }
 		shaderc_compile_options * GetCompileOptions() const { return fCompileOptions; }
 
+		VulkanRecordingWorkers & GetRecordingWorkers() const { return *fRecordingWorkers; }
+
 	public:
 		const RenderPassData * AddRenderPass( const RenderPassKey & key, VkRenderPass renderPass );
 		const RenderPassData * FindRenderPassData( const RenderPassKey & key ) const;
@@ -150,6 +153,12 @@ class VulkanContext
 		void PrepareCompiler();
 		VkCommandPool MakeCommandPool( uint32_t queueFamily, bool resetCommandBuffer = false );
 
+	private:
+		U64 GetPipelineCacheKey() const;
+		void SavePipelineCache();
+
+	public:
+
 		static bool PopulateMultisampleDetails( VulkanContext & context );
 		static bool PopulatePreSwapchainDetails( VulkanContext & context, const VulkanSurfaceParams & params );
 		static bool PopulateSwapchainDetails( VulkanContext & context );
@@ -190,6 +199,7 @@ class VulkanContext
 		std::map< RenderPassKey, RenderPassData > fRenderPasses;
 		shaderc_compiler * fCompiler;
 		shaderc_compile_options * fCompileOptions;
+		VulkanRecordingWorkers * fRecordingWorkers;
 };
 
 // ----------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include "Renderer/Rtt_VulkanRenderer.h"
 #include "Renderer/Rtt_VulkanContext.h"
 #include "Renderer/Rtt_VulkanGeometry.h"
+#include "Renderer/Rtt_VulkanPassRecorder.h"
 
 #include "Renderer/Rtt_Geometry_Renderer.h"
 #include "Core/Rtt_Assert.h"
@@ -132,6 +133,30 @@ VulkanGeometry::Destroy()
 
 void 
 VulkanGeometry::Bind( VulkanRenderer & renderer, VkCommandBuffer commandBuffer )
+{
+	SetBindingDescriptions( renderer );
+
+	VkBuffer vertexBuffer = fVertexBufferData->GetBuffer();
+	VkDeviceSize offset = 0U;
+
+	vkCmdBindVertexBuffers( commandBuffer, 0U, 1U, &vertexBuffer, &offset );
+
+	if (fIndexBufferData != VK_NULL_HANDLE)
+	{
+		vkCmdBindIndexBuffer( commandBuffer, fIndexBufferData->GetBuffer(), 0U, VK_INDEX_TYPE_UINT16 );
+	}
+}
+
+void
+VulkanGeometry::Bind( VulkanRenderer & renderer, VulkanPassRecorder & recorder )
+{
+	SetBindingDescriptions( renderer );
+
+	recorder.BindGeometry( fVertexBufferData->GetBuffer(), fIndexBufferData ? fIndexBufferData->GetBuffer() : VK_NULL_HANDLE );
+}
+
+void
+VulkanGeometry::SetBindingDescriptions( VulkanRenderer & renderer )
 {
 	U32 bindingID = 0U; // n.b. for future use?
 
@@ -146,16 +171,6 @@ VulkanGeometry::Bind( VulkanRenderer & renderer, VkCommandBuffer commandBuffer )
 	inputBindingDescriptions.push_back( description );
 
 	renderer.SetBindingDescriptions( bindingID, inputBindingDescriptions );
-
-	VkBuffer vertexBuffer = fVertexBufferData->GetBuffer();
-	VkDeviceSize offset = 0U;
-
-	vkCmdBindVertexBuffers( commandBuffer, 0U, 1U, &vertexBuffer, &offset );
-
-	if (fIndexBufferData != VK_NULL_HANDLE)
-	{
-		vkCmdBindIndexBuffer( commandBuffer, fIndexBufferData->GetBuffer(), 0U, VK_INDEX_TYPE_UINT16 );
-	}
 }
 
 void
@@ -22,6 +22,7 @@ class Geometry;
 class VulkanBufferData;
 class VulkanRenderer;
 class VulkanContext;
+class VulkanPassRecorder;
 
 // ----------------------------------------------------------------------------
 
@@ -40,8 +41,12 @@ class VulkanGeometry : public GPUResource
 		virtual void Destroy();
 
 		void Bind( VulkanRenderer & renderer, VkCommandBuffer commandBuffer );
+		void Bind( VulkanRenderer & renderer, VulkanPassRecorder & recorder );
 		void Populate();
 
+	private:
+		void SetBindingDescriptions( VulkanRenderer & renderer );
+
 	private:
 		VulkanBufferData * CreateBufferOnGPU( VkDeviceSize bufferSize, VkBufferUsageFlags usage );
 		bool TransferToGPU( VkBuffer bufferOnGPU, const void * data, VkDeviceSize bufferSize );
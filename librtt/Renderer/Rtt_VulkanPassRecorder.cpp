@@ -0,0 +1,580 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Renderer/Rtt_VulkanPassRecorder.h"
+
+#include "Renderer/Rtt_VulkanFrameBufferObject.h"
+#include "Renderer/Rtt_VulkanRenderer.h"
+#include "Core/Rtt_Assert.h"
+
+#include <algorithm>
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace /*anonymous*/
+{
+	enum Op
+	{
+		kOpBindPipeline,
+		kOpBindDescriptorSets,
+		kOpPushConstants,
+		kOpBindGeometry,
+		kOpDraw,
+		kOpDrawIndexed,
+
+		kNumOps
+	};
+
+	// cf. the push constant range in VulkanRenderer::Initialize()
+	const VkShaderStageFlags kPushConstantStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	// Only the buffer sets take a dynamic offset.
+	bool HasDynamicOffset( uint32_t set )
+	{
+		return set < Rtt::Descriptor::kTexture;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+VulkanRecordingWorkers::VulkanRecordingWorkers( U32 threadCount )
+:	fThreads(),
+	fJob( NULL ),
+	fJobCount( 0U ),
+	fPendingCount( 0U ),
+	fGeneration( 0U ),
+	fShouldStop( false )
+{
+	for (U32 i = 0; i < threadCount; ++i)
+	{
+		fThreads.push_back( std::thread( &VulkanRecordingWorkers::Loop, this, i + 1U ) );
+	}
+}
+
+VulkanRecordingWorkers::~VulkanRecordingWorkers()
+{
+	{
+		std::lock_guard< std::mutex > lock( fMutex );
+		fShouldStop = true;
+	}
+	fWake.notify_all();
+
+	for (std::thread & thread : fThreads)
+	{
+		thread.join();
+	}
+}
+
+void
+VulkanRecordingWorkers::Run( const Job & job, U32 count )
+{
+	count = std::min( count, GetThreadCount() + 1U );
+
+	if (count > 1U)
+	{
+		{
+			std::lock_guard< std::mutex > lock( fMutex );
+
+			fJob = &job;
+			fJobCount = count;
+			fPendingCount = count - 1U;
+
+			++fGeneration;
+		}
+		fWake.notify_all();
+	}
+
+	if (count > 0U)
+	{
+		job( 0U );
+	}
+
+	if (count > 1U)
+	{
+		std::unique_lock< std::mutex > lock( fMutex );
+		fDone.wait( lock, [this]() { return 0U == fPendingCount; } );
+
+		fJob = NULL;
+	}
+}
+
+void
+VulkanRecordingWorkers::Loop( U32 index )
+{
+	U32 generation = 0U;
+
+	for (;;)
+	{
+		const Job * job = NULL;
+
+		{
+			std::unique_lock< std::mutex > lock( fMutex );
+			fWake.wait( lock, [this, generation]() { return fShouldStop || generation != fGeneration; } );
+
+			if (fShouldStop)
+			{
+				break;
+			}
+
+			generation = fGeneration;
+
+			if (index < fJobCount)
+			{
+				job = fJob;
+			}
+		}
+
+		if (job)
+		{
+			(*job)( index );
+
+			bool isLast = false;
+
+			{
+				std::lock_guard< std::mutex > lock( fMutex );
+				isLast = 0U == --fPendingCount;
+			}
+
+			if (isLast)
+			{
+				fDone.notify_one();
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename T >
+void
+VulkanPassRecorder::Write( const T & value )
+{
+	const U8 * bytes = reinterpret_cast< const U8 * >( &value );
+
+	fStream.insert( fStream.end(), bytes, bytes + sizeof( T ) );
+}
+
+template < typename T >
+T
+VulkanPassRecorder::Read( size_t & offset ) const
+{
+	T value;
+
+	memcpy( &value, fStream.data() + offset, sizeof( T ) );
+
+	offset += sizeof( T );
+
+	return value;
+}
+
+VulkanPassRecorder::BoundState::BoundState()
+:	fPipeline( VK_NULL_HANDLE ),
+	fLayout( VK_NULL_HANDLE ),
+	fPushLower( 0U ),
+	fPushUpper( 0U )
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		fSets[i] = VK_NULL_HANDLE;
+		fOffsets[i] = 0U;
+	}
+}
+
+void
+VulkanPassRecorder::BoundState::Apply( VkCommandBuffer commandBuffer ) const
+{
+	if (VK_NULL_HANDLE != fPipeline)
+	{
+		vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, fPipeline );
+	}
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		if (VK_NULL_HANDLE != fSets[i])
+		{
+			uint32_t offsetCount = HasDynamicOffset( i ) ? 1U : 0U;
+
+			vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, fLayout, i, 1U, &fSets[i], offsetCount, &fOffsets[i] );
+		}
+	}
+
+	if (fPushLower < fPushUpper)
+	{
+		const U8 * bytes = reinterpret_cast< const U8 * >( &fPushConstants );
+
+		vkCmdPushConstants( commandBuffer, fLayout, kPushConstantStages, fPushLower, fPushUpper - fPushLower, bytes + fPushLower );
+	}
+}
+
+VulkanPassRecorder::VulkanPassRecorder()
+:	fStream(),
+	fRenderPasses(),
+	fState(),
+	fInRenderPass( false )
+{
+}
+
+void
+VulkanPassRecorder::Reset()
+{
+	Rtt_ASSERT( !fInRenderPass );
+
+	fStream.clear();
+	fRenderPasses.clear();
+
+	fState = BoundState();
+}
+
+void
+VulkanPassRecorder::BeginRenderPass( VulkanFrameBufferObject * fbo, bool load, const VkRenderPassBeginInfo & passBeginInfo, const VkViewport & viewport )
+{
+	Rtt_ASSERT( !fInRenderPass );
+
+	RenderPass pass;
+
+	pass.fFBO = fbo;
+	pass.fBeginInfo = passBeginInfo;
+	pass.fClearValues.assign( passBeginInfo.pClearValues, passBeginInfo.pClearValues + passBeginInfo.clearValueCount );
+	pass.fViewport = viewport;
+	pass.fState = fState; // nothing carries over into a secondary command buffer
+	pass.fStart = pass.fEnd = fStream.size();
+	pass.fCommandBuffer = VK_NULL_HANDLE;
+	pass.fLoad = load;
+
+	fRenderPasses.push_back( pass );
+
+	fInRenderPass = true;
+}
+
+void
+VulkanPassRecorder::EndRenderPass()
+{
+	Rtt_ASSERT( fInRenderPass );
+
+	fRenderPasses.back().fEnd = fStream.size();
+
+	fInRenderPass = false;
+}
+
+void
+VulkanPassRecorder::BindPipeline( VkPipeline pipeline )
+{
+	fState.fPipeline = pipeline;
+
+	if (fInRenderPass)
+	{
+		Write( kOpBindPipeline );
+		Write( pipeline );
+	}
+}
+
+void
+VulkanPassRecorder::BindDescriptorSets( VkPipelineLayout layout, uint32_t first, uint32_t count, const VkDescriptorSet * sets, uint32_t offsetCount, const uint32_t * offsets )
+{
+	Rtt_ASSERT( first + count <= 3U );
+
+	fState.fLayout = layout;
+
+	for (uint32_t i = 0, offsetIndex = 0; i < count; ++i)
+	{
+		fState.fSets[first + i] = sets[i];
+
+		if (HasDynamicOffset( first + i ))
+		{
+			Rtt_ASSERT( offsetIndex < offsetCount );
+
+			fState.fOffsets[first + i] = offsets[offsetIndex++];
+		}
+	}
+
+	if (fInRenderPass)
+	{
+		Write( kOpBindDescriptorSets );
+		Write( layout );
+		Write( first );
+		Write( count );
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Write( sets[i] );
+		}
+
+		Write( offsetCount );
+
+		for (uint32_t i = 0; i < offsetCount; ++i)
+		{
+			Write( offsets[i] );
+		}
+	}
+}
+
+void
+VulkanPassRecorder::PushConstants( VkPipelineLayout layout, VkShaderStageFlags stages, uint32_t offset, uint32_t size, const void * data )
+{
+	Rtt_ASSERT( offset + size <= sizeof( VulkanPushConstants ) );
+
+	fState.fLayout = layout;
+
+	memcpy( reinterpret_cast< U8 * >( &fState.fPushConstants ) + offset, data, size );
+
+	if (fState.fPushLower < fState.fPushUpper)
+	{
+		fState.fPushLower = std::min( fState.fPushLower, offset );
+		fState.fPushUpper = std::max( fState.fPushUpper, offset + size );
+	}
+
+	else
+	{
+		fState.fPushLower = offset;
+		fState.fPushUpper = offset + size;
+	}
+
+	if (fInRenderPass)
+	{
+		const U8 * bytes = static_cast< const U8 * >( data );
+
+		Write( kOpPushConstants );
+		Write( layout );
+		Write( stages );
+		Write( offset );
+		Write( size );
+
+		fStream.insert( fStream.end(), bytes, bytes + size );
+	}
+}
+
+void
+VulkanPassRecorder::BindGeometry( VkBuffer vertexBuffer, VkBuffer indexBuffer )
+{
+	// The command buffer binds the geometry again when a pass begins.
+	if (fInRenderPass)
+	{
+		Write( kOpBindGeometry );
+		Write( vertexBuffer );
+		Write( indexBuffer );
+	}
+}
+
+void
+VulkanPassRecorder::Draw( uint32_t count, uint32_t first )
+{
+	Rtt_ASSERT( fInRenderPass );
+
+	Write( kOpDraw );
+	Write( count );
+	Write( first );
+}
+
+void
+VulkanPassRecorder::DrawIndexed( uint32_t count )
+{
+	Rtt_ASSERT( fInRenderPass );
+
+	Write( kOpDrawIndexed );
+	Write( count );
+}
+
+void
+VulkanPassRecorder::Record( VkDevice device, const VkCommandPool pools[], U32 poolCount, VulkanRecordingWorkers & workers )
+{
+	Rtt_ASSERT( !fInRenderPass );
+
+	U32 threadCount = std::min( workers.GetThreadCount() + 1U, poolCount );
+
+	threadCount = std::min( threadCount, GetRenderPassCount() );
+
+	workers.Run( [this, device, pools, threadCount]( U32 index )
+	{
+		RecordPasses( device, pools[index], index, threadCount );
+	}, threadCount );
+}
+
+void
+VulkanPassRecorder::Execute( VulkanRenderer & renderer, VkCommandBuffer commandBuffer )
+{
+	for (RenderPass & pass : fRenderPasses)
+	{
+		// Layout transitions are not allowed inside a render pass, so these stay here.
+		pass.fFBO->BeginOffscreenPass( renderer, commandBuffer, pass.fLoad );
+
+		pass.fBeginInfo.clearValueCount = U32( pass.fClearValues.size() );
+		pass.fBeginInfo.pClearValues = pass.fClearValues.data();
+
+		vkCmdBeginRenderPass( commandBuffer, &pass.fBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS );
+
+		if (VK_NULL_HANDLE != pass.fCommandBuffer)
+		{
+			vkCmdExecuteCommands( commandBuffer, 1U, &pass.fCommandBuffer );
+		}
+
+		else
+		{
+			Rtt_TRACE_SIM(( "ERROR: Offscreen pass was not recorded; only its clear will take effect!" ));
+		}
+
+		vkCmdEndRenderPass( commandBuffer );
+	}
+
+	fState.Apply( commandBuffer );
+}
+
+void
+VulkanPassRecorder::RecordPasses( VkDevice device, VkCommandPool pool, U32 first, U32 step )
+{
+	for (U32 i = first, iMax = GetRenderPassCount(); i < iMax; i += step)
+	{
+		RenderPass & pass = fRenderPasses[i];
+
+		if (!RecordPass( device, pool, pass ))
+		{
+			pass.fCommandBuffer = VK_NULL_HANDLE;
+		}
+	}
+}
+
+bool
+VulkanPassRecorder::RecordPass( VkDevice device, VkCommandPool pool, RenderPass & pass ) const
+{
+	VkCommandBufferAllocateInfo allocInfo = {};
+
+	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocInfo.commandBufferCount = 1U;
+	allocInfo.commandPool = pool;
+	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+
+	if (VK_SUCCESS != vkAllocateCommandBuffers( device, &allocInfo, &pass.fCommandBuffer ))
+	{
+		return false;
+	}
+
+	VkCommandBufferInheritanceInfo inheritanceInfo = {};
+
+	inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	inheritanceInfo.framebuffer = pass.fBeginInfo.framebuffer;
+	inheritanceInfo.renderPass = pass.fBeginInfo.renderPass;
+
+	VkCommandBufferBeginInfo beginInfo = {};
+
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+	beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+	VkCommandBuffer commandBuffer = pass.fCommandBuffer;
+
+	if (VK_SUCCESS != vkBeginCommandBuffer( commandBuffer, &beginInfo ))
+	{
+		return false;
+	}
+
+	vkCmdSetViewport( commandBuffer, 0U, 1U, &pass.fViewport );
+	vkCmdSetScissor( commandBuffer, 0U, 1U, &pass.fBeginInfo.renderArea );
+
+	pass.fState.Apply( commandBuffer );
+
+	for (size_t offset = pass.fStart; offset < pass.fEnd; )
+	{
+		Op op = Read< Op >( offset );
+
+		switch (op)
+		{
+			case kOpBindPipeline:
+			{
+				VkPipeline pipeline = Read< VkPipeline >( offset );
+
+				vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline );
+
+				break;
+			}
+			case kOpBindDescriptorSets:
+			{
+				VkPipelineLayout layout = Read< VkPipelineLayout >( offset );
+				uint32_t first = Read< uint32_t >( offset ), count = Read< uint32_t >( offset );
+				VkDescriptorSet sets[3];
+
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					sets[i] = Read< VkDescriptorSet >( offset );
+				}
+
+				uint32_t offsetCount = Read< uint32_t >( offset ), offsets[3];
+
+				for (uint32_t i = 0; i < offsetCount; ++i)
+				{
+					offsets[i] = Read< uint32_t >( offset );
+				}
+
+				vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, first, count, sets, offsetCount, offsets );
+
+				break;
+			}
+			case kOpPushConstants:
+			{
+				VkPipelineLayout layout = Read< VkPipelineLayout >( offset );
+				VkShaderStageFlags stages = Read< VkShaderStageFlags >( offset );
+				uint32_t pushOffset = Read< uint32_t >( offset ), size = Read< uint32_t >( offset );
+
+				vkCmdPushConstants( commandBuffer, layout, stages, pushOffset, size, fStream.data() + offset );
+
+				offset += size;
+
+				break;
+			}
+			case kOpBindGeometry:
+			{
+				VkBuffer vertexBuffer = Read< VkBuffer >( offset ), indexBuffer = Read< VkBuffer >( offset );
+				VkDeviceSize vertexOffset = 0U;
+
+				vkCmdBindVertexBuffers( commandBuffer, 0U, 1U, &vertexBuffer, &vertexOffset );
+
+				if (VK_NULL_HANDLE != indexBuffer)
+				{
+					vkCmdBindIndexBuffer( commandBuffer, indexBuffer, 0U, VK_INDEX_TYPE_UINT16 );
+				}
+
+				break;
+			}
+			case kOpDraw:
+			{
+				uint32_t count = Read< uint32_t >( offset ), first = Read< uint32_t >( offset );
+
+				vkCmdDraw( commandBuffer, count, 1U, first, 0U );
+
+				break;
+			}
+			case kOpDrawIndexed:
+			{
+				uint32_t count = Read< uint32_t >( offset );
+
+				vkCmdDrawIndexed( commandBuffer, count, 1U, 0U, 0U, 0U );
+
+				break;
+			}
+			default:
+				Rtt_ASSERT_NOT_REACHED();
+
+				offset = pass.fEnd;
+
+				break;
+		}
+	}
+
+	return VK_SUCCESS == vkEndCommandBuffer( commandBuffer );
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
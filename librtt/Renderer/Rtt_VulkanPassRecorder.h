@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_VulkanPassRecorder_H__
+#define _Rtt_VulkanPassRecorder_H__
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Renderer/Rtt_VulkanCommandBuffer.h"
+#include "Renderer/Rtt_VulkanIncludes.h"
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+class VulkanFrameBufferObject;
+class VulkanRenderer;
+
+// ----------------------------------------------------------------------------
+
+// Threads that help record offscreen passes. They live as long as the context
+// and sleep between frames, rather than being started and joined every frame.
+class VulkanRecordingWorkers
+{
+	public:
+		typedef std::function< void ( U32 ) > Job;
+
+	public:
+		VulkanRecordingWorkers( U32 threadCount );
+		~VulkanRecordingWorkers();
+
+	public:
+		U32 GetThreadCount() const { return U32( fThreads.size() ); }
+
+		// Calls job( i ) for every i below count, the calling thread taking
+		// i = 0, and returns once all of them are done. At most one more than
+		// GetThreadCount() calls run at once.
+		void Run( const Job & job, U32 count );
+
+	private:
+		void Loop( U32 index );
+
+	private:
+		std::vector< std::thread > fThreads;
+		std::mutex fMutex;
+		std::condition_variable fWake;
+		std::condition_variable fDone;
+		const Job * fJob;
+		U32 fJobCount;
+		U32 fPendingCount;
+		U32 fGeneration;
+		bool fShouldStop;
+};
+
+// ----------------------------------------------------------------------------
+
+// Offscreen passes (snapshots, canvases, captures) only depend on one another
+// once they execute, not while they are recorded. The command buffer still
+// decodes them in order on the rendering thread, since that drives pipeline
+// and descriptor state, but sends the resulting draw commands here. Each
+// render pass is then recorded into its own secondary command buffer, spread
+// over worker threads, and the primary command buffer only issues the layout
+// barriers, begins and ends the render passes, and executes them in order.
+class VulkanPassRecorder
+{
+	public:
+		typedef VulkanPassRecorder Self;
+
+	public:
+		VulkanPassRecorder();
+
+	public:
+		// Forget all passes and bound state; once per frame.
+		void Reset();
+
+		void BeginRenderPass( VulkanFrameBufferObject * fbo, bool load, const VkRenderPassBeginInfo & passBeginInfo, const VkViewport & viewport );
+		void EndRenderPass();
+
+		void BindPipeline( VkPipeline pipeline );
+		void BindDescriptorSets( VkPipelineLayout layout, uint32_t first, uint32_t count, const VkDescriptorSet * sets, uint32_t offsetCount, const uint32_t * offsets );
+		void PushConstants( VkPipelineLayout layout, VkShaderStageFlags stages, uint32_t offset, uint32_t size, const void * data );
+		void BindGeometry( VkBuffer vertexBuffer, VkBuffer indexBuffer );
+		void Draw( uint32_t count, uint32_t first );
+		void DrawIndexed( uint32_t count );
+
+		U32 GetRenderPassCount() const { return U32( fRenderPasses.size() ); }
+
+		// Record every render pass into a secondary command buffer. Up to
+		// poolCount threads are used, the calling one and the workers, the
+		// i-th allocating from pools[i].
+		void Record( VkDevice device, const VkCommandPool pools[], U32 poolCount, VulkanRecordingWorkers & workers );
+
+		// Issue the passes into the primary command buffer, then rebind the
+		// state the last pass left, for whatever gets recorded inline after.
+		void Execute( VulkanRenderer & renderer, VkCommandBuffer commandBuffer );
+
+	private:
+		// What a command buffer needs bound to pick up where the decoder is.
+		struct BoundState {
+			BoundState();
+
+			void Apply( VkCommandBuffer commandBuffer ) const;
+
+			VkPipeline fPipeline;
+			VkPipelineLayout fLayout;
+			VkDescriptorSet fSets[3];
+			uint32_t fOffsets[3];
+			VulkanPushConstants fPushConstants;
+			uint32_t fPushLower;
+			uint32_t fPushUpper;
+		};
+
+		struct RenderPass {
+			VulkanFrameBufferObject * fFBO;
+			VkRenderPassBeginInfo fBeginInfo;
+			std::vector< VkClearValue > fClearValues;
+			VkViewport fViewport;
+			BoundState fState;
+			size_t fStart;
+			size_t fEnd;
+			VkCommandBuffer fCommandBuffer;
+			bool fLoad;
+		};
+
+		void RecordPasses( VkDevice device, VkCommandPool pool, U32 first, U32 step );
+		bool RecordPass( VkDevice device, VkCommandPool pool, RenderPass & pass ) const;
+
+		template < typename T > void Write( const T & value );
+		template < typename T > T Read( size_t & offset ) const;
+
+	private:
+		std::vector< U8 > fStream;
+		std::vector< RenderPass > fRenderPasses;
+		BoundState fState;
+		bool fInRenderPass;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_VulkanPassRecorder_H__
@@ -171,6 +171,26 @@ VulkanProgram::Create( CPUResource* resource )
 		
 			ShaderResource::SetAddedUsesTime( true );
 		}
+	#else
+		Prewarm( resource );
+	#endif
+}
+
+void
+VulkanProgram::Prewarm( CPUResource* resource )
+{
+	Rtt_ASSERT( resource == fResource );
+
+	#if DEFER_VK_CREATION
+		Program* program = static_cast<Program*>( resource );
+
+		for( U32 i = 0; i < Program::kNumVersions; ++i )
+		{
+			if ( program->GetPrewarmVersions() & ( 1 << i ) )
+			{
+				CreateDeferred( (Program::Version)i );
+			}
+		}
 	#endif
 }
 
@@ -208,19 +228,7 @@ VulkanProgram::Bind( VulkanRenderer & renderer, Program::Version version )
 	VersionData& data = fData[version];
 	
 	#if DEFER_VK_CREATION
-		if( !data.fAttemptedCreation )
-		{
-			Create( version, data );
-			
-			if ( fData[version].HasTime() )
-            {
-				Program* program = (Program*)fResource;
-				
-				program->GetShaderResource()->SetUsesTime( true );
-				
-				ShaderResource::SetAddedUsesTime( true );
-            }
-		}
+		CreateDeferred( version );
 	#endif
 
 	std::vector< VkVertexInputAttributeDescription > inputAttributeDescriptions;
@@ -308,6 +316,26 @@ VulkanProgram::CompileState::HasError() const
 
 U32 VulkanProgram::sID;
 
+void
+VulkanProgram::CreateDeferred( Program::Version version )
+{
+	VersionData& data = fData[version];
+
+	if( !data.fAttemptedCreation )
+	{
+		Create( version, data );
+
+		if ( data.HasTime() )
+		{
+			Program* program = (Program*)fResource;
+
+			program->GetShaderResource()->SetUsesTime( true );
+
+			ShaderResource::SetAddedUsesTime( true );
+		}
+	}
+}
+
 void
 VulkanProgram::Create( Program::Version version, VersionData& data )
 {
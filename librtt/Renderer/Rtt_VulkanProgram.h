@@ -47,6 +47,7 @@ class VulkanProgram : public GPUResource
 
 		virtual void Create( CPUResource* resource );
 		virtual void Update( CPUResource* resource );
+		virtual void Prewarm( CPUResource* resource );
 		virtual void Destroy();
 		
 		void Bind( VulkanRenderer & renderer, Program::Version version );
@@ -143,6 +144,7 @@ class VulkanProgram : public GPUResource
 		};
 
 		void Create( Program::Version version, VersionData& data );
+		void CreateDeferred( Program::Version version );
 		void Update( Program::Version version, VersionData& data );
 		void Reset( VersionData& data );
 
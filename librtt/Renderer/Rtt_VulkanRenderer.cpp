@@ -352,6 +352,10 @@ FrameResources::FrameResources()
 	fRenderFinished( VK_NULL_HANDLE ),
 	fFence( VK_NULL_HANDLE )
 {
+	for (int i = 0; i < kMaxRecordingThreads; ++i)
+	{
+		fRecordingPools[i] = VK_NULL_HANDLE;
+	}
 }
 
 bool
@@ -390,6 +394,13 @@ FrameResources::CleanUpCommandPool( VkDevice device, const VkAllocationCallbacks
 	vkDestroyCommandPool( device, fCommands, allocator );
 
 	fCommands = VK_NULL_HANDLE;
+
+	for (int i = 0; i < kMaxRecordingThreads; ++i)
+	{
+		vkDestroyCommandPool( device, fRecordingPools[i], allocator );
+
+		fRecordingPools[i] = VK_NULL_HANDLE;
+	}
 }
 
 static void
@@ -548,6 +559,11 @@ VulkanRenderer::VulkanRenderer( Rtt_Allocator* allocator, VulkanContext * contex
 		fFrameResources[i].fTextures = Rtt_NEW( NULL, TexturesDescriptor( context, fTextureLayout ) );
 		fFrameResources[i].fCommands = context->MakeCommandPool( graphicsFamily );
 
+		for (int j = 0; j < FrameResources::kMaxRecordingThreads; ++j)
+		{
+			fFrameResources[i].fRecordingPools[j] = context->MakeCommandPool( graphicsFamily );
+		}
+
 		if (!fFrameResources[i].AddSynchronizationObjects( context->GetDevice(), context->GetAllocator() )) // TODO: could fail at other steps...
 		{
 			Rtt_TRACE_SIM(( "ERROR: Failed to create some synchronziation objects!" ));
@@ -898,6 +914,11 @@ VulkanRenderer::TearDownSwapchain()
 	for (FrameResources & resources : fFrameResources)
 	{
 		vkResetCommandPool( ci.device, resources.fCommands, 0U );
+
+		for (VkCommandPool pool : resources.fRecordingPools)
+		{
+			vkResetCommandPool( ci.device, pool, 0U );
+		}
 	}
 
     fContext->SetSwapchain( VK_NULL_HANDLE );
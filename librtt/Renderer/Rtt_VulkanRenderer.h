@@ -105,6 +105,8 @@ struct TexturesDescriptor : public Descriptor {
 };
 
 struct FrameResources {
+	enum { kMaxRecordingThreads = 4 };
+
 	FrameResources();
 
 	bool AddSynchronizationObjects( VkDevice device, const VkAllocationCallbacks * allocator );
@@ -116,6 +118,7 @@ struct FrameResources {
 	BufferDescriptor * fUserData;
 	TexturesDescriptor * fTextures;
 	VkCommandPool fCommands;
+	VkCommandPool fRecordingPools[kMaxRecordingThreads]; // one per thread recording offscreen passes
 	VkSemaphore fImageAvailable;
 	VkSemaphore fRenderFinished;
 	VkFence fFence;
@@ -963,15 +963,10 @@ Archive::Archive( Rtt_Allocator& allocator, const char *srcPath )
 		Rtt_FileClose(filePointer);
 	}
 #else
-	int fileDescriptor = Rtt_FileDescriptorOpen(srcPath, O_RDONLY, S_IRUSR);
-	struct stat statbuf;
-	int result = fstat(fileDescriptor, &statbuf); Rtt_ASSERT(result >= 0);
-
-	int canWrite = 0;
-	fData = Rtt_FileMemoryMap(fileDescriptor, 0, statbuf.st_size, canWrite);
-
-	fDataLen = statbuf.st_size;
-	Rtt_FileDescriptorClose(fileDescriptor);
+	fFile = MappedFile::Open( & allocator, srcPath );
+	Rtt_ASSERT( fFile.NotNull() );
+	fData = fFile.NotNull() ? fFile->GetBytes() : NULL;
+	fDataLen = fFile.NotNull() ? fFile->GetLength() : 0;
 #endif
 
 #if Rtt_DEBUG_ARCHIVE
@@ -1038,20 +1033,7 @@ Archive::Archive( Rtt_Allocator& allocator, const char *srcPath )
 
 Archive::~Archive()
 {
-#if defined( Rtt_NXS_ENV )
-	// Do nothing.
-#else
-	if ( Rtt_VERIFY( fData ) )
-	{
-#if defined( Rtt_WIN_DESKTOP_ENV )
-		Rtt_FileMemoryUnmap( fData, fDataLen );
-#else
-//TODO: Merge this code with the Windows code block up above using the new Rtt_File*() functions.
-		munmap( (void*)fData, fDataLen );
-#endif
-	}
-#endif
-
+	// fFile unmaps the archive once nothing else holds it
 	Rtt_FREE( fEntries );
 
 }
@@ -19,6 +19,10 @@
 	#include "Core/Rtt_Data.h"
 #endif
 
+#if !defined( Rtt_NO_ARCHIVE ) && !defined( Rtt_NXS_ENV )
+	#include "Core/Rtt_MappedFile.h"
+#endif
+
 // ----------------------------------------------------------------------------
 
 namespace Rtt
@@ -77,6 +81,9 @@ class Archive
 		size_t fNumEntries;
 		const void* fData;
 		size_t fDataLen;
+#if !defined( Rtt_NXS_ENV )
+		SharedPtr< MappedFile > fFile;
+#endif
 #if defined( Rtt_ARCHIVE_COPY_DATA )
 		Data<char> fBits;
 #endif
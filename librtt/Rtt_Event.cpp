@@ -511,6 +511,53 @@ MemoryWarningEvent::Push( lua_State *L ) const
 
 // ----------------------------------------------------------------------------
 
+FileIOEvent::FileIOEvent( const char *type, const char *path, const char *errorMessage, const char *data, size_t dataLength )
+:	fType( type ),
+	fPath( path ),
+	fErrorMessage( errorMessage ),
+	fData( data ),
+	fDataLength( dataLength )
+{
+}
+
+const char FileIOEvent::kName[] = "fileIO";
+
+const char*
+FileIOEvent::Name() const
+{
+	return kName;
+}
+
+int
+FileIOEvent::Push( lua_State *L ) const
+{
+	if ( Rtt_VERIFY( Super::Push( L ) ) )
+	{
+		lua_pushstring( L, fType );
+		lua_setfield( L, -2, kTypeKey );
+
+		lua_pushstring( L, fPath );
+		lua_setfield( L, -2, "path" );
+
+		lua_pushboolean( L, NULL != fErrorMessage );
+		lua_setfield( L, -2, kIsErrorKey );
+
+		if ( fErrorMessage )
+		{
+			lua_pushstring( L, fErrorMessage );
+			lua_setfield( L, -2, kErrorMessageKey );
+		}
+		else if ( fData )
+		{
+			lua_pushlstring( L, fData, fDataLength );
+			lua_setfield( L, -2, "data" );
+		}
+	}
+	return 1;
+}
+
+// ----------------------------------------------------------------------------
+
 const char*
 NotificationEvent::StringForType( Type type )
 {
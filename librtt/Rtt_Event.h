@@ -339,6 +339,35 @@ class MemoryWarningEvent : public VirtualEvent
 
 // ----------------------------------------------------------------------------
 
+// Sent to the listener of system.readFileAsync(), writeFileAsync() and
+// copyFileAsync() once the operation completes
+class FileIOEvent : public VirtualEvent
+{
+	public:
+		typedef VirtualEvent Super;
+
+	public:
+		static const char kName[];
+
+	public:
+		// type is "read", "write" or "copy". errorMessage is NULL on success;
+		// data is the file's contents for a successful read.
+		FileIOEvent( const char *type, const char *path, const char *errorMessage, const char *data, size_t dataLength );
+
+	public:
+		virtual const char* Name() const;
+		virtual int Push( lua_State *L ) const;
+
+	private:
+		const char *fType;
+		const char *fPath;
+		const char *fErrorMessage;
+		const char *fData;
+		size_t fDataLength;
+};
+
+// ----------------------------------------------------------------------------
+
 // Immediately broadcast to "Runtime"
 class NotificationEvent : public VirtualEvent
 {
@@ -0,0 +1,258 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Rtt_FileIOQueue.h"
+
+#include "Core/Rtt_FileSystem.h"
+#include "Rtt_Event.h"
+#include "Rtt_LuaResource.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+FileIOTask::FileIOTask( Type type, const char *path, const char *srcPath, LuaResource *listener )
+:	fType( type ),
+	fPath( path ),
+	fSrcPath( srcPath ? srcPath : "" ),
+	fListener( listener ),
+	fErrorCode( 0 )
+{
+}
+
+FileIOTask::~FileIOTask()
+{
+	// Only ever destroyed on the main thread, which owns the Lua state
+	Rtt_DELETE( fListener );
+}
+
+int
+FileIOTask::ReadFile( const char *path, std::string& contents )
+{
+	FILE *f = Rtt_FileOpen( path, "rb" );
+	if ( ! f )
+	{
+		return errno ? errno : ENOENT;
+	}
+
+	int result = 0;
+	char buffer[64 * 1024];
+	size_t count;
+	while ( ( count = Rtt_FileRead( buffer, 1, sizeof( buffer ), f ) ) > 0 )
+	{
+		contents.append( buffer, count );
+	}
+	if ( Rtt_FileError( f ) )
+	{
+		result = errno ? errno : EIO;
+	}
+	Rtt_FileClose( f );
+	return result;
+}
+
+// Closes f, written as tmpPath, and moves it over path if result is 0.
+// Returns result, or the errno value of the step that failed.
+static int
+ReplaceFile( FILE *f, const std::string& tmpPath, const char *path, int result )
+{
+	if ( Rtt_FileClose( f ) != 0 && 0 == result )
+	{
+		result = errno ? errno : EIO;
+	}
+
+	if ( 0 == result && rename( tmpPath.c_str(), path ) != 0 )
+	{
+		// Windows won't rename over an existing file
+		Rtt_DeleteFile( path );
+		if ( rename( tmpPath.c_str(), path ) != 0 )
+		{
+			result = errno ? errno : EIO;
+		}
+	}
+	if ( result )
+	{
+		Rtt_DeleteFile( tmpPath.c_str() );
+	}
+	return result;
+}
+
+int
+FileIOTask::WriteFile( const char *path, const char *bytes, size_t length )
+{
+	std::string tmpPath( path );
+	tmpPath += ".tmp";
+
+	FILE *f = Rtt_FileOpen( tmpPath.c_str(), "wb" );
+	if ( ! f )
+	{
+		return errno ? errno : EACCES;
+	}
+
+	int result = 0;
+	if ( fwrite( bytes, 1, length, f ) != length )
+	{
+		result = errno ? errno : EIO;
+	}
+	return ReplaceFile( f, tmpPath, path, result );
+}
+
+int
+FileIOTask::CopyToFile( const char *srcPath, const char *path )
+{
+	FILE *src = Rtt_FileOpen( srcPath, "rb" );
+	if ( ! src )
+	{
+		return errno ? errno : ENOENT;
+	}
+
+	std::string tmpPath( path );
+	tmpPath += ".tmp";
+
+	FILE *f = Rtt_FileOpen( tmpPath.c_str(), "wb" );
+	if ( ! f )
+	{
+		int result = errno ? errno : EACCES;
+		Rtt_FileClose( src );
+		return result;
+	}
+
+	int result = 0;
+	char buffer[64 * 1024];
+	size_t count;
+	while ( 0 == result && ( count = Rtt_FileRead( buffer, 1, sizeof( buffer ), src ) ) > 0 )
+	{
+		if ( fwrite( buffer, 1, count, f ) != count )
+		{
+			result = errno ? errno : EIO;
+		}
+	}
+	if ( 0 == result && Rtt_FileError( src ) )
+	{
+		result = errno ? errno : EIO;
+	}
+	Rtt_FileClose( src );
+
+	return ReplaceFile( f, tmpPath, path, result );
+}
+
+void
+FileIOTask::Perform()
+{
+	errno = 0;
+	switch ( fType )
+	{
+		case kRead:
+			fErrorCode = ReadFile( fPath.c_str(), fData );
+			break;
+		case kWrite:
+			fErrorCode = WriteFile( fPath.c_str(), fData.data(), fData.size() );
+			fData.clear();
+			break;
+		case kCopy:
+			fErrorCode = CopyToFile( fSrcPath.c_str(), fPath.c_str() );
+			break;
+		default:
+			Rtt_ASSERT_NOT_REACHED();
+			break;
+	}
+}
+
+void
+FileIOTask::operator()( Scheduler& sender )
+{
+	if ( ! fListener )
+	{
+		return;
+	}
+
+	static const char *kTypeNames[] = { "read", "write", "copy" };
+
+	const char *errorMessage = fErrorCode ? strerror( fErrorCode ) : NULL;
+	FileIOEvent e( kTypeNames[fType], fPath.c_str(), errorMessage, fData.data(), fData.size() );
+	fListener->DispatchEvent( e );
+}
+
+// ----------------------------------------------------------------------------
+
+FileIOQueue::FileIOQueue( Scheduler& scheduler )
+:	fScheduler( scheduler ),
+	fQuit( false )
+{
+}
+
+FileIOQueue::~FileIOQueue()
+{
+	{
+		std::lock_guard< std::mutex > lock( fMutex );
+		fQuit = true;
+	}
+	fCondition.notify_one();
+	if ( fThread.joinable() )
+	{
+		fThread.join();
+	}
+
+	for ( size_t i = 0; i < fPending.size(); i++ )
+	{
+		Rtt_DELETE( fPending[i] );
+	}
+}
+
+void
+FileIOQueue::Append( FileIOTask *task )
+{
+	{
+		std::lock_guard< std::mutex > lock( fMutex );
+		fPending.push_back( task );
+		if ( ! fThread.joinable() )
+		{
+			fThread = std::thread( [this]() { Run(); } );
+		}
+	}
+	fCondition.notify_one();
+}
+
+void
+FileIOQueue::Run()
+{
+	std::unique_lock< std::mutex > lock( fMutex );
+	while ( true )
+	{
+		fCondition.wait( lock, [this]() { return fQuit || ! fPending.empty(); } );
+		if ( fQuit )
+		{
+			break;
+		}
+
+		FileIOTask *task = fPending.front();
+		fPending.pop_front();
+
+		lock.unlock();
+		task->Perform();
+
+		// Scheduler::Append() is safe to call from any thread
+		fScheduler.Append( task );
+		lock.lock();
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _Rtt_FileIOQueue_H__
+#define _Rtt_FileIOQueue_H__
+
+#include "Rtt_Scheduler.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+class LuaResource;
+
+// ----------------------------------------------------------------------------
+
+// One system.readFileAsync(), writeFileAsync() or copyFileAsync() call.
+// Perform() runs on the I/O thread; the task is then handed to the
+// Scheduler, so operator() reports the result to the listener on the main
+// thread.
+class FileIOTask : public Task
+{
+	public:
+		typedef Task Super;
+
+		typedef enum _Type
+		{
+			kRead = 0,
+			kWrite,
+			kCopy
+		}
+		Type;
+
+	public:
+		// Takes ownership of listener, which may be NULL. srcPath is only
+		// used by kCopy.
+		FileIOTask( Type type, const char *path, const char *srcPath, LuaResource *listener );
+		virtual ~FileIOTask();
+
+	public:
+		// The bytes for kWrite
+		std::string& GetData() { return fData; }
+
+		void Perform();
+		virtual void operator()( Scheduler& sender );
+
+	public:
+		// Writes through a temporary file that replaces path once complete, so
+		// a crash never leaves a partial file. Returns an errno value, or 0.
+		static int WriteFile( const char *path, const char *bytes, size_t length );
+
+	private:
+		static int ReadFile( const char *path, std::string& contents );
+		static int CopyToFile( const char *srcPath, const char *path );
+
+	private:
+		Type fType;
+		std::string fPath;
+		std::string fSrcPath;
+		std::string fData;
+		LuaResource *fListener;
+		int fErrorCode;
+};
+
+// ----------------------------------------------------------------------------
+
+// Runs FileIOTasks in order on a thread of its own, started by the first
+// one. Owned by the Runtime.
+class FileIOQueue
+{
+	Rtt_CLASS_NO_COPIES( FileIOQueue )
+
+	public:
+		FileIOQueue( Scheduler& scheduler );
+
+		// Waits for the task in progress; queued tasks are dropped
+		~FileIOQueue();
+
+	public:
+		void Append( FileIOTask *task );
+
+	private:
+		void Run();
+
+	private:
+		Scheduler& fScheduler;
+		std::mutex fMutex;
+		std::condition_variable fCondition;
+		std::deque< FileIOTask* > fPending;
+		bool fQuit;
+		std::thread fThread;
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // _Rtt_FileIOQueue_H__
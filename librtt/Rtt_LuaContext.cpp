@@ -24,6 +24,7 @@
 #include "Rtt_LuaGCInhibitor.h"
 #include "Rtt_LuaCoronaBaseLib.h"
 #include "Rtt_LuaLibCrypto.h"
+#include "Rtt_LuaLibJSON.h"
 #if defined ( Rtt_USE_ALMIXER )
 #include "Rtt_LuaLibOpenAL.h"
 #endif
@@ -689,6 +690,7 @@ LuaContext::InitializeLuaCore( lua_State* L )
 		{ "easing", Lua::Open< luaload_easing> },
 		{ "dkjson", Lua::Open< luaload_dkjson > },
 		{ "json", Lua::Open< luaload_json > },
+		{ "json.native", LuaLibJSON::Open },
 #ifdef Rtt_DEBUGGER
 		{ "remdebug_engine", Lua::Open< luaload_remdebug_engine > },
 #endif
@@ -0,0 +1,1630 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Rtt_LuaLibJSON.h"
+
+#include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#include <emmintrin.h>
+	#define Rtt_JSON_SSE2
+#elif defined( __aarch64__ )
+	#include <arm_neon.h>
+	#define Rtt_JSON_NEON
+#endif
+
+#if defined( _MSC_VER )
+	#include <intrin.h>
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Deeper documents are rejected rather than exhausting the C or Lua stack
+static const int kMaxDepth = 1000;
+
+// ----------------------------------------------------------------------------
+// Pass 1: structural index
+// ----------------------------------------------------------------------------
+
+static inline int
+TrailingZeros( U64 x )
+{
+#if defined( _MSC_VER ) && defined( _M_X64 )
+	unsigned long i;
+	_BitScanForward64( &i, x );
+	return (int)i;
+#elif defined( _MSC_VER )
+	unsigned long i;
+	if ( _BitScanForward( &i, (unsigned long)x ) )
+	{
+		return (int)i;
+	}
+	_BitScanForward( &i, (unsigned long)( x >> 32 ) );
+	return (int)i + 32;
+#else
+	return __builtin_ctzll( x );
+#endif
+}
+
+// Bit i of each mask is set when byte i of a 64-byte block is that character
+struct BlockMasks
+{
+	U64 quote;
+	U64 backslash;
+	U64 op;
+	U64 slash;
+};
+
+#if defined( Rtt_JSON_SSE2 )
+
+static inline void
+ClassifyBlock( const U8 *block, BlockMasks& masks )
+{
+	const __m128i quote = _mm_set1_epi8( '"' );
+	const __m128i backslash = _mm_set1_epi8( '\\' );
+	const __m128i slash = _mm_set1_epi8( '/' );
+	const __m128i colon = _mm_set1_epi8( ':' );
+	const __m128i comma = _mm_set1_epi8( ',' );
+
+	// '[' | 0x20 == '{' and ']' | 0x20 == '}'
+	const __m128i caseBit = _mm_set1_epi8( 0x20 );
+	const __m128i openBrace = _mm_set1_epi8( '{' );
+	const __m128i closeBrace = _mm_set1_epi8( '}' );
+
+	masks.quote = masks.backslash = masks.op = masks.slash = 0;
+	for ( int i = 0; i < 4; i++ )
+	{
+		__m128i v = _mm_loadu_si128( (const __m128i *)( block + 16 * i ) );
+		__m128i folded = _mm_or_si128( v, caseBit );
+		__m128i op = _mm_or_si128(
+			_mm_or_si128( _mm_cmpeq_epi8( folded, openBrace ), _mm_cmpeq_epi8( folded, closeBrace ) ),
+			_mm_or_si128( _mm_cmpeq_epi8( v, colon ), _mm_cmpeq_epi8( v, comma ) ) );
+
+		int shift = 16 * i;
+		masks.quote |= (U64)(U16)_mm_movemask_epi8( _mm_cmpeq_epi8( v, quote ) ) << shift;
+		masks.backslash |= (U64)(U16)_mm_movemask_epi8( _mm_cmpeq_epi8( v, backslash ) ) << shift;
+		masks.op |= (U64)(U16)_mm_movemask_epi8( op ) << shift;
+		masks.slash |= (U64)(U16)_mm_movemask_epi8( _mm_cmpeq_epi8( v, slash ) ) << shift;
+	}
+}
+
+#elif defined( Rtt_JSON_NEON )
+
+static inline U16
+MoveMask( uint8x16_t v )
+{
+	static const uint8_t kBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t masked = vandq_u8( v, vld1q_u8( kBits ) );
+	return (U16)( vaddv_u8( vget_low_u8( masked ) ) | ( vaddv_u8( vget_high_u8( masked ) ) << 8 ) );
+}
+
+static inline void
+ClassifyBlock( const U8 *block, BlockMasks& masks )
+{
+	masks.quote = masks.backslash = masks.op = masks.slash = 0;
+	for ( int i = 0; i < 4; i++ )
+	{
+		uint8x16_t v = vld1q_u8( block + 16 * i );
+		uint8x16_t folded = vorrq_u8( v, vdupq_n_u8( 0x20 ) );
+		uint8x16_t op = vorrq_u8(
+			vorrq_u8( vceqq_u8( folded, vdupq_n_u8( '{' ) ), vceqq_u8( folded, vdupq_n_u8( '}' ) ) ),
+			vorrq_u8( vceqq_u8( v, vdupq_n_u8( ':' ) ), vceqq_u8( v, vdupq_n_u8( ',' ) ) ) );
+
+		int shift = 16 * i;
+		masks.quote |= (U64)MoveMask( vceqq_u8( v, vdupq_n_u8( '"' ) ) ) << shift;
+		masks.backslash |= (U64)MoveMask( vceqq_u8( v, vdupq_n_u8( '\\' ) ) ) << shift;
+		masks.op |= (U64)MoveMask( op ) << shift;
+		masks.slash |= (U64)MoveMask( vceqq_u8( v, vdupq_n_u8( '/' ) ) ) << shift;
+	}
+}
+
+#else
+
+static inline void
+ClassifyBlock( const U8 *block, BlockMasks& masks )
+{
+	masks.quote = masks.backslash = masks.op = masks.slash = 0;
+	for ( int i = 0; i < 64; i++ )
+	{
+		U64 bit = (U64)1 << i;
+		switch ( block[i] )
+		{
+			case '"': masks.quote |= bit; break;
+			case '\\': masks.backslash |= bit; break;
+			case '/': masks.slash |= bit; break;
+			case '{': case '}': case '[': case ']': case ':': case ',': masks.op |= bit; break;
+			default: break;
+		}
+	}
+}
+
+#endif
+
+// Returns the bytes preceded by an odd run of backslashes. prevEscaped
+// carries a backslash at the end of one block into the next.
+static inline U64
+FindEscaped( U64 backslash, U64& prevEscaped )
+{
+	U64 escaped = prevEscaped;
+	backslash &= ~prevEscaped;
+	prevEscaped = 0;
+	while ( backslash )
+	{
+		int i = TrailingZeros( backslash );
+		backslash &= backslash - 1;
+		if ( i == 63 )
+		{
+			prevEscaped = 1;
+		}
+		else
+		{
+			// An escaped backslash doesn't escape what follows it
+			U64 next = (U64)1 << ( i + 1 );
+			escaped |= next;
+			backslash &= ~next;
+		}
+	}
+	return escaped;
+}
+
+// Bit i is the xor of bits 0..i, i.e. set between an opening quote and
+// the byte before its closing quote
+static inline U64
+PrefixXor( U64 x )
+{
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return x;
+}
+
+// Appends the offset of every structural character outside of strings,
+// plus every unescaped quote. Sets hasComments when a '/' appears
+// outside of strings, since comment text would pollute the index.
+static void
+IndexStructurals( const char *data, size_t length, std::vector< U32 >& index, bool& hasComments )
+{
+	index.clear();
+	index.reserve( length / 6 + 16 );
+	hasComments = false;
+
+	U64 prevEscaped = 0;
+	U64 prevInString = 0;
+	U8 tail[64];
+	for ( size_t base = 0; base < length; base += 64 )
+	{
+		const U8 *block = (const U8 *)data + base;
+		if ( length - base < 64 )
+		{
+			memset( tail, ' ', sizeof( tail ) );
+			memcpy( tail, block, length - base );
+			block = tail;
+		}
+
+		BlockMasks masks;
+		ClassifyBlock( block, masks );
+
+		U64 escaped = ( masks.backslash | prevEscaped ) ? FindEscaped( masks.backslash, prevEscaped ) : 0;
+		U64 quote = masks.quote & ~escaped;
+		U64 inString = PrefixXor( quote ) ^ prevInString;
+		prevInString = (U64)( (S64)inString >> 63 );
+
+		if ( masks.slash & ~inString )
+		{
+			hasComments = true;
+		}
+
+		U64 structural = ( masks.op & ~inString ) | quote;
+		while ( structural )
+		{
+			index.push_back( (U32)( base + TrailingZeros( structural ) ) );
+			structural &= structural - 1;
+		}
+	}
+}
+
+// Blanks out // and /* */ comments, keeping offsets and line breaks so
+// error locations still refer to the original text.
+static void
+StripComments( const char *data, size_t length, std::vector< char >& out )
+{
+	out.assign( data, data + length );
+
+	bool inString = false;
+	for ( size_t i = 0; i < length; i++ )
+	{
+		char c = out[i];
+		if ( inString )
+		{
+			if ( c == '\\' )
+			{
+				i++;
+			}
+			else if ( c == '"' )
+			{
+				inString = false;
+			}
+		}
+		else if ( c == '"' )
+		{
+			inString = true;
+		}
+		else if ( c == '/' && i + 1 < length && out[i + 1] == '/' )
+		{
+			for ( ; i < length && out[i] != '\n' && out[i] != '\r'; i++ )
+			{
+				out[i] = ' ';
+			}
+		}
+		else if ( c == '/' && i + 1 < length && out[i + 1] == '*' )
+		{
+			size_t end = i + 2;
+			while ( end + 1 < length && ! ( out[end] == '*' && out[end + 1] == '/' ) )
+			{
+				end++;
+			}
+			end = ( end + 1 < length ) ? end + 2 : length;
+			for ( ; i < end; i++ )
+			{
+				if ( out[i] != '\n' && out[i] != '\r' )
+				{
+					out[i] = ' ';
+				}
+			}
+			i--;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+// Pass 2: parser
+// ----------------------------------------------------------------------------
+
+// Walks the structural index, reporting the document to a Handler:
+//
+//	bool BeginObject(); bool EndObject(); bool ObjectField();
+//	bool BeginArray(); bool EndArray(); bool ArrayElement( int n );
+//	bool Key( const char *s, size_t len );
+//	bool String( const char *s, size_t len );
+//	bool Number( double n ); bool Boolean( bool b ); bool Null();
+//
+// ObjectField() and ArrayElement() follow each member's value. A handler
+// returns false to stop; the parser then fails without a message.
+class JSONParser
+{
+	public:
+		JSONParser( const char *data, size_t length )
+		:	fData( data ),
+			fLength( length ),
+			fNext( 0 ),
+			fPos( 0 ),
+			fError( NULL ),
+			fErrorPos( 0 )
+		{
+		}
+
+	public:
+		template < typename Handler >
+		bool Parse( Handler& handler )
+		{
+			if ( fLength > 0xFFFFFFF0u )
+			{
+				return Fail( "document is too large" );
+			}
+
+			bool hasComments;
+			IndexStructurals( fData, fLength, fIndex, hasComments );
+			if ( hasComments )
+			{
+				StripComments( fData, fLength, fStripped );
+				fData = & fStripped[0];
+				IndexStructurals( fData, fLength, fIndex, hasComments );
+			}
+
+			return ParseValue( handler, 0 );
+		}
+
+		size_t GetPosition() const { return fPos; }
+		const char* GetError() const { return fError; }
+		size_t GetErrorPosition() const { return fErrorPos; }
+
+	private:
+		bool Fail( const char *message )
+		{
+			if ( ! fError )
+			{
+				fError = message;
+				fErrorPos = fPos;
+			}
+			return false;
+		}
+
+		void SkipSpace()
+		{
+			while ( fPos < fLength )
+			{
+				U8 c = (U8)fData[fPos];
+				if ( c == ' ' || c == '\n' || c == '\r' || c == '\t' )
+				{
+					fPos++;
+				}
+				else if ( c == 0xEF && fPos + 2 < fLength && (U8)fData[fPos + 1] == 0xBB && (U8)fData[fPos + 2] == 0xBF )
+				{
+					// UTF-8 byte order mark
+					fPos += 3;
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+
+		// Consumes the structural character at fPos
+		void Consume()
+		{
+			Rtt_ASSERT( fNext < fIndex.size() && fIndex[fNext] == fPos );
+			fNext++;
+			fPos++;
+		}
+
+		template < typename Handler >
+		bool ParseValue( Handler& handler, int depth )
+		{
+			SkipSpace();
+			if ( fPos >= fLength )
+			{
+				return Fail( "value expected" );
+			}
+
+			switch ( fData[fPos] )
+			{
+				case '{':
+					return ParseObject( handler, depth );
+				case '[':
+					return ParseArray( handler, depth );
+				case '"':
+				{
+					const char *s;
+					size_t len;
+					return ParseString( s, len ) && handler.String( s, len );
+				}
+				case 't':
+					return ParseLiteral( "true", 4 ) && handler.Boolean( true );
+				case 'f':
+					return ParseLiteral( "false", 5 ) && handler.Boolean( false );
+				case 'n':
+					return ParseLiteral( "null", 4 ) && handler.Null();
+				default:
+				{
+					double n;
+					return ParseNumber( n ) && handler.Number( n );
+				}
+			}
+		}
+
+		template < typename Handler >
+		bool ParseObject( Handler& handler, int depth )
+		{
+			if ( depth >= kMaxDepth )
+			{
+				return Fail( "too deeply nested" );
+			}
+
+			Consume();
+			if ( ! handler.BeginObject() )
+			{
+				return false;
+			}
+
+			SkipSpace();
+			if ( fPos < fLength && fData[fPos] == '}' )
+			{
+				Consume();
+				return handler.EndObject();
+			}
+
+			while ( true )
+			{
+				SkipSpace();
+				if ( fPos >= fLength || fData[fPos] != '"' )
+				{
+					return Fail( "string expected" );
+				}
+
+				const char *key;
+				size_t len;
+				if ( ! ParseString( key, len ) || ! handler.Key( key, len ) )
+				{
+					return false;
+				}
+
+				SkipSpace();
+				if ( fPos >= fLength || fData[fPos] != ':' )
+				{
+					return Fail( "colon expected" );
+				}
+				Consume();
+
+				if ( ! ParseValue( handler, depth + 1 ) || ! handler.ObjectField() )
+				{
+					return false;
+				}
+
+				SkipSpace();
+				if ( fPos < fLength && fData[fPos] == ',' )
+				{
+					Consume();
+				}
+				else if ( fPos < fLength && fData[fPos] == '}' )
+				{
+					Consume();
+					return handler.EndObject();
+				}
+				else
+				{
+					return Fail( "'}' expected" );
+				}
+			}
+		}
+
+		template < typename Handler >
+		bool ParseArray( Handler& handler, int depth )
+		{
+			if ( depth >= kMaxDepth )
+			{
+				return Fail( "too deeply nested" );
+			}
+
+			Consume();
+			if ( ! handler.BeginArray() )
+			{
+				return false;
+			}
+
+			SkipSpace();
+			if ( fPos < fLength && fData[fPos] == ']' )
+			{
+				Consume();
+				return handler.EndArray();
+			}
+
+			for ( int n = 1; ; n++ )
+			{
+				if ( ! ParseValue( handler, depth + 1 ) || ! handler.ArrayElement( n ) )
+				{
+					return false;
+				}
+
+				SkipSpace();
+				if ( fPos < fLength && fData[fPos] == ',' )
+				{
+					Consume();
+				}
+				else if ( fPos < fLength && fData[fPos] == ']' )
+				{
+					Consume();
+					return handler.EndArray();
+				}
+				else
+				{
+					return Fail( "']' expected" );
+				}
+			}
+		}
+
+		// The closing quote is the next index entry, so the string isn't
+		// scanned unless it has escapes. Those are decoded into fScratch.
+		bool ParseString( const char *& s, size_t& len )
+		{
+			if ( fNext + 1 >= fIndex.size() )
+			{
+				return Fail( "unterminated string" );
+			}
+
+			size_t start = fPos + 1;
+			size_t end = fIndex[fNext + 1];
+			Rtt_ASSERT( fIndex[fNext] == fPos && fData[end] == '"' );
+
+			const char *escape = (const char *)memchr( fData + start, '\\', end - start );
+			if ( ! escape )
+			{
+				s = fData + start;
+				len = end - start;
+			}
+			else
+			{
+				Unescape( start, end, escape - fData );
+				s = fScratch.data();
+				len = fScratch.size();
+			}
+
+			fNext += 2;
+			fPos = end + 1;
+			return true;
+		}
+
+		static int HexValue( const char *p )
+		{
+			int value = 0;
+			for ( int i = 0; i < 4; i++ )
+			{
+				char c = p[i];
+				value <<= 4;
+				if ( c >= '0' && c <= '9' ) { value |= c - '0'; }
+				else if ( c >= 'a' && c <= 'f' ) { value |= c - 'a' + 10; }
+				else if ( c >= 'A' && c <= 'F' ) { value |= c - 'A' + 10; }
+				else { return -1; }
+			}
+			return value;
+		}
+
+		void AppendUTF8( U32 value )
+		{
+			if ( value <= 0x7F )
+			{
+				fScratch += (char)value;
+			}
+			else if ( value <= 0x7FF )
+			{
+				fScratch += (char)( 0xC0 | ( value >> 6 ) );
+				fScratch += (char)( 0x80 | ( value & 0x3F ) );
+			}
+			else if ( value <= 0xFFFF )
+			{
+				fScratch += (char)( 0xE0 | ( value >> 12 ) );
+				fScratch += (char)( 0x80 | ( ( value >> 6 ) & 0x3F ) );
+				fScratch += (char)( 0x80 | ( value & 0x3F ) );
+			}
+			else
+			{
+				fScratch += (char)( 0xF0 | ( value >> 18 ) );
+				fScratch += (char)( 0x80 | ( ( value >> 12 ) & 0x3F ) );
+				fScratch += (char)( 0x80 | ( ( value >> 6 ) & 0x3F ) );
+				fScratch += (char)( 0x80 | ( value & 0x3F ) );
+			}
+		}
+
+		// Escapes are handled like dkjson's decoder: a lone surrogate is
+		// kept as is, and an unknown escape stands for the character itself.
+		void Unescape( size_t start, size_t end, size_t escape )
+		{
+			fScratch.assign( fData + start, escape - start );
+			for ( size_t i = escape; i < end; )
+			{
+				char c = fData[i];
+				if ( c != '\\' )
+				{
+					const char *next = (const char *)memchr( fData + i, '\\', end - i );
+					size_t stop = next ? (size_t)( next - fData ) : end;
+					fScratch.append( fData + i, stop - i );
+					i = stop;
+					continue;
+				}
+
+				char e = fData[i + 1];
+				switch ( e )
+				{
+					case 'b': fScratch += '\b'; break;
+					case 'f': fScratch += '\f'; break;
+					case 'n': fScratch += '\n'; break;
+					case 'r': fScratch += '\r'; break;
+					case 't': fScratch += '\t'; break;
+					case 'u':
+					{
+						int value = ( i + 6 <= end ) ? HexValue( fData + i + 2 ) : -1;
+						if ( value < 0 )
+						{
+							fScratch += 'u';
+							break;
+						}
+
+						U32 codepoint = (U32)value;
+						if ( value >= 0xD800 && value <= 0xDBFF && i + 12 <= end && fData[i + 6] == '\\' && fData[i + 7] == 'u' )
+						{
+							int low = HexValue( fData + i + 8 );
+							if ( low >= 0xDC00 && low <= 0xDFFF )
+							{
+								codepoint = ( ( value - 0xD800 ) << 10 ) + ( low - 0xDC00 ) + 0x10000;
+								i += 6;
+							}
+						}
+						AppendUTF8( codepoint );
+						i += 4;
+						break;
+					}
+					default:
+						fScratch += e;
+						break;
+				}
+				i += 2;
+			}
+		}
+
+		bool ParseLiteral( const char *literal, size_t len )
+		{
+			if ( fLength - fPos < len || memcmp( fData + fPos, literal, len ) != 0 )
+			{
+				return Fail( "value expected" );
+			}
+			fPos += len;
+			return true;
+		}
+
+		static bool IsDigit( char c ) { return c >= '0' && c <= '9'; }
+
+		// Exact for up to 19 significant digits and exponents within
+		// +/-22, which covers nearly every number in practice. The rest go
+		// through strtod().
+		bool ParseNumber( double& result )
+		{
+			static const double kPowersOf10[] =
+			{
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+
+			size_t start = fPos;
+			size_t p = fPos;
+			bool negative = ( p < fLength && fData[p] == '-' );
+			if ( negative )
+			{
+				p++;
+			}
+			if ( p >= fLength || ! IsDigit( fData[p] ) )
+			{
+				return Fail( "value expected" );
+			}
+
+			U64 mantissa = 0;
+			int digits = 0;
+			int exponent = 0;
+			bool isExact = true;
+
+			if ( fData[p] == '0' )
+			{
+				p++;
+			}
+			else
+			{
+				for ( ; p < fLength && IsDigit( fData[p] ); p++ )
+				{
+					if ( digits < 19 )
+					{
+						mantissa = mantissa * 10 + ( fData[p] - '0' );
+						digits++;
+					}
+					else
+					{
+						exponent++;
+						isExact = false;
+					}
+				}
+			}
+
+			if ( p < fLength && fData[p] == '.' )
+			{
+				for ( p++; p < fLength && IsDigit( fData[p] ); p++ )
+				{
+					if ( mantissa == 0 && fData[p] == '0' )
+					{
+						exponent--;
+					}
+					else if ( digits < 19 )
+					{
+						mantissa = mantissa * 10 + ( fData[p] - '0' );
+						digits++;
+						exponent--;
+					}
+					else
+					{
+						isExact = false;
+					}
+				}
+			}
+
+			if ( p < fLength && ( fData[p] == 'e' || fData[p] == 'E' ) )
+			{
+				p++;
+				bool negativeExponent = false;
+				if ( p < fLength && ( fData[p] == '+' || fData[p] == '-' ) )
+				{
+					negativeExponent = ( fData[p] == '-' );
+					p++;
+				}
+				if ( p >= fLength || ! IsDigit( fData[p] ) )
+				{
+					fPos = p;
+					return Fail( "value expected" );
+				}
+
+				int value = 0;
+				for ( ; p < fLength && IsDigit( fData[p] ); p++ )
+				{
+					if ( value < 100000 )
+					{
+						value = value * 10 + ( fData[p] - '0' );
+					}
+				}
+				exponent += negativeExponent ? -value : value;
+			}
+
+			if ( isExact && mantissa <= ( (U64)1 << 53 ) && exponent >= -22 && exponent <= 22 )
+			{
+				double value = (double)mantissa;
+				value = ( exponent < 0 ) ? value / kPowersOf10[-exponent] : value * kPowersOf10[exponent];
+				result = negative ? -value : value;
+			}
+			else
+			{
+				// strtod() follows the C locale's decimal point
+				std::string text( fData + start, p - start );
+				const char *point = localeconv()->decimal_point;
+				size_t dot = text.find( '.' );
+				if ( dot != std::string::npos && point && point[0] != '.' )
+				{
+					text.replace( dot, 1, point );
+				}
+				result = strtod( text.c_str(), NULL );
+			}
+
+			fPos = p;
+			return true;
+		}
+
+	private:
+		const char *fData;
+		size_t fLength;
+		std::vector< U32 > fIndex;
+		size_t fNext;
+		size_t fPos;
+		std::vector< char > fStripped;
+		std::string fScratch;
+		const char *fError;
+		size_t fErrorPos;
+};
+
+// ----------------------------------------------------------------------------
+// Handlers
+// ----------------------------------------------------------------------------
+
+// Builds the decoded value on the Lua stack, the way dkjson does: null is
+// nullval, and tables get the object and array metatables when given.
+class TableBuilder
+{
+	public:
+		TableBuilder( lua_State *L, int nullIndex, int objectMetaIndex, int arrayMetaIndex )
+		:	fL( L ),
+			fNullIndex( nullIndex ),
+			fObjectMetaIndex( objectMetaIndex ),
+			fArrayMetaIndex( arrayMetaIndex )
+		{
+		}
+
+	public:
+		bool BeginObject() { return BeginTable( fObjectMetaIndex ); }
+		bool EndObject() { return true; }
+		bool BeginArray() { return BeginTable( fArrayMetaIndex ); }
+		bool EndArray() { return true; }
+
+		bool ObjectField()
+		{
+			if ( lua_isnil( fL, -1 ) )
+			{
+				lua_pop( fL, 2 );
+			}
+			else
+			{
+				lua_rawset( fL, -3 );
+			}
+			return true;
+		}
+
+		bool ArrayElement( int n )
+		{
+			if ( lua_isnil( fL, -1 ) )
+			{
+				lua_pop( fL, 1 );
+			}
+			else
+			{
+				lua_rawseti( fL, -2, n );
+			}
+			return true;
+		}
+
+		bool Key( const char *s, size_t len ) { lua_pushlstring( fL, s, len ); return true; }
+		bool String( const char *s, size_t len ) { lua_pushlstring( fL, s, len ); return true; }
+		bool Number( double n ) { lua_pushnumber( fL, n ); return true; }
+		bool Boolean( bool b ) { lua_pushboolean( fL, b ); return true; }
+		bool Null() { lua_pushvalue( fL, fNullIndex ); return true; }
+
+	private:
+		bool BeginTable( int metaIndex )
+		{
+			if ( ! lua_checkstack( fL, 4 ) )
+			{
+				return false;
+			}
+
+			lua_newtable( fL );
+			if ( metaIndex )
+			{
+				lua_pushvalue( fL, metaIndex );
+				lua_setmetatable( fL, -2 );
+			}
+			return true;
+		}
+
+	private:
+		lua_State *fL;
+		int fNullIndex;
+		int fObjectMetaIndex;
+		int fArrayMetaIndex;
+};
+
+// Calls the functions of a handler table for each event instead of
+// building tables. Callbacks run protected; an error stops the parse and
+// is re-raised once the parser is gone.
+class EventDispatcher
+{
+	public:
+		enum Event
+		{
+			kObjectStart = 0,
+			kObjectEnd,
+			kArrayStart,
+			kArrayEnd,
+			kKey,
+			kValue,
+
+			kNumEvents
+		};
+
+		// Pushes the handler's functions
+		EventDispatcher( lua_State *L, int handlerIndex )
+		:	fL( L ),
+			fHasError( false )
+		{
+			static const char *kNames[kNumEvents] =
+			{
+				"onObjectStart", "onObjectEnd", "onArrayStart", "onArrayEnd", "onKey", "onValue"
+			};
+
+			luaL_checkstack( L, kNumEvents + 4, "json handler" );
+			fBase = lua_gettop( L ) + 1;
+			for ( int i = 0; i < kNumEvents; i++ )
+			{
+				lua_getfield( L, handlerIndex, kNames[i] );
+			}
+		}
+
+	public:
+		bool BeginObject() { return Call( kObjectStart, 0 ); }
+		bool EndObject() { return Call( kObjectEnd, 0 ); }
+		bool BeginArray() { return Call( kArrayStart, 0 ); }
+		bool EndArray() { return Call( kArrayEnd, 0 ); }
+		bool ObjectField() { return true; }
+		bool ArrayElement( int n ) { return true; }
+
+		bool Key( const char *s, size_t len )
+		{
+			if ( ! HasCallback( kKey ) ) { return true; }
+			lua_pushlstring( fL, s, len );
+			return Call( kKey, 1 );
+		}
+
+		bool String( const char *s, size_t len )
+		{
+			if ( ! HasCallback( kValue ) ) { return true; }
+			lua_pushlstring( fL, s, len );
+			return Call( kValue, 1 );
+		}
+
+		bool Number( double n )
+		{
+			if ( ! HasCallback( kValue ) ) { return true; }
+			lua_pushnumber( fL, n );
+			return Call( kValue, 1 );
+		}
+
+		bool Boolean( bool b )
+		{
+			if ( ! HasCallback( kValue ) ) { return true; }
+			lua_pushboolean( fL, b );
+			return Call( kValue, 1 );
+		}
+
+		bool Null()
+		{
+			if ( ! HasCallback( kValue ) ) { return true; }
+			lua_pushnil( fL );
+			return Call( kValue, 1 );
+		}
+
+		bool HasError() const { return fHasError; }
+
+	private:
+		bool HasCallback( Event event ) const
+		{
+			return ! lua_isnil( fL, fBase + event );
+		}
+
+		// The arguments are on top of the stack
+		bool Call( Event event, int nargs )
+		{
+			if ( ! HasCallback( event ) )
+			{
+				lua_pop( fL, nargs );
+				return true;
+			}
+
+			lua_pushvalue( fL, fBase + event );
+			lua_insert( fL, -1 - nargs );
+			if ( lua_pcall( fL, nargs, 0, 0 ) != 0 )
+			{
+				// Leaves the error message on the stack
+				fHasError = true;
+				return false;
+			}
+			return true;
+		}
+
+	private:
+		lua_State *fL;
+		int fBase;
+		bool fHasError;
+};
+
+// ----------------------------------------------------------------------------
+// Encoder
+// ----------------------------------------------------------------------------
+
+// Produces the same text as dkjson's encoder with no state. Returns false
+// for anything it leaves to dkjson: __tojson and __jsonorder metamethods,
+// unsupported types and keys, and reference cycles.
+class JSONEncoder
+{
+	public:
+		JSONEncoder( lua_State *L, int nullIndex )
+		:	fL( L ),
+			fNullIndex( nullIndex )
+		{
+			const char *point = localeconv()->decimal_point;
+			fDecimalPoint = ( point && point[0] ) ? point[0] : '.';
+		}
+
+	public:
+		bool Encode( int index ) { return EncodeValue( index, 0 ); }
+		const std::string& GetResult() const { return fOut; }
+
+	private:
+		bool EncodeValue( int index, int depth )
+		{
+			switch ( lua_type( fL, index ) )
+			{
+				case LUA_TNIL:
+					fOut += "null";
+					return true;
+				case LUA_TBOOLEAN:
+					fOut += lua_toboolean( fL, index ) ? "true" : "false";
+					return true;
+				case LUA_TNUMBER:
+					AppendNumber( lua_tonumber( fL, index ) );
+					return true;
+				case LUA_TSTRING:
+				{
+					size_t len;
+					const char *s = lua_tolstring( fL, index, &len );
+					AppendString( s, len );
+					return true;
+				}
+				case LUA_TTABLE:
+					if ( fNullIndex && lua_rawequal( fL, index, fNullIndex ) )
+					{
+						fOut += "null";
+						return true;
+					}
+					return EncodeTable( index, depth );
+				default:
+					return false;
+			}
+		}
+
+		bool EncodeTable( int index, int depth )
+		{
+			const void *table = lua_topointer( fL, index );
+			if ( depth >= kMaxDepth )
+			{
+				return false;
+			}
+			for ( size_t i = 0; i < fPath.size(); i++ )
+			{
+				if ( fPath[i] == table )
+				{
+					return false;
+				}
+			}
+
+			if ( ! lua_checkstack( fL, 6 ) )
+			{
+				return false;
+			}
+
+			bool isObjectType = false;
+			if ( lua_getmetatable( fL, index ) )
+			{
+				lua_getfield( fL, -1, "__tojson" );
+				lua_getfield( fL, -2, "__jsonorder" );
+				bool isCustom = ! lua_isnil( fL, -1 ) || ! lua_isnil( fL, -2 );
+				lua_getfield( fL, -3, "__jsontype" );
+				const char *type = lua_tostring( fL, -1 );
+				isObjectType = ( type && strcmp( type, "object" ) == 0 );
+				lua_pop( fL, 4 );
+				if ( isCustom )
+				{
+					return false;
+				}
+			}
+
+			// Same rules as dkjson's isarray()
+			bool isArray = true;
+			double max = 0;
+			double arrayLength = 0;
+			double count = 0;
+			lua_pushnil( fL );
+			while ( lua_next( fL, index ) )
+			{
+				int keyType = lua_type( fL, -2 );
+				if ( keyType == LUA_TSTRING && lua_type( fL, -1 ) == LUA_TNUMBER && strcmp( lua_tostring( fL, -2 ), "n" ) == 0 )
+				{
+					arrayLength = lua_tonumber( fL, -1 );
+					if ( arrayLength > max )
+					{
+						max = arrayLength;
+					}
+				}
+				else
+				{
+					double k = ( keyType == LUA_TNUMBER ) ? lua_tonumber( fL, -2 ) : 0;
+					if ( keyType != LUA_TNUMBER || k < 1 || floor( k ) != k )
+					{
+						lua_pop( fL, 2 );
+						isArray = false;
+						break;
+					}
+					if ( k > max )
+					{
+						max = k;
+					}
+					count++;
+				}
+				lua_pop( fL, 1 );
+			}
+			if ( isArray && max > 10 && max > arrayLength && max > count * 2 )
+			{
+				isArray = false;
+			}
+			if ( max == 0 && isObjectType )
+			{
+				isArray = false;
+			}
+
+			fPath.push_back( table );
+			bool result = isArray ? EncodeArray( index, (int)floor( max ), depth ) : EncodeObject( index, depth );
+			fPath.pop_back();
+			return result;
+		}
+
+		bool EncodeArray( int index, int n, int depth )
+		{
+			fOut += '[';
+			for ( int i = 1; i <= n; i++ )
+			{
+				lua_rawgeti( fL, index, i );
+				bool result = EncodeValue( lua_gettop( fL ), depth + 1 );
+				lua_pop( fL, 1 );
+				if ( ! result )
+				{
+					return false;
+				}
+				if ( i < n )
+				{
+					fOut += ',';
+				}
+			}
+			fOut += ']';
+			return true;
+		}
+
+		bool EncodeObject( int index, int depth )
+		{
+			fOut += '{';
+			bool isFirst = true;
+			lua_pushnil( fL );
+			while ( lua_next( fL, index ) )
+			{
+				if ( ! isFirst )
+				{
+					fOut += ',';
+				}
+				isFirst = false;
+
+				// Number keys are formatted here, since lua_tolstring() on the
+				// key itself would break the traversal
+				int keyType = lua_type( fL, -2 );
+				if ( keyType == LUA_TSTRING )
+				{
+					size_t len;
+					const char *s = lua_tolstring( fL, -2, &len );
+					AppendString( s, len );
+				}
+				else if ( keyType == LUA_TNUMBER )
+				{
+					char buf[64];
+					int len = snprintf( buf, sizeof( buf ), LUA_NUMBER_FMT, lua_tonumber( fL, -2 ) );
+					AppendString( buf, (size_t)len );
+				}
+				else
+				{
+					lua_pop( fL, 2 );
+					return false;
+				}
+				fOut += ':';
+
+				if ( ! EncodeValue( lua_gettop( fL ), depth + 1 ) )
+				{
+					lua_pop( fL, 2 );
+					return false;
+				}
+				lua_pop( fL, 1 );
+			}
+			fOut += '}';
+			return true;
+		}
+
+		// Like tostring(), with '.' whatever the locale
+		void AppendNumber( double value )
+		{
+			if ( value != value || value >= HUGE_VAL || -value >= HUGE_VAL )
+			{
+				fOut += "null";
+				return;
+			}
+
+			char buf[64];
+			if ( value == floor( value ) && fabs( value ) < 1e14 && ( value != 0 || 1 / value > 0 ) )
+			{
+				// Integers print the same with %.14g, without the formatting
+				char *end = buf + sizeof( buf );
+				char *p = end;
+				U64 n = (U64)fabs( value );
+				do
+				{
+					*--p = (char)( '0' + n % 10 );
+					n /= 10;
+				}
+				while ( n );
+				if ( value < 0 )
+				{
+					*--p = '-';
+				}
+				fOut.append( p, end - p );
+				return;
+			}
+
+			int len = snprintf( buf, sizeof( buf ), LUA_NUMBER_FMT, value );
+			for ( int i = 0; i < len; i++ )
+			{
+				if ( buf[i] == fDecimalPoint )
+				{
+					buf[i] = '.';
+				}
+			}
+			fOut.append( buf, len );
+		}
+
+		void AppendEscape( U32 codepoint )
+		{
+			static const char kHex[] = "0123456789abcdef";
+			char buf[6] = { '\\', 'u', kHex[( codepoint >> 12 ) & 0xF], kHex[( codepoint >> 8 ) & 0xF], kHex[( codepoint >> 4 ) & 0xF], kHex[codepoint & 0xF] };
+			fOut.append( buf, 6 );
+		}
+
+		// Returns how many bytes of a character starting at s dkjson would
+		// escape (0 if none), and its code point
+		static size_t SpecialCharacter( const U8 *s, size_t remaining, U32& codepoint )
+		{
+			U8 a = s[0];
+			U8 b = remaining > 1 ? s[1] : 0;
+			U8 c = remaining > 2 ? s[2] : 0;
+			switch ( a )
+			{
+				case 0xC2:
+					if ( ( b >= 0x80 && b <= 0x9F ) || b == 0xAD ) { codepoint = b; return 2; }
+					break;
+				case 0xD8:
+					if ( b >= 0x80 && b <= 0x84 ) { codepoint = 0x600 + ( b - 0x80 ); return 2; }
+					break;
+				case 0xDC:
+					if ( b == 0x8F ) { codepoint = 0x70F; return 2; }
+					break;
+				case 0xE1:
+					if ( b == 0x9E && ( c == 0xB4 || c == 0xB5 ) ) { codepoint = 0x17B4 + ( c - 0xB4 ); return 3; }
+					break;
+				case 0xE2:
+					if ( b == 0x80 && ( ( c >= 0x8C && c <= 0x8F ) || ( c >= 0xA8 && c <= 0xAF ) ) ) { codepoint = 0x2000 + ( c - 0x80 ); return 3; }
+					if ( b == 0x81 && c >= 0xA0 && c <= 0xAF ) { codepoint = 0x2040 + ( c - 0x80 ); return 3; }
+					break;
+				case 0xEF:
+					if ( b == 0xBB && c == 0xBF ) { codepoint = 0xFEFF; return 3; }
+					if ( b == 0xBF && c >= 0xB0 && c <= 0xBF ) { codepoint = 0xFFC0 + ( c - 0x80 ); return 3; }
+					break;
+				default:
+					break;
+			}
+			return 0;
+		}
+
+		// Escapes what dkjson's quotestring() does: control characters,
+		// quote, backslash, DEL, and code points that JavaScript treats as
+		// line breaks or that are invisible
+		void AppendString( const char *str, size_t len )
+		{
+			static bool sNeedsCheck[256];
+			static bool sIsInitialized = false;
+			if ( ! sIsInitialized )
+			{
+				for ( int i = 0; i < 256; i++ )
+				{
+					sNeedsCheck[i] = ( i < 0x20 || i == '"' || i == '\\' || i == 0x7F
+						|| i == 0xC2 || i == 0xD8 || i == 0xDC || i == 0xE1 || i == 0xE2 || i == 0xEF );
+				}
+				sIsInitialized = true;
+			}
+
+			const U8 *s = (const U8 *)str;
+			fOut.reserve( fOut.size() + len + 2 );
+			fOut += '"';
+
+			size_t run = 0;
+			for ( size_t i = 0; i < len; i++ )
+			{
+				U8 ch = s[i];
+				if ( ! sNeedsCheck[ch] )
+				{
+					continue;
+				}
+
+				const char *simple = NULL;
+				U32 codepoint = ch;
+				size_t width = 1;
+				switch ( ch )
+				{
+					case '"': simple = "\\\""; break;
+					case '\\': simple = "\\\\"; break;
+					case '\b': simple = "\\b"; break;
+					case '\f': simple = "\\f"; break;
+					case '\n': simple = "\\n"; break;
+					case '\r': simple = "\\r"; break;
+					case '\t': simple = "\\t"; break;
+					default:
+						if ( ch >= 0x80 )
+						{
+							width = SpecialCharacter( s + i, len - i, codepoint );
+						}
+						break;
+				}
+				if ( width == 0 )
+				{
+					continue;
+				}
+
+				fOut.append( str + run, i - run );
+				if ( simple )
+				{
+					fOut += simple;
+				}
+				else
+				{
+					AppendEscape( codepoint );
+				}
+				i += width - 1;
+				run = i + 1;
+			}
+			fOut.append( str + run, len - run );
+			fOut += '"';
+		}
+
+	private:
+		lua_State *fL;
+		int fNullIndex;
+		char fDecimalPoint;
+		std::string fOut;
+		std::vector< const void * > fPath;
+};
+
+// ----------------------------------------------------------------------------
+// Lua functions
+// ----------------------------------------------------------------------------
+
+static bool
+ReadFile( const char *path, std::vector< char >& contents )
+{
+	FILE *f = fopen( path, "rb" );
+	if ( ! f )
+	{
+		return false;
+	}
+
+	fseek( f, 0, SEEK_END );
+	long size = ftell( f );
+	fseek( f, 0, SEEK_SET );
+
+	bool result = ( size >= 0 );
+	if ( result )
+	{
+		contents.resize( (size_t)size );
+		result = ( size == 0 || fread( & contents[0], 1, (size_t)size, f ) == (size_t)size );
+	}
+	fclose( f );
+	return result;
+}
+
+// "line 3, column 14", like dkjson's loc()
+static void
+PushErrorMessage( lua_State *L, const char *data, size_t pos, const char *message )
+{
+	int line = 1;
+	size_t lineStart = 0;
+	for ( size_t i = 0; i < pos; i++ )
+	{
+		if ( data[i] == '\n' )
+		{
+			line++;
+			lineStart = i + 1;
+		}
+	}
+	lua_pushfstring( L, "%s at line %d, column %d", message, line, (int)( pos - lineStart + 1 ) );
+}
+
+// Returns value, pos or nil, pos, message. Positions are 1-based in the
+// whole string; data starts at offset.
+static int
+DecodeBuffer( lua_State *L, const char *data, size_t length, size_t offset, int nullIndex, int objectMetaIndex, int arrayMetaIndex )
+{
+	int top = lua_gettop( L );
+	bool result;
+	size_t pos;
+	const char *error;
+	{
+		JSONParser parser( data, length );
+		TableBuilder builder( L, nullIndex, objectMetaIndex, arrayMetaIndex );
+		result = parser.Parse( builder );
+		pos = result ? parser.GetPosition() : parser.GetErrorPosition();
+		error = parser.GetError();
+	}
+
+	if ( result )
+	{
+		lua_pushinteger( L, (lua_Integer)( offset + pos + 1 ) );
+		return 2;
+	}
+
+	lua_settop( L, top );
+	lua_pushnil( L );
+	lua_pushinteger( L, (lua_Integer)( offset + pos + 1 ) );
+	PushErrorMessage( L, data, pos, error ? error : "invalid JSON" );
+	return 3;
+}
+
+static int
+MetatableIndex( lua_State *L, int index )
+{
+	return lua_istable( L, index ) ? index : 0;
+}
+
+// native.decode( str [, pos [, nullval [, objectmeta [, arraymeta]]]] )
+static int
+decode( lua_State *L )
+{
+	size_t length;
+	const char *data = luaL_checklstring( L, 1, &length );
+	lua_Integer pos = luaL_optinteger( L, 2, 1 );
+	size_t offset = ( pos > 1 && (size_t)( pos - 1 ) < length ) ? (size_t)( pos - 1 ) : length;
+	offset = ( pos > 1 ) ? offset : 0;
+	lua_settop( L, 5 );
+
+	return DecodeBuffer( L, data + offset, length - offset, offset, 3, MetatableIndex( L, 4 ), MetatableIndex( L, 5 ) );
+}
+
+// native.decodeFile( path [, pos [, nullval [, objectmeta [, arraymeta]]]] )
+//
+// Reads the file into a native buffer, so it never becomes a Lua string.
+static int
+decodeFile( lua_State *L )
+{
+	const char *path = luaL_checkstring( L, 1 );
+	lua_Integer pos = luaL_optinteger( L, 2, 1 );
+	lua_settop( L, 5 );
+
+	std::vector< char > contents;
+	if ( ! ReadFile( path, contents ) )
+	{
+		lua_pushnil( L );
+		lua_pushinteger( L, 0 );
+		lua_pushfstring( L, "Cannot open file %s", path );
+		return 3;
+	}
+
+	size_t offset = ( pos > 1 && (size_t)( pos - 1 ) < contents.size() ) ? (size_t)( pos - 1 ) : contents.size();
+	offset = ( pos > 1 ) ? offset : 0;
+	const char *data = contents.empty() ? "" : & contents[0];
+	return DecodeBuffer( L, data + offset, contents.size() - offset, offset, 3, MetatableIndex( L, 4 ), MetatableIndex( L, 5 ) );
+}
+
+// Returns true, pos or nil, pos, message. Raises a handler's error after
+// the parser has been destroyed.
+static int
+ScanBuffer( lua_State *L, const char *data, size_t length, int handlerIndex )
+{
+	int top = lua_gettop( L );
+	bool result;
+	bool hasHandlerError;
+	size_t pos;
+	const char *error;
+	{
+		JSONParser parser( data, length );
+		EventDispatcher dispatcher( L, handlerIndex );
+		result = parser.Parse( dispatcher );
+		hasHandlerError = dispatcher.HasError();
+		pos = result ? parser.GetPosition() : parser.GetErrorPosition();
+		error = parser.GetError();
+	}
+
+	if ( hasHandlerError )
+	{
+		return lua_error( L );
+	}
+
+	lua_settop( L, top );
+	if ( result )
+	{
+		lua_pushboolean( L, 1 );
+		lua_pushinteger( L, (lua_Integer)( pos + 1 ) );
+		return 2;
+	}
+
+	lua_pushnil( L );
+	lua_pushinteger( L, (lua_Integer)( pos + 1 ) );
+	PushErrorMessage( L, data, pos, error ? error : "invalid JSON" );
+	return 3;
+}
+
+// native.scan( str, handler )
+//
+// handler may have onObjectStart(), onObjectEnd(), onArrayStart(),
+// onArrayEnd(), onKey( key ) and onValue( value ); null is passed as nil.
+static int
+scan( lua_State *L )
+{
+	size_t length;
+	const char *data = luaL_checklstring( L, 1, &length );
+	luaL_checktype( L, 2, LUA_TTABLE );
+	lua_settop( L, 2 );
+
+	return ScanBuffer( L, data, length, 2 );
+}
+
+// native.scanFile( path, handler )
+static int
+scanFile( lua_State *L )
+{
+	const char *path = luaL_checkstring( L, 1 );
+	luaL_checktype( L, 2, LUA_TTABLE );
+	lua_settop( L, 2 );
+
+	// Not on this frame: a handler's error must not skip its destructor
+	std::vector< char > *contents = new std::vector< char >();
+	if ( ! ReadFile( path, *contents ) )
+	{
+		delete contents;
+		lua_pushnil( L );
+		lua_pushinteger( L, 0 );
+		lua_pushfstring( L, "Cannot open file %s", path );
+		return 3;
+	}
+
+	// Owned by a userdata from here on, so an error still frees it
+	std::vector< char > **holder = (std::vector< char > **)lua_newuserdata( L, sizeof( std::vector< char > * ) );
+	*holder = contents;
+	luaL_getmetatable( L, "json.native.buffer" );
+	lua_setmetatable( L, -2 );
+
+	const char *data = contents->empty() ? "" : & (*contents)[0];
+	return ScanBuffer( L, data, contents->size(), 2 );
+}
+
+static int
+bufferGC( lua_State *L )
+{
+	std::vector< char > **holder = (std::vector< char > **)lua_touserdata( L, 1 );
+	delete *holder;
+	*holder = NULL;
+	return 0;
+}
+
+// native.encode( value [, null] )
+//
+// Returns nothing when the value needs dkjson, see JSONEncoder.
+static int
+encode( lua_State *L )
+{
+	lua_settop( L, 2 );
+
+	bool result;
+	{
+		JSONEncoder encoder( L, lua_istable( L, 2 ) ? 2 : 0 );
+		result = encoder.Encode( 1 );
+		if ( result )
+		{
+			const std::string& text = encoder.GetResult();
+			lua_pushlstring( L, text.data(), text.size() );
+		}
+	}
+	return result ? 1 : 0;
+}
+
+int
+LuaLibJSON::Open( lua_State *L )
+{
+	const luaL_Reg kVTable[] =
+	{
+		{ "decode", decode },
+		{ "decodeFile", decodeFile },
+		{ "scan", scan },
+		{ "scanFile", scanFile },
+		{ "encode", encode },
+
+		{ NULL, NULL }
+	};
+
+	luaL_newmetatable( L, "json.native.buffer" );
+	lua_pushcfunction( L, bufferGC );
+	lua_setfield( L, -2, "__gc" );
+	lua_pop( L, 1 );
+
+	// A module of json.lua, so it doesn't define a global
+	lua_newtable( L );
+	luaL_register( L, NULL, kVTable );
+
+	return 1;
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef __Rtt_LuaLibJSON__
+#define __Rtt_LuaLibJSON__
+
+#include "Rtt_Lua.h"
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Native codec behind the "json" module, loaded as "json.native".
+//
+// Decoding runs in two passes. The first finds every structural character
+// ({}[]:, and unescaped quotes) outside of strings, 64 bytes at a time
+// with SSE2 or NEON where available. The second walks that index to build
+// tables directly, so string ends are known without scanning for them,
+// and strings without escapes are pushed straight from the input.
+//
+// json.lua uses it for the common cases and falls back to dkjson for the
+// rest (encode state, __tojson, unsupported types), so results match.
+class LuaLibJSON
+{
+	public:
+		typedef LuaLibJSON Self;
+
+	public:
+		static int Open( lua_State *L );
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // __Rtt_LuaLibJSON__
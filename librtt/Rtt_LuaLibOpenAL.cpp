@@ -99,9 +99,7 @@ loadSoundAll( lua_State *L )
 		@endcode
 	*/
 		
-	/* TODO: We might want to cache loadAll files in a map so if a user loads it multiple times,
-	 * we don't waste memory with duplicates. This will not work with loadStream files though.
-	 */
+	/* Loading the same path again shares the decoded data; see PlatformOpenALPlayer::LoadAll */
 	ALmixer_Data* sound_data = NULL;
 	const MPlatform & platform = LuaContext::GetRuntime( L )->Platform();
 	PlatformOpenALPlayer* openal_player = PlatformOpenALPlayer::SharedInstance();
@@ -310,6 +308,116 @@ freeData( lua_State *L )
 	return 0;
 }
 
+static int
+preloadSounds( lua_State *L )
+{
+	/**
+	 @fn preloadSounds(lua_Table file_names, [baseDir])
+	 @brief Decodes files into the sound cache ahead of time.
+	 @details Files are decoded one per frame so a long list doesn't stall the app. A later
+	 audio.loadSound() of any of them then returns at once. Preloaded sounds count against the
+	 cache limit like any other unused sound, so preloading more than the limit holds evicts the earliest.
+	 @param file_names An array of file names.
+	 @code
+	 audio.preloadSounds({ "laserBlast.wav", "explosion.ogg" })
+	 @endcode
+	 */
+	luaL_checktype( L, 1, LUA_TTABLE );
+
+	Runtime* runtime = LuaContext::GetRuntime( L );
+	const MPlatform & platform = runtime->Platform();
+	MPlatform::Directory baseDir = MPlatform::kResourceDir;
+	if ( lua_islightuserdata( L, 2 ) )
+	{
+		baseDir = (MPlatform::Directory)EnumForUserdata(
+			LuaLibSystem::Directories(),
+			lua_touserdata( L, 2 ),
+			MPlatform::kNumDirs,
+			MPlatform::kResourceDir );
+	}
+
+	std::vector< std::string > filePaths;
+	for ( int i = 1, iMax = (int)lua_objlen( L, 1 ); i <= iMax; i++ )
+	{
+		lua_rawgeti( L, 1, i );
+		const char* filename = lua_tostring( L, -1 );
+		if ( filename )
+		{
+			String filePath( & platform.GetAllocator() );
+			platform.PathForFile( filename, baseDir, MPlatform::kDefaultPathFlags, filePath );
+			if ( filePath.GetString() )
+			{
+				filePaths.push_back( filePath.GetString() );
+			}
+			else
+			{
+				CoronaLuaWarning( L, "audio.preloadSounds() could not find '%s'", filename );
+			}
+		}
+		lua_pop( L, 1 );
+	}
+
+	PlatformOpenALPlayer* openal_player = PlatformOpenALPlayer::SharedInstance();
+	openal_player->Preload( runtime->GetScheduler(), filePaths );
+
+	return 0;
+}
+
+static int
+setCacheLimit( lua_State *L )
+{
+	/**
+	 @fn setCacheLimit(lua_Number number_of_bytes)
+	 @brief Sets how much decoded audio may be held before disposed sounds are freed.
+	 @details Sounds from audio.loadSound() stay decoded after the last audio.dispose(), so loading
+	 them again is free. Once the decoded audio held in total exceeds this limit, the least recently
+	 disposed sounds are freed. Sounds in use are never freed. Pass 0 to free sounds as soon as they
+	 are disposed. The default is 8 MB.
+	 @param number_of_bytes The limit in bytes.
+	 @code
+	 audio.setCacheLimit( 16 * 1024 * 1024 )
+	 @endcode
+	 */
+	lua_Number number_of_bytes = luaL_checknumber( L, 1 );
+	PlatformOpenALPlayer* openal_player = PlatformOpenALPlayer::SharedInstance();
+	openal_player->SetCacheLimit( number_of_bytes > 0 ? (size_t)number_of_bytes : 0 );
+
+	return 0;
+}
+
+static int
+getCacheStats( lua_State *L )
+{
+	/**
+	 @fn getCacheStats()
+	 @brief Returns how well the sound cache is doing.
+	 @details Returns a table with hits (loads that didn't decode), misses (loads that did),
+	 evictions, bytes (decoded audio held), unusedBytes (the part held only by the cache) and limit.
+	 @code
+	 local stats = audio.getCacheStats()
+	 print( stats.hits, stats.misses )
+	 @endcode
+	 */
+	PlatformOpenALPlayer* openal_player = PlatformOpenALPlayer::SharedInstance();
+	const PlatformOpenALPlayer::CacheStats& stats = openal_player->GetCacheStats();
+
+	lua_createtable( L, 0, 6 );
+	lua_pushinteger( L, stats.hits );
+	lua_setfield( L, -2, "hits" );
+	lua_pushinteger( L, stats.misses );
+	lua_setfield( L, -2, "misses" );
+	lua_pushinteger( L, stats.evictions );
+	lua_setfield( L, -2, "evictions" );
+	lua_pushnumber( L, (lua_Number)stats.bytes );
+	lua_setfield( L, -2, "bytes" );
+	lua_pushnumber( L, (lua_Number)stats.unusedBytes );
+	lua_setfield( L, -2, "unusedBytes" );
+	lua_pushnumber( L, (lua_Number)openal_player->GetCacheLimit() );
+	lua_setfield( L, -2, "limit" );
+
+	return 1;
+}
+
 static int
 playChannelTimed( lua_State *L )
 {
@@ -2153,6 +2261,9 @@ LuaLibOpenAL::Initialize( lua_State *L )
 		{ "loadSound", loadSoundAll },
 		{ "loadStream", loadSoundStream },
 		{ "dispose", freeData },
+		{ "preloadSounds", preloadSounds },
+		{ "setCacheLimit", setCacheLimit },
+		{ "getCacheStats", getCacheStats },
 		{ "play", playChannelTimed },
 		{ "pause", pauseChannel },
 		{ "resume", resumeChannel },
@@ -12,10 +12,14 @@
 #include "Rtt_LuaLibSystem.h"
 
 #include "Display/Rtt_Display.h"
+#include "Display/Rtt_FramePacing.h"
 #include "Display/Rtt_TextureFactory.h"
+#include "Rtt_FileIOQueue.h"
 #include "Rtt_LuaContext.h"
 #include "Display/Rtt_LuaLibDisplay.h"
 #include "Rtt_LuaProxy.h"
+#include "Rtt_LuaResource.h"
+#include "Rtt_LuaSerializer.h"
 #include "Rtt_MPlatform.h"
 #include "Rtt_MPlatformDevice.h"
 
@@ -23,6 +27,7 @@
 #include "Rtt_GPU.h"
 #include "Rtt_RenderingStream.h"
 #include "Rtt_PreferenceCollection.h"
+#include "Core/Rtt_FileSystem.h"
 #include "Core/Rtt_String.h"
 #include "Input/Rtt_PlatformInputDeviceManager.h"
 #include "Input/Rtt_PlatformInputDevice.h"
@@ -32,7 +37,9 @@
 
 #include <locale>
 #include <locale.h>
+#include <stdio.h>
 #include <string.h>
+#include <string>
 #include <vector>
 
 #include "Rtt_Lua.h"
@@ -389,6 +396,11 @@ LuaLibSystem::getInfo( lua_State *L )
 		TextureFactory& factory = LuaContext::GetRuntime( L )->GetDisplay().GetTextureFactory();
 		lua_pushinteger( L, factory.GetTextureMemoryUsed() );
 	}
+	else if ( Rtt_StringCompare( key, "textureMemoryBudget" ) == 0 )
+	{
+		TextureFactory& factory = LuaContext::GetRuntime( L )->GetDisplay().GetTextureFactory();
+		lua_pushinteger( L, factory.GetTextureMemoryBudget() );
+	}
 	else if ( Rtt_StringCompare( key, "maxTextureSize" ) == 0 )
 	{
 		Runtime *runtime = LuaContext::GetRuntime( L );
@@ -599,6 +611,27 @@ getTimer( lua_State *L )
     return 1;
 }
 
+// system.getFrameStats( [options] )
+// options.warnings = false turns off the budget warnings in the log.
+static int
+getFrameStats( lua_State *L )
+{
+    FramePacing& pacing = LuaContext::GetRuntime( L )->GetDisplay().GetFramePacing();
+
+    if ( lua_istable( L, 1 ) )
+    {
+        lua_getfield( L, 1, "warnings" );
+        if ( lua_isboolean( L, -1 ) )
+        {
+            pacing.SetWarningEnabled( lua_toboolean( L, -1 ) );
+        }
+        lua_pop( L, 1 );
+    }
+
+    pacing.Push( L );
+    return 1;
+}
+
 static int
 vibrate( lua_State *L )
 {
@@ -1081,6 +1114,317 @@ deletePreferences( lua_State *L )
     return 1;
 }
 
+// system.flushPreferences()
+static int
+flushPreferences( lua_State *L )
+{
+    const char* kApiName = "system.flushPreferences()";
+
+    // Write preferences the platform hasn't saved yet before returning.
+    OperationResult flushResult = LuaContext::GetPlatform( L ).FlushPreferences();
+    if ( flushResult.HasFailed() )
+    {
+        CoronaLuaError( L, "%s - %s", kApiName, flushResult.GetUtf8Message() );
+    }
+
+    lua_pushboolean( L, flushResult.HasSucceeded() ? 1 : 0 );
+    return 1;
+}
+
+// Pushes the path for { filename=, baseDir= } at index, where baseDir defaults
+// to system.DocumentsDirectory. Returns false, pushing nothing, if the table
+// has no filename.
+static bool
+PushPathForOptions( lua_State *L, int index, bool isWrite, MPlatform::Directory& baseDir )
+{
+    lua_getfield( L, index, "filename" );
+    const char *filename = lua_tostring( L, -1 );
+    if ( ! filename )
+    {
+        lua_pop( L, 1 );
+        return false;
+    }
+
+    lua_getfield( L, index, "baseDir" );
+    baseDir = LuaLibSystem::ToDirectory( L, -1, MPlatform::kDocumentsDir );
+    lua_pop( L, 1 );
+
+    const MPlatform& platform = LuaContext::GetPlatform( L );
+    String path( & platform.GetAllocator() );
+    platform.PathForFile( filename, baseDir, isWrite ? MPlatform::kDefaultPathFlags : MPlatform::kTestFileExists, path );
+    lua_pop( L, 1 );
+
+    lua_pushstring( L, path.GetString() );
+    return true;
+}
+
+// system.serialize( value [, options] )
+//
+// options.compress compresses the data. With options.filename (and
+// options.baseDir), the data is written to that file and true is returned;
+// otherwise it's returned as a string. Returns nil and a message if the
+// file can't be written.
+static int
+serialize( lua_State *L )
+{
+    const char kApiName[] = "system.serialize()";
+
+    U32 flags = 0;
+    bool hasPath = false;
+    if ( lua_istable( L, 2 ) )
+    {
+        lua_getfield( L, 2, "compress" );
+        flags |= lua_toboolean( L, -1 ) ? LuaSerializer::kCompress : 0;
+        lua_pop( L, 1 );
+
+        MPlatform::Directory baseDir;
+        hasPath = PushPathForOptions( L, 2, true, baseDir );
+        if ( hasPath && ! LuaLibSystem::IsWritableDirectory( baseDir ) )
+        {
+            lua_pushnil( L );
+            lua_pushfstring( L, "%s - baseDir is not writable", kApiName );
+            return 2;
+        }
+    }
+    int pathIndex = lua_gettop( L );
+
+    // Results are pushed before anything is raised, so bytes is destroyed
+    bool hasSucceeded;
+    int result;
+    {
+        std::string bytes;
+        hasSucceeded = LuaSerializer::Serialize( L, 1, flags, bytes );
+        if ( ! hasSucceeded )
+        {
+            result = 0;
+        }
+        else if ( ! hasPath )
+        {
+            lua_pushlstring( L, bytes.data(), bytes.size() );
+            result = 1;
+        }
+        else if ( 0 == FileIOTask::WriteFile( lua_tostring( L, pathIndex ), bytes.data(), bytes.size() ) )
+        {
+            lua_pushboolean( L, 1 );
+            result = 1;
+        }
+        else
+        {
+            lua_pushnil( L );
+            lua_pushfstring( L, "%s - could not write '%s'", kApiName, lua_tostring( L, pathIndex ) );
+            result = 2;
+        }
+    }
+
+    if ( ! hasSucceeded )
+    {
+        return luaL_error( L, "%s - %s", kApiName, lua_tostring( L, -1 ) );
+    }
+    return result;
+}
+
+// system.deserialize( bytes )
+// system.deserialize( { filename=, baseDir= } )
+//
+// Returns the value, or nil and a message if the data can't be read. A file
+// is decoded straight from its contents, without a Lua string.
+static int
+deserialize( lua_State *L )
+{
+    const char kApiName[] = "system.deserialize()";
+
+    if ( lua_type( L, 1 ) == LUA_TSTRING )
+    {
+        size_t length;
+        const char *bytes = lua_tolstring( L, 1, &length );
+        if ( LuaSerializer::Deserialize( L, (const U8 *)bytes, length ) )
+        {
+            return 1;
+        }
+
+        lua_pushnil( L );
+        lua_pushfstring( L, "%s - data is damaged or not from system.serialize()", kApiName );
+        return 2;
+    }
+
+    MPlatform::Directory baseDir;
+    if ( ! lua_istable( L, 1 ) || ! PushPathForOptions( L, 1, false, baseDir ) )
+    {
+        luaL_argerror( L, 1, "string or table with a filename expected" );
+    }
+    const char *path = lua_tostring( L, -1 );
+
+    bool hasSucceeded = false;
+    bool hasOpened = false;
+    {
+        std::vector< U8 > contents;
+        FILE *f = ( Rtt_StringIsEmpty( path ) ? NULL : Rtt_FileOpen( path, "rb" ) );
+        if ( f )
+        {
+            Rtt_FileSeek( f, 0, SEEK_END );
+            long size = Rtt_FileTell( f );
+            Rtt_FileSeek( f, 0, SEEK_SET );
+
+            hasOpened = ( size >= 0 );
+            if ( hasOpened )
+            {
+                contents.resize( (size_t)size );
+                hasOpened = ( size == 0 || Rtt_FileRead( & contents[0], 1, (size_t)size, f ) == (size_t)size );
+            }
+            Rtt_FileClose( f );
+        }
+
+        if ( hasOpened )
+        {
+            hasSucceeded = LuaSerializer::Deserialize( L, contents.empty() ? NULL : & contents[0], contents.size() );
+        }
+    }
+
+    if ( hasSucceeded )
+    {
+        return 1;
+    }
+
+    lua_pushnil( L );
+    if ( hasOpened )
+    {
+        lua_pushfstring( L, "%s - '%s' is damaged or not from system.serialize()", kApiName, path );
+    }
+    else
+    {
+        lua_pushfstring( L, "%s - could not read '%s'", kApiName, path ? path : "" );
+    }
+    return 2;
+}
+
+// Pushes the path for the filename [, baseDir] arguments at index. Returns
+// the index of the argument after them, or 0 if index isn't a filename.
+static int
+PushPathForArguments( lua_State *L, int index, MPlatform::Directory defaultDir, MPlatform::Directory& baseDir )
+{
+    if ( lua_type( L, index ) != LUA_TSTRING )
+    {
+        return 0;
+    }
+
+    const char *filename = lua_tostring( L, index );
+    int next = index + 1;
+    baseDir = defaultDir;
+    if ( lua_islightuserdata( L, next ) )
+    {
+        baseDir = LuaLibSystem::ToDirectory( L, next, defaultDir );
+        next++;
+    }
+
+    const MPlatform& platform = LuaContext::GetPlatform( L );
+    String path( & platform.GetAllocator() );
+    platform.PathForFile( filename, baseDir, MPlatform::kDefaultPathFlags, path );
+    lua_pushstring( L, path.GetString() );
+    return next;
+}
+
+// Queues a task for the listener at listenerIndex, if there is one. data is
+// copied, since the Lua string may be collected before the task runs.
+static void
+AppendFileIOTask( lua_State *L, FileIOTask::Type type, const char *path, const char *srcPath, int listenerIndex, const char *data, size_t length )
+{
+    Runtime& runtime = * LuaContext::GetRuntime( L );
+
+    LuaResource *listener = NULL;
+    if ( Lua::IsListener( L, listenerIndex, FileIOEvent::kName ) )
+    {
+        listener = Rtt_NEW( runtime.Allocator(), LuaResource( LuaContext::GetContext( L )->LuaState(), listenerIndex ) );
+    }
+
+    FileIOTask *task = Rtt_NEW( runtime.Allocator(), FileIOTask( type, path, srcPath, listener ) );
+    if ( data )
+    {
+        task->GetData().assign( data, length );
+    }
+    runtime.GetFileIOQueue().Append( task );
+}
+
+// system.readFileAsync( filename [, baseDir], listener )
+//
+// Reads the file on the I/O thread. The listener receives a "fileIO" event
+// with the contents in event.data, or event.isError and event.errorMessage.
+// baseDir defaults to system.ResourceDirectory.
+static int
+readFileAsync( lua_State *L )
+{
+    MPlatform::Directory baseDir;
+    int listenerIndex = PushPathForArguments( L, 1, MPlatform::kResourceDir, baseDir );
+    if ( ! listenerIndex )
+    {
+        luaL_argerror( L, 1, "filename expected" );
+    }
+    if ( ! Lua::IsListener( L, listenerIndex, FileIOEvent::kName ) )
+    {
+        luaL_argerror( L, listenerIndex, "listener expected" );
+    }
+
+    AppendFileIOTask( L, FileIOTask::kRead, lua_tostring( L, -1 ), NULL, listenerIndex, NULL, 0 );
+    lua_pushboolean( L, 1 );
+    return 1;
+}
+
+// system.writeFileAsync( filename [, baseDir], data [, listener] )
+//
+// Replaces the file with data on the I/O thread. The file is written under
+// a temporary name first, so it's never left half written. baseDir
+// defaults to system.DocumentsDirectory.
+static int
+writeFileAsync( lua_State *L )
+{
+    MPlatform::Directory baseDir;
+    int dataIndex = PushPathForArguments( L, 1, MPlatform::kDocumentsDir, baseDir );
+    if ( ! dataIndex )
+    {
+        luaL_argerror( L, 1, "filename expected" );
+    }
+    if ( ! LuaLibSystem::IsWritableDirectory( baseDir ) )
+    {
+        luaL_argerror( L, 2, "baseDir is not writable" );
+    }
+
+    size_t length;
+    const char *data = luaL_checklstring( L, dataIndex, &length );
+    AppendFileIOTask( L, FileIOTask::kWrite, lua_tostring( L, -1 ), NULL, dataIndex + 1, data, length );
+    lua_pushboolean( L, 1 );
+    return 1;
+}
+
+// system.copyFileAsync( srcFilename [, srcBaseDir], dstFilename [, dstBaseDir] [, listener] )
+//
+// srcBaseDir defaults to system.ResourceDirectory and dstBaseDir to
+// system.DocumentsDirectory.
+static int
+copyFileAsync( lua_State *L )
+{
+    MPlatform::Directory srcBaseDir;
+    int dstIndex = PushPathForArguments( L, 1, MPlatform::kResourceDir, srcBaseDir );
+    if ( ! dstIndex )
+    {
+        luaL_argerror( L, 1, "filename expected" );
+    }
+    int srcPathIndex = lua_gettop( L );
+
+    MPlatform::Directory dstBaseDir;
+    int listenerIndex = PushPathForArguments( L, dstIndex, MPlatform::kDocumentsDir, dstBaseDir );
+    if ( ! listenerIndex )
+    {
+        luaL_argerror( L, dstIndex, "filename expected" );
+    }
+    if ( ! LuaLibSystem::IsWritableDirectory( dstBaseDir ) )
+    {
+        luaL_argerror( L, dstIndex + 1, "baseDir is not writable" );
+    }
+
+    AppendFileIOTask( L, FileIOTask::kCopy, lua_tostring( L, -1 ), lua_tostring( L, srcPathIndex ), listenerIndex, NULL, 0 );
+    lua_pushboolean( L, 1 );
+    return 1;
+}
+
 static int
 gcNotification( lua_State *L )
 {
@@ -1679,6 +2023,7 @@ LuaLibSystem::Initialize( lua_State *L )
         { "hasEventSource", LuaLibSystem::HasEventSource }, // private
         { "getInfo", getInfo },
         { "getTimer", getTimer },
+        { "getFrameStats", getFrameStats },
         { "openURL", openURL },
         { "canOpenURL", canOpenURL },
         { "vibrate", vibrate },
@@ -1689,6 +2034,12 @@ LuaLibSystem::Initialize( lua_State *L )
         { "setPreferences", setPreferences },
         { "deletePreference", deletePreference },
         { "deletePreferences", deletePreferences },
+        { "flushPreferences", flushPreferences },
+        { "serialize", serialize },
+        { "deserialize", deserialize },
+        { "readFileAsync", readFileAsync },
+        { "writeFileAsync", writeFileAsync },
+        { "copyFileAsync", copyFileAsync },
         { "scheduleNotification", scheduleNotification },
         { "cancelNotification", cancelNotification },
         { "request", request },
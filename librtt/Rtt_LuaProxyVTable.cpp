@@ -1836,9 +1836,10 @@ LuaGroupObjectProxyVTable::PushMethod( lua_State *L, const GroupObject& o, const
         "setAsSizedGroupWithCurrentSize",    // 3
         "numChildren",        // 4
         "anchorChildren",    // 5
+        "isStatic",            // 6
     };
     static const int numKeys = sizeof( keys ) / sizeof( const char * );
-    static StringHash sHash( *LuaContext::GetAllocator( L ), keys, numKeys, 6, 1, 1, __FILE__, __LINE__ );
+    static StringHash sHash( *LuaContext::GetAllocator( L ), keys, numKeys, 7, 1, 1, __FILE__, __LINE__ );
     StringHash *hash = &sHash;
 
     int index = hash->Lookup( key );
@@ -1881,6 +1882,12 @@ LuaGroupObjectProxyVTable::PushMethod( lua_State *L, const GroupObject& o, const
             result = 1;
         }
         break;
+    case 6:
+        {
+            lua_pushboolean( L, o.IsStatic() );
+            result = 1;
+        }
+        break;
 
     default:
         {
@@ -1945,6 +1952,11 @@ LuaGroupObjectProxyVTable::SetValueForKey( lua_State *L, MLuaProxyable& object,
         GroupObject& o = static_cast< GroupObject& >( object );
         o.SetAnchorChildren( !! lua_toboolean( L, valueIndex ) );
     }
+    else if ( 0 == strcmp( key, "isStatic" ) )
+    {
+        GroupObject& o = static_cast< GroupObject& >( object );
+        o.SetStatic( !! lua_toboolean( L, valueIndex ) );
+    }
     else
     {
         result = Super::SetValueForKey( L, object, key, valueIndex );
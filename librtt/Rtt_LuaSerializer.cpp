@@ -0,0 +1,716 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+
+#include "Rtt_LuaSerializer.h"
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Layout:
+//
+//	"RTTS", version, flags
+//	if flags has kCompress: varint size, then an LZ4 block of that size
+//	value
+//
+// A value is a tag followed by its data. Tables hold varint n, then
+// elements 1..n, then key/value pairs up to a kNil key. Every table, and
+// every string of kMinSharedLength or more, gets the next id the first
+// time it's written; later occurrences are a kReference to that id.
+static const char kMagic[] = "RTTS";
+static const U8 kVersion = 1;
+static const size_t kHeaderLength = 6;
+static const size_t kMinSharedLength = 4;
+static const int kMaxDepth = 1000;
+
+enum
+{
+	kNil = 0,
+	kFalse,
+	kTrue,
+	kInteger,
+	kDouble,
+	kString,
+	kTable,
+	kReference
+};
+
+// ----------------------------------------------------------------------------
+// LZ4 block format
+// ----------------------------------------------------------------------------
+
+static inline U32
+Read32( const U8 *p )
+{
+	U32 value;
+	memcpy( &value, p, sizeof( value ) );
+	return value;
+}
+
+static void
+WriteLength( std::string& out, size_t length )
+{
+	for ( ; length >= 255; length -= 255 )
+	{
+		out += (char)255;
+	}
+	out += (char)length;
+}
+
+static void
+WriteSequence( std::string& out, const U8 *literals, size_t literalLength, size_t offset, size_t matchLength )
+{
+	size_t matchCode = matchLength - 4;
+	U8 token = (U8)( ( Min( literalLength, (size_t)15 ) << 4 ) | Min( matchCode, (size_t)15 ) );
+	out += (char)token;
+	if ( literalLength >= 15 )
+	{
+		WriteLength( out, literalLength - 15 );
+	}
+	out.append( (const char *)literals, literalLength );
+	out += (char)( offset & 0xFF );
+	out += (char)( offset >> 8 );
+	if ( matchCode >= 15 )
+	{
+		WriteLength( out, matchCode - 15 );
+	}
+}
+
+// Greedy single-probe matcher. Favors speed over ratio, which suits save
+// data written every few seconds.
+static void
+CompressLZ4( const U8 *src, size_t length, std::string& out )
+{
+	const int kHashBits = 12;
+	std::vector< U32 > table( 1 << kHashBits, 0 );
+
+	// The format requires the last match to start 12 bytes before the end
+	// and the last 5 bytes to be literals
+	const size_t kMatchStartLimit = length > 12 ? length - 12 : 0;
+	const size_t kMatchEndLimit = length > 5 ? length - 5 : 0;
+
+	size_t anchor = 0;
+	size_t i = 0;
+	while ( i < kMatchStartLimit )
+	{
+		U32 sequence = Read32( src + i );
+		U32 hash = ( sequence * 2654435761u ) >> ( 32 - kHashBits );
+		size_t candidate = table[hash];
+		table[hash] = (U32)i;
+
+		if ( candidate >= i || i - candidate > 0xFFFF || Read32( src + candidate ) != sequence )
+		{
+			i++;
+			continue;
+		}
+
+		size_t matchLength = 4;
+		while ( i + matchLength < kMatchEndLimit && src[candidate + matchLength] == src[i + matchLength] )
+		{
+			matchLength++;
+		}
+		while ( i > anchor && candidate > 0 && src[i - 1] == src[candidate - 1] )
+		{
+			i--;
+			candidate--;
+			matchLength++;
+		}
+
+		WriteSequence( out, src + anchor, i - anchor, i - candidate, matchLength );
+		i += matchLength;
+		anchor = i;
+	}
+
+	size_t literalLength = length - anchor;
+	out += (char)( Min( literalLength, (size_t)15 ) << 4 );
+	if ( literalLength >= 15 )
+	{
+		WriteLength( out, literalLength - 15 );
+	}
+	out.append( (const char *)src + anchor, literalLength );
+}
+
+static bool
+ReadLength( const U8 *& p, const U8 *end, size_t& length )
+{
+	U8 byte;
+	do
+	{
+		if ( p >= end )
+		{
+			return false;
+		}
+		byte = *p++;
+		length += byte;
+	}
+	while ( byte == 255 );
+	return true;
+}
+
+// Fails rather than reading or writing out of bounds on damaged input
+static bool
+DecompressLZ4( const U8 *src, size_t length, U8 *dst, size_t dstLength )
+{
+	const U8 *p = src;
+	const U8 *end = src + length;
+	U8 *out = dst;
+	U8 *outEnd = dst + dstLength;
+
+	while ( p < end )
+	{
+		U8 token = *p++;
+
+		size_t literalLength = token >> 4;
+		if ( literalLength == 15 && ! ReadLength( p, end, literalLength ) )
+		{
+			return false;
+		}
+		if ( literalLength > (size_t)( end - p ) || literalLength > (size_t)( outEnd - out ) )
+		{
+			return false;
+		}
+		memcpy( out, p, literalLength );
+		p += literalLength;
+		out += literalLength;
+
+		if ( p == end )
+		{
+			break;
+		}
+
+		if ( end - p < 2 )
+		{
+			return false;
+		}
+		size_t offset = p[0] | ( p[1] << 8 );
+		p += 2;
+		if ( offset == 0 || offset > (size_t)( out - dst ) )
+		{
+			return false;
+		}
+
+		size_t matchLength = token & 0xF;
+		if ( matchLength == 15 && ! ReadLength( p, end, matchLength ) )
+		{
+			return false;
+		}
+		matchLength += 4;
+		if ( matchLength > (size_t)( outEnd - out ) )
+		{
+			return false;
+		}
+
+		const U8 *match = out - offset;
+		if ( offset >= matchLength )
+		{
+			memcpy( out, match, matchLength );
+			out += matchLength;
+		}
+		else
+		{
+			// Overlapping copy repeats the last offset bytes
+			for ( size_t i = 0; i < matchLength; i++ )
+			{
+				*out++ = match[i];
+			}
+		}
+	}
+
+	return out == outEnd;
+}
+
+// ----------------------------------------------------------------------------
+// Writer
+// ----------------------------------------------------------------------------
+
+static void
+WriteVarint( std::string& out, U64 value )
+{
+	while ( value >= 0x80 )
+	{
+		out += (char)( ( value & 0x7F ) | 0x80 );
+		value >>= 7;
+	}
+	out += (char)value;
+}
+
+class LuaSerializerWriter
+{
+	public:
+		LuaSerializerWriter( lua_State *L, std::string& out )
+		:	fL( L ),
+			fOut( out ),
+			fSeenIndex( 0 ),
+			fNextId( 0 )
+		{
+		}
+
+	public:
+		bool Write( int index )
+		{
+			lua_newtable( fL );
+			fSeenIndex = lua_gettop( fL );
+
+			bool result = WriteValue( index, 0 );
+			lua_remove( fL, fSeenIndex );
+			return result;
+		}
+
+		const std::string& GetError() const { return fError; }
+
+	private:
+		bool Fail( const char *message )
+		{
+			fError = message;
+			return false;
+		}
+
+		// Writes a reference if the value was seen before. Otherwise gives it
+		// the next id and returns false.
+		bool WriteReference( int index )
+		{
+			lua_pushvalue( fL, index );
+			lua_rawget( fL, fSeenIndex );
+			if ( lua_isnumber( fL, -1 ) )
+			{
+				U64 id = (U64)lua_tonumber( fL, -1 );
+				lua_pop( fL, 1 );
+				fOut += (char)kReference;
+				WriteVarint( fOut, id );
+				return true;
+			}
+			lua_pop( fL, 1 );
+
+			lua_pushvalue( fL, index );
+			lua_pushnumber( fL, (lua_Number)( ++fNextId ) );
+			lua_rawset( fL, fSeenIndex );
+			return false;
+		}
+
+		void WriteNumber( lua_Number value )
+		{
+			// Whole numbers, the common case, are stored as zigzag varints
+			if ( value == floor( value ) && fabs( value ) <= 9007199254740992.0 && ( value != 0 || 1 / value > 0 ) )
+			{
+				S64 n = (S64)value;
+				fOut += (char)kInteger;
+				WriteVarint( fOut, ( (U64)n << 1 ) ^ (U64)( n >> 63 ) );
+				return;
+			}
+
+			double d = value;
+			U64 bits;
+			memcpy( &bits, &d, sizeof( bits ) );
+
+			char bytes[8];
+			for ( int i = 0; i < 8; i++ )
+			{
+				bytes[i] = (char)( bits >> ( 8 * i ) );
+			}
+			fOut += (char)kDouble;
+			fOut.append( bytes, sizeof( bytes ) );
+		}
+
+		bool WriteValue( int index, int depth )
+		{
+			switch ( lua_type( fL, index ) )
+			{
+				case LUA_TNIL:
+					fOut += (char)kNil;
+					return true;
+				case LUA_TBOOLEAN:
+					fOut += (char)( lua_toboolean( fL, index ) ? kTrue : kFalse );
+					return true;
+				case LUA_TNUMBER:
+					WriteNumber( lua_tonumber( fL, index ) );
+					return true;
+				case LUA_TSTRING:
+				{
+					size_t length;
+					const char *s = lua_tolstring( fL, index, &length );
+					if ( length >= kMinSharedLength && WriteReference( index ) )
+					{
+						return true;
+					}
+					fOut += (char)kString;
+					WriteVarint( fOut, length );
+					fOut.append( s, length );
+					return true;
+				}
+				case LUA_TTABLE:
+					return WriteTable( index, depth );
+				default:
+					fError = "values of type '";
+					fError += luaL_typename( fL, index );
+					fError += "' can't be serialized";
+					return false;
+			}
+		}
+
+		bool WriteTable( int index, int depth )
+		{
+			if ( WriteReference( index ) )
+			{
+				return true;
+			}
+			if ( depth >= kMaxDepth || ! lua_checkstack( fL, 4 ) )
+			{
+				return Fail( "tables are nested too deeply to be serialized" );
+			}
+
+			size_t n = lua_objlen( fL, index );
+			fOut += (char)kTable;
+			WriteVarint( fOut, n );
+			for ( size_t i = 1; i <= n; i++ )
+			{
+				lua_rawgeti( fL, index, (int)i );
+				bool result = WriteValue( lua_gettop( fL ), depth + 1 );
+				lua_pop( fL, 1 );
+				if ( ! result )
+				{
+					return false;
+				}
+			}
+
+			lua_pushnil( fL );
+			while ( lua_next( fL, index ) )
+			{
+				int key = lua_gettop( fL ) - 1;
+				if ( lua_type( fL, key ) == LUA_TNUMBER )
+				{
+					lua_Number k = lua_tonumber( fL, key );
+					if ( k >= 1 && k <= (lua_Number)n && k == floor( k ) )
+					{
+						// Already written as an element
+						lua_pop( fL, 1 );
+						continue;
+					}
+				}
+
+				if ( ! WriteValue( key, depth + 1 ) || ! WriteValue( key + 1, depth + 1 ) )
+				{
+					lua_pop( fL, 2 );
+					return false;
+				}
+				lua_pop( fL, 1 );
+			}
+			fOut += (char)kNil;
+			return true;
+		}
+
+	private:
+		lua_State *fL;
+		std::string& fOut;
+		int fSeenIndex;
+		U64 fNextId;
+		std::string fError;
+};
+
+// ----------------------------------------------------------------------------
+// Reader
+// ----------------------------------------------------------------------------
+
+class LuaSerializerReader
+{
+	public:
+		LuaSerializerReader( lua_State *L, const U8 *data, size_t length )
+		:	fL( L ),
+			fPos( data ),
+			fEnd( data + length ),
+			fRefsIndex( 0 ),
+			fNextId( 0 )
+		{
+		}
+
+	public:
+		// Pushes the value on success; leaves the stack as it was otherwise
+		bool Read()
+		{
+			int top = lua_gettop( fL );
+			lua_newtable( fL );
+			fRefsIndex = lua_gettop( fL );
+
+			bool result = ReadValue( 0 ) && fPos == fEnd;
+			if ( result )
+			{
+				lua_remove( fL, fRefsIndex );
+			}
+			else
+			{
+				lua_settop( fL, top );
+			}
+			return result;
+		}
+
+	private:
+		bool ReadVarint( U64& value )
+		{
+			value = 0;
+			for ( int shift = 0; shift < 64; shift += 7 )
+			{
+				if ( fPos >= fEnd )
+				{
+					return false;
+				}
+				U8 byte = *fPos++;
+				value |= (U64)( byte & 0x7F ) << shift;
+				if ( ! ( byte & 0x80 ) )
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void AddReference()
+		{
+			lua_pushvalue( fL, -1 );
+			lua_rawseti( fL, fRefsIndex, (int)( ++fNextId ) );
+		}
+
+		bool ReadValue( int depth )
+		{
+			if ( fPos >= fEnd )
+			{
+				return false;
+			}
+
+			switch ( *fPos++ )
+			{
+				case kNil:
+					lua_pushnil( fL );
+					return true;
+				case kFalse:
+					lua_pushboolean( fL, 0 );
+					return true;
+				case kTrue:
+					lua_pushboolean( fL, 1 );
+					return true;
+				case kInteger:
+				{
+					U64 zigzag;
+					if ( ! ReadVarint( zigzag ) )
+					{
+						return false;
+					}
+					S64 n = (S64)( zigzag >> 1 ) ^ -(S64)( zigzag & 1 );
+					lua_pushnumber( fL, (lua_Number)n );
+					return true;
+				}
+				case kDouble:
+				{
+					if ( fEnd - fPos < 8 )
+					{
+						return false;
+					}
+					U64 bits = 0;
+					for ( int i = 0; i < 8; i++ )
+					{
+						bits |= (U64)fPos[i] << ( 8 * i );
+					}
+					fPos += 8;
+
+					double d;
+					memcpy( &d, &bits, sizeof( d ) );
+					lua_pushnumber( fL, (lua_Number)d );
+					return true;
+				}
+				case kString:
+				{
+					U64 length;
+					if ( ! ReadVarint( length ) || length > (U64)( fEnd - fPos ) )
+					{
+						return false;
+					}
+					lua_pushlstring( fL, (const char *)fPos, (size_t)length );
+					fPos += length;
+					if ( length >= kMinSharedLength )
+					{
+						AddReference();
+					}
+					return true;
+				}
+				case kTable:
+					return ReadTable( depth );
+				case kReference:
+				{
+					U64 id;
+					if ( ! ReadVarint( id ) || id == 0 || id > fNextId )
+					{
+						return false;
+					}
+					lua_rawgeti( fL, fRefsIndex, (int)id );
+					return true;
+				}
+				default:
+					return false;
+			}
+		}
+
+		bool ReadTable( int depth )
+		{
+			U64 n;
+			// Each element takes at least a byte
+			if ( depth >= kMaxDepth || ! lua_checkstack( fL, 4 ) || ! ReadVarint( n ) || n > (U64)( fEnd - fPos ) )
+			{
+				return false;
+			}
+
+			lua_createtable( fL, (int)n, 0 );
+			AddReference();
+			int table = lua_gettop( fL );
+
+			for ( U64 i = 1; i <= n; i++ )
+			{
+				if ( ! ReadValue( depth + 1 ) )
+				{
+					return false;
+				}
+				if ( lua_isnil( fL, -1 ) )
+				{
+					lua_pop( fL, 1 );
+				}
+				else
+				{
+					lua_rawseti( fL, table, (int)i );
+				}
+			}
+
+			while ( true )
+			{
+				if ( ! ReadValue( depth + 1 ) )
+				{
+					return false;
+				}
+				if ( lua_isnil( fL, -1 ) )
+				{
+					lua_pop( fL, 1 );
+					return true;
+				}
+
+				// lua_rawset() raises an error for a NaN key
+				if ( lua_type( fL, -1 ) == LUA_TNUMBER && lua_tonumber( fL, -1 ) != lua_tonumber( fL, -1 ) )
+				{
+					return false;
+				}
+				if ( ! ReadValue( depth + 1 ) )
+				{
+					return false;
+				}
+				lua_rawset( fL, table );
+			}
+		}
+
+	private:
+		lua_State *fL;
+		const U8 *fPos;
+		const U8 *fEnd;
+		int fRefsIndex;
+		U64 fNextId;
+};
+
+// ----------------------------------------------------------------------------
+
+bool
+LuaSerializer::Serialize( lua_State *L, int index, U32 flags, std::string& out )
+{
+	if ( index < 0 )
+	{
+		// Get positive indices
+		index = lua_gettop( L ) + index + 1;
+	}
+
+	std::string payload;
+	LuaSerializerWriter writer( L, payload );
+	if ( ! writer.Write( index ) )
+	{
+		const std::string& error = writer.GetError();
+		lua_pushlstring( L, error.data(), error.size() );
+		return false;
+	}
+
+	out.append( kMagic, 4 );
+	out += (char)kVersion;
+	out += (char)( flags & kCompress );
+	if ( flags & kCompress )
+	{
+		WriteVarint( out, payload.size() );
+		CompressLZ4( (const U8 *)payload.data(), payload.size(), out );
+	}
+	else
+	{
+		out += payload;
+	}
+	return true;
+}
+
+bool
+LuaSerializer::Deserialize( lua_State *L, const U8 *data, size_t length )
+{
+	if ( length < kHeaderLength || memcmp( data, kMagic, 4 ) != 0 || data[4] != kVersion || ( data[5] & ~kCompress ) )
+	{
+		return false;
+	}
+
+	const U8 *payload = data + kHeaderLength;
+	size_t payloadLength = length - kHeaderLength;
+	if ( ! ( data[5] & kCompress ) )
+	{
+		LuaSerializerReader reader( L, payload, payloadLength );
+		return reader.Read();
+	}
+
+	// Read the size by hand; a reader isn't needed for one varint
+	U64 size = 0;
+	const U8 *p = payload;
+	const U8 *end = payload + payloadLength;
+	for ( int shift = 0; ; shift += 7 )
+	{
+		if ( p >= end || shift >= 64 )
+		{
+			return false;
+		}
+		size |= (U64)( *p & 0x7F ) << shift;
+		if ( ! ( *p++ & 0x80 ) )
+		{
+			break;
+		}
+	}
+
+	// LZ4 can't expand by more than 255 times
+	size_t compressedLength = end - p;
+	if ( size > (U64)compressedLength * 255 + 16 )
+	{
+		return false;
+	}
+
+	std::vector< U8 > buffer( (size_t)size );
+	if ( ! DecompressLZ4( p, compressedLength, buffer.empty() ? NULL : & buffer[0], buffer.size() ) )
+	{
+		return false;
+	}
+
+	LuaSerializerReader reader( L, buffer.empty() ? NULL : & buffer[0], buffer.size() );
+	return reader.Read();
+}
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef __Rtt_LuaSerializer__
+#define __Rtt_LuaSerializer__
+
+#include "Rtt_Lua.h"
+
+#include <string>
+
+// ----------------------------------------------------------------------------
+
+namespace Rtt
+{
+
+// ----------------------------------------------------------------------------
+
+// Compact binary form of Lua values, used by system.serialize() and
+// system.deserialize().
+//
+// Nil, booleans, numbers, strings and tables are supported. A table or
+// string that appears more than once is written once and referred to by
+// index afterwards, so shared references and cycles survive a round trip.
+// Metatables are not saved.
+//
+// The payload may be compressed with the LZ4 block format.
+class LuaSerializer
+{
+	public:
+		typedef LuaSerializer Self;
+
+	public:
+		typedef enum _Flags
+		{
+			kCompress = 0x1
+		}
+		Flags;
+
+	public:
+		// Appends the value at index to out. Returns false, pushing an error
+		// message, if the value holds something that can't be serialized.
+		static bool Serialize( lua_State *L, int index, U32 flags, std::string& out );
+
+		// Pushes the value stored in data. Returns false, pushing nothing, if
+		// data is not in this format or is damaged.
+		static bool Deserialize( lua_State *L, const U8 *data, size_t length );
+};
+
+// ----------------------------------------------------------------------------
+
+} // namespace Rtt
+
+// ----------------------------------------------------------------------------
+
+#endif // __Rtt_LuaSerializer__
@@ -132,6 +132,9 @@ class MPlatform
 		virtual OperationResult SetPreferences( const char* categoryName, const PreferenceCollection& collection ) const = 0;
 		virtual OperationResult DeletePreferences( const char* categoryName, const char** keyNameArray, U32 keyNameCount ) const = 0;
 
+		// Platforms that write preferences in the background save them before returning
+		virtual OperationResult FlushPreferences() const { return OperationResult::kSucceeded; }
+
     
 		virtual void SetIdleTimer( bool enabled ) const = 0;
 		virtual bool GetIdleTimer() const = 0;
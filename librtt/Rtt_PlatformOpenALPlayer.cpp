@@ -146,9 +146,16 @@ PlatformOpenALPlayer::PlatformOpenALPlayer()
 	mapOfLoadedFileNamesToData(NULL),
 	mapOfLoadedDataToFileNames(NULL),
 	mapOfLoadedDataToReferenceCountNumber(NULL),
+	cacheLimit( kDefaultCacheLimit ),
 	useAudioSessionInitializationFailureToAbortEndInterruption(true), // iOS 4/5 need this on
 	notifier( NULL )
 {
+	cacheStats.hits = 0;
+	cacheStats.misses = 0;
+	cacheStats.evictions = 0;
+	cacheStats.bytes = 0;
+	cacheStats.unusedBytes = 0;
+
 	// It's possible that InitializeOpenALPlayer() is never called 
 	// by the time RuntimeWillTerminate() is called in which case we have
 	// uninitialized variables being accessed, so we make sure to init them
@@ -192,6 +199,9 @@ PlatformOpenALPlayer::RuntimeWillTerminate( const Runtime& sender )
 			}
 		}
 	}
+
+	// The next Runtime may load the same paths after the files changed (e.g. a Simulator relaunch)
+	PurgeUnusedData();
 }
 
 bool
@@ -296,6 +306,9 @@ PlatformOpenALPlayer::QuitOpenALPlayer()
 	ALmixer_Quit();
 	
 	// ALmixer cleans up all the audio data so we can just free the map
+	listOfUnusedData.clear();
+	cacheStats.bytes = 0;
+	cacheStats.unusedBytes = 0;
 	LuaHashMap_FreeShare(mapOfLoadedFileNamesToData);
 	mapOfLoadedFileNamesToData = NULL;
 	LuaHashMap_FreeShare(mapOfLoadedDataToFileNames);
@@ -408,21 +421,29 @@ PlatformOpenALPlayer::LoadAll( const char* file_path )
 	{
 		ALmixer_Data* ret_data = (ALmixer_Data*)LuaHashMap_GetCachedValuePointerAtIterator(&filename_iterator);
 		lua_Integer refcount = LuaHashMap_GetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, ret_data);
+		if(0 == refcount)
+		{
+			// Back in use, so it can't be evicted
+			listOfUnusedData.remove(ret_data);
+			cacheStats.unusedBytes -= ALmixer_GetTotalBytes(ret_data);
+		}
 		LuaHashMap_SetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, refcount+1, ret_data);
+		cacheStats.hits++;
 		return ret_data;
 	}
 	ALmixer_Data* ret_data = ALmixer_LoadAll(file_path, false);
 	if(NULL != ret_data)
 	{
-		LuaHashMap_SetValuePointerForKeyString(mapOfLoadedFileNamesToData, ret_data, file_path);
-		LuaHashMap_SetValueStringForKeyPointer(mapOfLoadedDataToFileNames, file_path, ret_data);
-		lua_Integer refcount = LuaHashMap_GetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, ret_data);
-		LuaHashMap_SetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, refcount+1, ret_data);
+		cacheStats.misses++;
+		AddCachedData(file_path, ret_data);
+		TrimCache(cacheLimit);
 	}
 	return ret_data;
 }
 
 // Note: Don't cache files in mapOfLoadedFiles for LoadStream because we permit multiple unique instances for streams.
+// Streams are refilled by ALmixer's update thread, not by the frame loop, so a slow frame doesn't starve them.
+// The startup and per-pass buffer counts are only starting points: each underrun raises them toward max_queue_buffers.
 ALmixer_Data* 
 PlatformOpenALPlayer::LoadStream( const char* file_path, unsigned int buffer_size, unsigned int max_queue_buffers, unsigned int number_of_startup_buffers, unsigned int number_of_buffers_to_queue_per_update_pass )
 {
@@ -452,10 +473,8 @@ PlatformOpenALPlayer::LoadStream( const char* file_path, unsigned int buffer_siz
 	if(ALmixer_IsPredecoded(ret_data))
 	{
 		// Put the data in the hash maps so we can do quick look ups and caching
-		LuaHashMap_SetValuePointerForKeyString(mapOfLoadedFileNamesToData, ret_data, file_path);
-		LuaHashMap_SetValueStringForKeyPointer(mapOfLoadedDataToFileNames, file_path, ret_data);
-		lua_Integer refcount = LuaHashMap_GetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, ret_data);
-		LuaHashMap_SetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, refcount+1, ret_data);
+		AddCachedData(file_path, ret_data);
+		TrimCache(cacheLimit);
 	}
 	return ret_data;
 }
@@ -477,15 +496,18 @@ PlatformOpenALPlayer::FreeData( ALmixer_Data* almixer_data )
 		if(LuaHashMap_ExistsKeyPointer(mapOfLoadedDataToFileNames, almixer_data))
 		{
 			lua_Integer refcount = LuaHashMap_GetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, almixer_data);
-			Rtt_ASSERT(refcount > 0);
-			if(1 == refcount)
+			if(refcount <= 0)
 			{
-				// Remember that the life of file_name is controlled by mapOfLoadedDataToFileNames so only remove that entry from mapOfLoadedDataToFileNames after we are done using that pointer.
-				const char* file_name = LuaHashMap_GetValueStringForKeyPointer(mapOfLoadedDataToFileNames, almixer_data);
-				LuaHashMap_RemoveKeyString(mapOfLoadedFileNamesToData, file_name);
-				LuaHashMap_RemoveKeyPointer(mapOfLoadedDataToFileNames, almixer_data);
-				LuaHashMap_RemoveKeyPointer(mapOfLoadedDataToReferenceCountNumber, almixer_data);
-				ALmixer_FreeData(almixer_data);
+				// Already unused and waiting in the cache.
+				Rtt_TRACE_SIM(("Error: Over-disposing of the same audio data"));
+			}
+			else if(1 == refcount)
+			{
+				// Keep the decoded data for the next LoadAll() of this path. TrimCache() frees it if it doesn't fit.
+				LuaHashMap_SetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, 0, almixer_data);
+				listOfUnusedData.push_back(almixer_data);
+				cacheStats.unusedBytes += ALmixer_GetTotalBytes(almixer_data);
+				TrimCache(cacheLimit);
 			}
 			else
 			{
@@ -506,6 +528,114 @@ PlatformOpenALPlayer::FreeData( ALmixer_Data* almixer_data )
 	}
 }
 
+void
+PlatformOpenALPlayer::AddCachedData( const char* file_path, ALmixer_Data* almixer_data )
+{
+	// If unused data already has this path, it could never be loaded again, so free it now.
+	LuaHashMapIterator filename_iterator = LuaHashMap_GetIteratorForKeyString(mapOfLoadedFileNamesToData, file_path);
+	if(false == LuaHashMap_IteratorIsNotFound(&filename_iterator))
+	{
+		ALmixer_Data* old_data = (ALmixer_Data*)LuaHashMap_GetCachedValuePointerAtIterator(&filename_iterator);
+		if(0 == LuaHashMap_GetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, old_data))
+		{
+			listOfUnusedData.remove(old_data);
+			cacheStats.unusedBytes -= ALmixer_GetTotalBytes(old_data);
+			RemoveCachedData(old_data);
+		}
+	}
+
+	LuaHashMap_SetValuePointerForKeyString(mapOfLoadedFileNamesToData, almixer_data, file_path);
+	LuaHashMap_SetValueStringForKeyPointer(mapOfLoadedDataToFileNames, file_path, almixer_data);
+	LuaHashMap_SetValueIntegerForKeyPointer(mapOfLoadedDataToReferenceCountNumber, 1, almixer_data);
+	cacheStats.bytes += ALmixer_GetTotalBytes(almixer_data);
+}
+
+// Callers take almixer_data off listOfUnusedData first
+void
+PlatformOpenALPlayer::RemoveCachedData( ALmixer_Data* almixer_data )
+{
+	// Remember that the life of file_name is controlled by mapOfLoadedDataToFileNames so only remove that entry from mapOfLoadedDataToFileNames after we are done using that pointer.
+	const char* file_name = LuaHashMap_GetValueStringForKeyPointer(mapOfLoadedDataToFileNames, almixer_data);
+	// A stream of the same path may have taken over the name
+	if(almixer_data == LuaHashMap_GetValuePointerForKeyString(mapOfLoadedFileNamesToData, file_name))
+	{
+		LuaHashMap_RemoveKeyString(mapOfLoadedFileNamesToData, file_name);
+	}
+	LuaHashMap_RemoveKeyPointer(mapOfLoadedDataToFileNames, almixer_data);
+	LuaHashMap_RemoveKeyPointer(mapOfLoadedDataToReferenceCountNumber, almixer_data);
+	cacheStats.bytes -= ALmixer_GetTotalBytes(almixer_data);
+	ALmixer_FreeData(almixer_data);
+}
+
+void
+PlatformOpenALPlayer::TrimCache( size_t numBytes )
+{
+	while(cacheStats.bytes > numBytes && ! listOfUnusedData.empty())
+	{
+		ALmixer_Data* almixer_data = listOfUnusedData.front();
+		listOfUnusedData.pop_front();
+		cacheStats.unusedBytes -= ALmixer_GetTotalBytes(almixer_data);
+		cacheStats.evictions++;
+		RemoveCachedData(almixer_data);
+	}
+}
+
+void
+PlatformOpenALPlayer::SetCacheLimit( size_t numBytes )
+{
+	cacheLimit = numBytes;
+	TrimCache(cacheLimit);
+}
+
+void
+PlatformOpenALPlayer::PurgeUnusedData()
+{
+	TrimCache(0);
+}
+
+// Decodes one file per frame, so a long list doesn't stall a single frame.
+class PlatformOpenALPlayerPreloadTask : public Task
+{
+	public:
+		PlatformOpenALPlayerPreloadTask( const std::vector< std::string >& filePaths )
+		:	Task( true ),
+			fFilePaths( filePaths ),
+			fIndex( 0 )
+		{
+		}
+
+		virtual void operator()( Scheduler& sender )
+		{
+			PlatformOpenALPlayer* openal_player = PlatformOpenALPlayer::SharedInstance();
+			if ( openal_player && fIndex < fFilePaths.size() )
+			{
+				// Leaves the data unused in the cache
+				ALmixer_Data* almixer_data = openal_player->LoadAll( fFilePaths[fIndex].c_str() );
+				openal_player->FreeData( almixer_data );
+				fIndex++;
+			}
+
+			if ( ! openal_player || fIndex >= fFilePaths.size() )
+			{
+				// The Scheduler calls us once more before deleting us, which does nothing
+				setKeepAlive( false );
+			}
+		}
+
+	private:
+		std::vector< std::string > fFilePaths;
+		size_t fIndex;
+};
+
+void
+PlatformOpenALPlayer::Preload( Scheduler& scheduler, const std::vector< std::string >& filePaths )
+{
+	if ( filePaths.size() > 0 )
+	{
+		scheduler.Append( Rtt_NEW( scheduler.GetOwner().GetAllocator(), PlatformOpenALPlayerPreloadTask( filePaths ) ) );
+	}
+}
+
 int
 PlatformOpenALPlayer::GetTotalTime( ALmixer_Data* almixer_data ) const
 {
@@ -1120,8 +1250,9 @@ PlatformOpenALPlayer::NotificationCallback( int which_channel, unsigned int al_s
 			Rtt_ASSERT( L );
 			if ( L )
 			{
-				// Ensure that the event is dispatched on the main thread
-				// TODO: ensure that ScheduleDispatch() is thread-safe.
+				// Ensure that the event is dispatched on the main thread.
+				// This runs on ALmixer's update thread with its lock held; ScheduleDispatch() only
+				// pushes onto the Scheduler's lock-free list, so it never waits on the main thread.
 				ALmixerSoundCompletionEvent *e = Rtt_NEW( LuaContext::GetRuntime( L )->GetAllocator(), ALmixerSoundCompletionEvent );
 
 				// Bug 5724: In addition to setting all the callback properties, we pass the notifier in to transfer ownership. 
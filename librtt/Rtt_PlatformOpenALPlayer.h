@@ -21,6 +21,9 @@
 #include "Rtt_Event.h"
 
 #include <atomic>
+#include <list>
+#include <string>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 
@@ -132,6 +135,37 @@ class PlatformOpenALPlayer
 		virtual ALmixer_Data* LoadStream( const char* file_path,  unsigned int buffer_size, unsigned int max_queue_buffers, unsigned int number_of_startup_buffers, unsigned int number_of_buffers_to_queue_per_update_pass );
 		virtual void FreeData( ALmixer_Data* almixer_data );
 
+	public:
+		// Sounds from LoadAll() are shared by path while in use. Once the last one is freed,
+		// the decoded data is kept, so loading the path again doesn't decode it again.
+		// Unused data is freed, least recently used first, whenever the decoded data held
+		// in total (in use or not) exceeds the cache limit. Data in use is never freed early.
+		static const size_t kDefaultCacheLimit = 8 * 1024 * 1024;
+
+		struct CacheStats
+		{
+			U32 hits;
+			U32 misses;
+			U32 evictions;
+			size_t bytes;
+			size_t unusedBytes;
+		};
+
+		void SetCacheLimit( size_t numBytes );
+		size_t GetCacheLimit() const { return cacheLimit; }
+		const CacheStats& GetCacheStats() const { return cacheStats; }
+		void PurgeUnusedData();
+
+		// Decodes the files into the cache on the main thread, one per frame, so a later
+		// LoadAll() of any of them is a cache hit (unless the cache limit evicted it first).
+		void Preload( Scheduler& scheduler, const std::vector< std::string >& filePaths );
+
+	protected:
+		void AddCachedData( const char* file_path, ALmixer_Data* almixer_data );
+		void RemoveCachedData( ALmixer_Data* almixer_data );
+		void TrimCache( size_t numBytes );
+
+	public:
 		virtual int PlayChannelTimed( int channel, ALmixer_Data* almixer_data, int loops, int ticks );//, PlatformALmixerPlaybackFinishedCallback *callback );
 		virtual int PauseChannel( int channel );
 		virtual int ResumeChannel( int channel );
@@ -208,6 +242,10 @@ class PlatformOpenALPlayer
 		LuaHashMap* mapOfLoadedFileNamesToData;
 		LuaHashMap* mapOfLoadedDataToFileNames;
 		LuaHashMap* mapOfLoadedDataToReferenceCountNumber;
+		// Cached data that has been freed by every user, least recently freed first
+		std::list< ALmixer_Data* > listOfUnusedData;
+		size_t cacheLimit;
+		CacheStats cacheStats;
 		// Currently using true/false to denote was playing, but might want to change to hold all OpenAL states
 		int arrayOfChannelStatesForInterruption[kOpenALPlayerMaxNumberOfSources];
 
@@ -49,6 +49,12 @@ PlatformSurface::PointsHeight() const
 	return Height();
 }
 
+S32
+PlatformSurface::BackBufferAge() const
+{
+	return 0;
+}
+
 // ----------------------------------------------------------------------------
 
 // TODO: Replace platform ifdef's with a feature ifdef: Rtt_OFFSCREEN_SURFACE in Rtt_Config.h
@@ -40,6 +40,11 @@ class PlatformSurface
 		// in terms of "points" not actual pixels.
 		virtual S32 PointsWidth() const;
 		virtual S32 PointsHeight() const;
+
+		// Number of frames since the current back buffer was last presented,
+		// e.g. via EGL_EXT_buffer_age or GLX_EXT_buffer_age. Returns 0 if its
+		// contents are undefined, which is the default.
+		virtual S32 BackBufferAge() const;
 };
 
 // ----------------------------------------------------------------------------
@@ -316,6 +316,7 @@ ProfilingState::ProfilingState( Rtt_Allocator* allocator )
 {
 	fUpdateID = Create( "update" );
 	fRenderID = Create( "render" );
+	fShadersID = Create( "shaders" );
 }
 
 bool ProfilingState::Find( const Profiling* profiling )
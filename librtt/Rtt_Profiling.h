@@ -159,12 +159,14 @@ class ProfilingState {
 	public:
 		int GetUpdateID() const { return fUpdateID; }
 		int GetRenderID() const { return fRenderID; }
+		int GetShadersID() const { return fShadersID; }
 	
 	private:
 		PtrArray<Profiling> fLists;
 		Profiling* fTopList;
 		int fUpdateID;
 		int fRenderID;
+		int fShadersID;
 };
 
 class ProfilingEntryRAII {
@@ -15,6 +15,7 @@
 #include "Core/Rtt_Allocator.h"
 #include "Core/Rtt_String.h"
 #include "Display/Rtt_Display.h"
+#include "Display/Rtt_FramePacing.h"
 #include "Display/Rtt_GroupObject.h"
 #include "Display/Rtt_SpritePlayer.h"
 #include "Display/Rtt_StageObject.h"
@@ -31,6 +32,7 @@
 #include "Rtt_PlatformExitCallback.h"
 #include "Rtt_PlatformTimer.h"
 #include "Rtt_Scheduler.h"
+#include "Rtt_FileIOQueue.h"
 #include "Rtt_LuaFrameworks.h"
 #include "Rtt_HTTPClient.h"
 
@@ -141,11 +143,14 @@ Runtime::Runtime( const MPlatform& platform, MCallback *viewCallback )
 	fStartTime( Rtt_GetAbsoluteTime() ),
 	fStartTimeCorrection( 0 ),
 	fSuspendTime( 0 ),
+	fFixedTime( 0 ),
+	fUsesFixedTime( false ),
 	fResourcesHead( Rtt_NEW( & fAllocator, CachedResource( * this, NULL ) ) ),
 	fDisplay( Rtt_NEW( & fAllocator, Display( * this ) ) ),
 	fVMContext( LuaContext::New( Allocator(), platform, this ) ), 
 	fTimer( platform.CreateTimerWithCallback( viewCallback ? * viewCallback : * this ) ),
 	fScheduler( Rtt_NEW( & fAllocator, Scheduler( * this ) ) ),
+	fFileIOQueue( NULL ),
 	fArchive( NULL ),
 	fBackend("glBackend"),
 	fBackendState(nullptr),
@@ -213,6 +218,9 @@ Runtime::~Runtime()
 #endif
 
 	Rtt_DELETE( fArchive );
+
+	// Its thread hands finished tasks to the scheduler
+	Rtt_DELETE( fFileIOQueue );
 	Rtt_DELETE( fScheduler );
 	fTimer->Stop();
 	Rtt_DELETE( fTimer );
@@ -921,6 +929,7 @@ Runtime::OnMonitorChanged(double newRefreshRate)
 	}
 
 	fTimer->SetInterval(1000.0 / kFps);
+	fDisplay->GetFramePacing().SetBudget(1000.0 / kFps);
 
 	MonitorChangedEvent e(newRefreshRate, static_cast<U32>(kFps));
 	DispatchEvent(e);
@@ -948,6 +957,7 @@ Runtime::BeginRunLoop()
 
 	// PlatformTimer
 	fTimer->SetInterval( kInterval );
+	fDisplay->GetFramePacing().SetBudget( kInterval );
 
 	// Initial call to main.lua can cause runtime to be suspended,
 	// Otherwise, it's < 0 (i.e. uninitialized)
@@ -1175,11 +1185,33 @@ Runtime::Resume(bool sendApplicationEvents /* = true */)
 	}
 }
 
+// Events whose dispatch time starts the input latency of the next frame
+static bool
+IsInputEvent( const MEvent& e )
+{
+	static const char *kNames[] = { "touch", "relativeTouch", "mouse", "key", "axis", "tap" };
+
+	const char *name = e.Name();
+	for ( size_t i = 0; i < sizeof( kNames ) / sizeof( kNames[0] ); i++ )
+	{
+		if ( 0 == strcmp( name, kNames[i] ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 void
 Runtime::DispatchEvent( const MEvent& e )
 {
 	RuntimeGuard guard( * this );
 
+	if ( fDisplay && IsInputEvent( e ) )
+	{
+		fDisplay->GetFramePacing().MarkInput();
+	}
+
 	e.Dispatch( fVMContext->L(), * this );
 }
 
@@ -1193,6 +1225,11 @@ Runtime::GetElapsedMS() const
 Rtt_AbsoluteTime
 Runtime::GetElapsedTime() const
 {
+	if ( fUsesFixedTime )
+	{
+		return fFixedTime;
+	}
+
 	// During a suspend, use fSuspendTime as current time; otherwise, fetch absolute time
 	Rtt_AbsoluteTime currentTime = ( 1 != fIsSuspended ? Rtt_GetAbsoluteTime() : fSuspendTime );
 	Rtt_AbsoluteTime elapsed = currentTime - fStartTime;
@@ -1206,6 +1243,27 @@ Runtime::GetElapsedTime() const
 	return elapsed;
 }
 
+void
+Runtime::SetUsesFixedTime( bool newValue )
+{
+	if ( newValue != fUsesFixedTime )
+	{
+		// Continue from the current time either way. Returning to the clock
+		// folds the fixed time into the correction, like a suspend does.
+		Rtt_AbsoluteTime elapsed = GetElapsedTime();
+		fUsesFixedTime = newValue;
+		if ( newValue )
+		{
+			fFixedTime = elapsed;
+		}
+		else
+		{
+			Rtt_AbsoluteTime clockElapsed = GetElapsedTime();
+			fStartTimeCorrection += ( clockElapsed > elapsed ? clockElapsed - elapsed : 0 );
+		}
+	}
+}
+
 void
 Runtime::Collect()
 {
@@ -1216,6 +1274,14 @@ Runtime::Collect()
 
 	// Display objects
 	GroupObject::CollectUnreachables( vm.L(), GetDisplay().GetScene(), * GetDisplay().Orphanage() );
+
+#ifdef Rtt_USE_ALMIXER
+	// Decoded sounds no longer in use are only kept to speed up reloading them
+	if ( fOpenALPlayer )
+	{
+		fOpenALPlayer->PurgeUnusedData();
+	}
+#endif
 }
 
 void
@@ -1239,6 +1305,17 @@ Runtime::GetExitCallback()
 	return platform->GetExitCallback();
 }
 
+FileIOQueue&
+Runtime::GetFileIOQueue()
+{
+	// Most apps never use it, so its thread isn't made until it's needed
+	if ( ! fFileIOQueue )
+	{
+		fFileIOQueue = Rtt_NEW( & fAllocator, FileIOQueue( * fScheduler ) );
+	}
+	return * fFileIOQueue;
+}
+
 void 
 Runtime::UnloadResources()
 {
@@ -1402,15 +1479,14 @@ Runtime::PushResourceRegistry()
 	return L;
 }
 
-#ifdef Rtt_WIN_ENV
-
 void
 Runtime::Step()
 {
 	// Advance the simulation by one fixed logic tick.
 	// Runs the scheduler, dispatches enterFrame to Lua, updates physics and
-	// display object state. Does NOT render; render-only refreshes are driven
-	// by WM_PAINT when renderSync is enabled.
+	// display object state. Does NOT render; when renderSync is enabled the
+	// platform calls Render() separately, at the display's refresh rate
+	// (WM_PAINT on Windows, the main loop on Linux).
 	RuntimeGuard guard( * this );
 
 	if ( ! Rtt_VERIFY( fDisplay ) )
@@ -1439,6 +1515,8 @@ Runtime::Step()
 	++fFrame;	
 }
 
+#ifdef Rtt_WIN_ENV
+
 void
 Runtime::operator()()
 {
@@ -41,6 +41,7 @@ class LuaContext;
 class MRuntimeDelegate;
 class RenderingStream;
 class BitmapPaint;
+class FileIOQueue;
 class PlatformExitCallback;
 class PlatformSurface;
 class PlatformTimer;
@@ -134,6 +135,7 @@ class Runtime : public MCallback,
 		Rtt_INLINE Display& GetDisplay() { return * fDisplay; }
 		Rtt_INLINE const Display& GetDisplay() const { return * fDisplay; }
 		Rtt_INLINE Scheduler& GetScheduler() const { return * fScheduler; }
+		FileIOQueue& GetFileIOQueue();
 		Rtt_INLINE const MPlatform& Platform() const { return fPlatform; }
 
 		Rtt_INLINE bool IsVMContextValid() const { return NULL != fVMContext; }
@@ -220,6 +222,13 @@ class Runtime : public MCallback,
 		double GetElapsedMS() const;
 		Rtt_AbsoluteTime GetElapsedTime() const;
 
+		// For deterministic runs, e.g. benchmarks. While set, the elapsed time
+		// stops following the clock and only moves by AdvanceFixedTime().
+		bool UsesFixedTime() const { return fUsesFixedTime; }
+		void SetUsesFixedTime( bool newValue );
+		void AdvanceFixedTime( Rtt_AbsoluteTime delta ) { fFixedTime += delta; }
+
+		// Called on low-memory warnings. Also frees cached data that can be recreated.
 		void Collect();
 
 		Rtt_INLINE bool IsProperty( U16 mask ) const { return (fProperties & mask) != 0; }
@@ -257,8 +266,8 @@ class Runtime : public MCallback,
 	public:
 		// MCallback
 		virtual void operator()();
-#ifdef Rtt_WIN_ENV
 		void Step();    // advance logic one tick (scheduler, display update, frame counter)
+#ifdef Rtt_WIN_ENV
 		void OnMonitorChanged(double newRefreshRate);
 #endif
 		void Render();  // render current frame
@@ -286,11 +295,14 @@ class Runtime : public MCallback,
 		const Rtt_AbsoluteTime fStartTime;
 		Rtt_AbsoluteTime fStartTimeCorrection;
 		Rtt_AbsoluteTime fSuspendTime;
+		Rtt_AbsoluteTime fFixedTime;
+		bool fUsesFixedTime;
 		CachedResource* fResourcesHead; // Dummy node.
 		Display *fDisplay;
 		LuaContext* fVMContext;
 		PlatformTimer* fTimer;
 		Scheduler* fScheduler;
+		FileIOQueue* fFileIOQueue;
 		Archive* fArchive;
 		const char * fBackend;
 		void * fBackendState;
@@ -487,6 +487,7 @@ LIBRTT_FILES := \
 	$(CORONA_ROOT)/librtt/Core/Rtt_Assert.c \
 	$(CORONA_ROOT)/librtt/Core/Rtt_AutoResource.cpp \
 	$(CORONA_ROOT)/librtt/Core/Rtt_FileSystem.cpp \
+	$(CORONA_ROOT)/librtt/Core/Rtt_MappedFile.cpp \
 	$(CORONA_ROOT)/librtt/Core/Rtt_Fixed.c \
 	$(CORONA_ROOT)/librtt/Core/Rtt_FixedBlockAllocator.cpp \
 	$(CORONA_ROOT)/librtt/Core/Rtt_FixedMath.c \
@@ -554,6 +555,9 @@ LIBRTT_FILES := \
 	$(CORONA_ROOT)/librtt/Display/Rtt_ShaderProxy.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_ShaderResource.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_ShaderTypes.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_ShaderWarmup.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_FramePacing.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_RenderScale.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_ShapeAdapter.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_ShapeAdapterCircle.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_ShapeAdapterMesh.cpp \
@@ -577,6 +581,7 @@ LIBRTT_FILES := \
 	$(CORONA_ROOT)/librtt/Display/Rtt_TesselatorShape.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_TextObject.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_TextureFactory.cpp \
+	$(CORONA_ROOT)/librtt/Display/Rtt_TextureAtlas.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_TextureResource.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_TextureResourceAdapter.cpp \
 	$(CORONA_ROOT)/librtt/Display/Rtt_TextureResourceBitmap.cpp \
@@ -600,6 +605,7 @@ LIBRTT_FILES := \
 	$(CORONA_ROOT)/librtt/Input/Rtt_ReadOnlyInputDeviceCollection.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_Archive.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_Event.cpp \
+	$(CORONA_ROOT)/librtt/Rtt_FileIOQueue.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_ExplicitTemplates.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_FilePath.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_HitTestObject.cpp \
@@ -612,12 +618,14 @@ LIBRTT_FILES := \
 	$(CORONA_ROOT)/librtt/Rtt_LuaCoronaBaseLib.c \
 	$(CORONA_ROOT)/librtt/Rtt_LuaData.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaLibCrypto.cpp \
+	$(CORONA_ROOT)/librtt/Rtt_LuaLibJSON.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaLibFacebook.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaLibInAppStore.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaLibNative.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaLibOpenAL.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaLibSQLite.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaLibSystem.cpp \
+	$(CORONA_ROOT)/librtt/Rtt_LuaSerializer.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaProxy.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaProxyVTable.cpp \
 	$(CORONA_ROOT)/librtt/Rtt_LuaResource.cpp \
@@ -751,6 +759,9 @@ LIBRTT_FILES := \
 	$(TACHYON_DIR)/Rtt_GLGeometry.cpp \
 	$(TACHYON_DIR)/Rtt_GLProgram.cpp \
 	$(TACHYON_DIR)/Rtt_GLRenderer.cpp \
+	$(TACHYON_DIR)/Rtt_NullCommandBuffer.cpp \
+	$(TACHYON_DIR)/Rtt_NullRenderer.cpp \
+	$(TACHYON_DIR)/Rtt_CommandCapture.cpp \
 	$(TACHYON_DIR)/Rtt_GLTexture.cpp \
 	$(TACHYON_DIR)/Rtt_GPUResource.cpp \
 	$(TACHYON_DIR)/Rtt_HighPrecisionTime.cpp \
@@ -760,6 +771,9 @@ LIBRTT_FILES := \
 	$(TACHYON_DIR)/Rtt_RenderData.cpp \
 	$(TACHYON_DIR)/Rtt_Renderer.cpp \
 	$(TACHYON_DIR)/Rtt_RenderTypes.cpp \
+	$(TACHYON_DIR)/Rtt_StaticBatch.cpp \
+	$(TACHYON_DIR)/Rtt_RenderThread.cpp \
+	$(TACHYON_DIR)/Rtt_ProgramBinaryCache.cpp \
 	$(TACHYON_DIR)/Rtt_Texture.cpp \
 	$(TACHYON_DIR)/Rtt_TextureBitmap.cpp \
 	$(TACHYON_DIR)/Rtt_TextureVolatile.cpp \
@@ -14,9 +14,14 @@
 #include "Rtt_LuaContext.h"
 #include "Rtt_Runtime.h"
 #include "Rtt_PlatformNotifier.h"
+#include "NetworkThread.h"
 #include "NetworkLibrary.h"
 #include "NetworkSupport.h"
 
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
 int luaload_network(lua_State *L);
 
 // This corresponds to the name of the library, e.g. [Lua] require "plugin.library"
@@ -44,28 +49,127 @@ static size_t curlWriteData(void *buffer, size_t size, size_t nmemb, void *arg)
 	return size * nmemb;
 }
 
+// curl callback, writes a response file as it downloads
+static size_t curlWriteFile(void *buffer, size_t size, size_t nmemb, void *arg)
+{
+	NetworkRequestParameters* requestParams = (NetworkRequestParameters*) arg;
+	return requestParams->writeResponseFile(buffer, size * nmemb);
+}
+
+// curl callback, publishes progress for NetworkNotifierTask
+static int curlProgress(void *arg, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+{
+	NetworkRequestParameters* requestParams = (NetworkRequestParameters*) arg;
+	if (requestParams->getProgressDirection() == Upload)
+	{
+		requestParams->fBytesEstimated.store(ultotal, std::memory_order_relaxed);
+		requestParams->fBytesTransferred.store(ulnow, std::memory_order_relaxed);
+	}
+	else
+	{
+		// Sizes of a resumed download don't count what's already on disk
+		long long offset = requestParams->getResumeOffset();
+		requestParams->fBytesEstimated.store(dltotal > 0 ? dltotal + offset : 0, std::memory_order_relaxed);
+		requestParams->fBytesTransferred.store(dlnow + offset, std::memory_order_relaxed);
+	}
+	return 0;
+}
+
+// Total length from a "Content-Range: bytes */<length>" response header, or -1
+static long long contentRangeLength(const UTF8String& headers)
+{
+	// Redirects leave earlier responses' headers in front, so use the last one
+	static const char kName[] = "content-range:";
+	long long result = -1;
+
+	for (size_t start = 0; start < headers.size(); )
+	{
+		size_t end = headers.find('\n', start);
+		if (end == UTF8String::npos)
+		{
+			end = headers.size();
+		}
+
+		if (strncasecmp(headers.c_str() + start, kName, sizeof(kName) - 1) == 0)
+		{
+			const char *slash = (const char *)memchr(headers.c_str() + start, '/', end - start);
+			result = (slash && slash[1] != '*') ? strtoll(slash + 1, NULL, 10) : -1;
+		}
+
+		start = end + 1;
+	}
+
+	return result;
+}
+
+void NetworkNotifierTask::reportProgress()
+{
+	ProgressDirection direction = fRequestParams->getProgressDirection();
+	if (direction != Upload && direction != Download)
+	{
+		return;
+	}
+
+	long long transferred = fRequestParams->fBytesTransferred.load(std::memory_order_relaxed);
+	if (transferred == fBytesReported)
+	{
+		return;
+	}
+	fBytesReported = transferred;
+
+	fRequestState->setPhase(fHasBegun ? "progress" : "began");
+	fRequestState->setBytesEstimated(fRequestParams->fBytesEstimated.load(std::memory_order_relaxed));
+	fRequestState->setBytesTransferred(transferred);
+	fHasBegun = true;
+
+	fRequestParams->getLuaCallback()->callWithNetworkRequestState(fRequestState);
+}
+
 void NetworkNotifierTask::operator()( Scheduler & sender )
 {
 	// sanity check
 	if (fRequestParams != NULL && fRequestState != NULL)
 	{
-		int still_running = 0;
 		long status = 0;
-		CURLM* cm = fRequestParams->getMultiCURL();
 		CURL* curl = fRequestParams->getCURL();
-		if (cm && curl) // not cancelled ?
+		if (curl) // not cancelled ?
 		{
-			curl_multi_perform(cm, &still_running);
-			if (still_running > 0)
+			// The transfer runs on the network thread
+			int result = fRequestParams->getResult()->load(std::memory_order_acquire);
+			if (result == NetworkThread::kPending)
 			{
+				reportProgress();
 				return;
 			}
 
+			CURLcode rc = (CURLcode)result;
+			curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
 
-			CURLcode rc = curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+			CoronaFileSpec *responseFile = fRequestParams->getResponseFile();
+
+			// The partial file reaches past the end of the resource. Either it
+			// is complete already, or it is stale and is downloaded again, once.
+			if (rc == CURLE_OK && status == 416 && responseFile != NULL && fRequestParams->getResumeOffset() > 0)
+			{
+				if (contentRangeLength(fRequestParams->fResponseHeaders) == fRequestParams->getResumeOffset())
+				{
+					status = 200;
+					fRequestParams->fBytesTransferred.store(fRequestParams->getResumeOffset(), std::memory_order_relaxed);
+				}
+				else if (!fHasRestarted && fRequestParams->restartResponseFile())
+				{
+					fHasRestarted = true;
+					fRequestParams->fResponseHeaders.clear();
+					curl_easy_setopt(curl, CURLOPT_RANGE, NULL);
+					NetworkThread::Get().add(curl, fRequestParams->getResult());
+					return;
+				}
+			}
+
+			bool isComplete = (rc == CURLE_OK) && (status == 200 || (status == 206 && responseFile != NULL));
 
 			// It is worth noting that browsers report a status of 0 in case of XMLHttpRequest errors too.
-			if (status != 200)
+			if (!isComplete)
 			{
 				UTF8String *message = new  UTF8String(curl_easy_strerror(rc));
 				fRequestState->setError(message);
@@ -74,23 +178,16 @@ void NetworkNotifierTask::operator()( Scheduler & sender )
 			// Set responseHeaders
 			fRequestState->setResponseHeaders(fRequestParams->fResponseHeaders.c_str());
 
-			CoronaFileSpec *responseFile = fRequestParams->getResponseFile();
 			if (responseFile != NULL)
 			{
-				if (status == 200)
+				// The body is already on disk, in the partial file
+				if (fRequestParams->closeResponseFile(isComplete))
 				{
 					fRequestState->fResponseBody.bodyType = TYPE_FILE;
 					fRequestState->fResponseBody.bodyFile = new CoronaFileSpec(responseFile);
-					UTF8String responseFileFullPath = responseFile->getFullPath();
-
-					FILE* f = fopen(responseFileFullPath.c_str(), "wb");
-					if (f)
-					{
-						fwrite(fRequestParams->fResponse.data(), 1, fRequestParams->fResponse.size(), f);
-						fclose(f);
-						fRequestState->setBytesEstimated(fRequestParams->fResponse.size());
-						fRequestState->setBytesTransferred(fRequestParams->fResponse.size());
-					}
+					long long transferred = fRequestParams->fBytesTransferred.load(std::memory_order_relaxed);
+					fRequestState->setBytesEstimated(transferred);
+					fRequestState->setBytesTransferred(transferred);
 				}
 			}
 			else if (fRequestParams->fResponse.size() > 0)
@@ -103,6 +200,7 @@ void NetworkNotifierTask::operator()( Scheduler & sender )
 			}
 
 			fRequestState->setStatus(status);
+			fRequestState->setPhase("ended");
 
 			LuaCallback* func = fRequestParams->getLuaCallback();
 			func->callWithNetworkRequestState(fRequestState);
@@ -244,11 +342,8 @@ int	NetworkLibrary::sendRequest(lua_State *L)
 	{
 		const std::string& url = requestParams->getRequestUrl();
 
-		CURLM* curlMulti = curl_multi_init();
 		CURL* curl = curl_easy_init();
-		curl_multi_add_handle(curlMulti, curl);
-
-		requestParams->setCURL(curlMulti, curl);
+		requestParams->setCURL(curl);
 		// const std::string& method = requestParams->getRequestMethod();
 
 		CURLcode rc;
@@ -335,8 +430,29 @@ int	NetworkLibrary::sendRequest(lua_State *L)
 		rc = curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, curlHeaderCallback);
 		rc = curl_easy_setopt(curl, CURLOPT_HEADERDATA, &requestParams->fResponseHeaders);
 
-		rc = curl_easy_setopt(curl, CURLOPT_WRITEDATA, &requestParams->fResponse);
-		rc = curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteData);
+		// Response files are streamed to disk rather than held in memory
+		if (requestParams->getResponseFile() != NULL && requestParams->openResponseFile())
+		{
+			rc = curl_easy_setopt(curl, CURLOPT_WRITEDATA, requestParams);
+			rc = curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteFile);
+			if (requestParams->getResumeOffset() > 0)
+			{
+				// Unlike CURLOPT_RESUME_FROM_LARGE, a plain range doesn't fail
+				// when the server answers 200, so writeResponseFile() restarts
+				char range[32];
+				snprintf(range, sizeof(range), "%lld-", requestParams->getResumeOffset());
+				rc = curl_easy_setopt(curl, CURLOPT_RANGE, range);
+			}
+		}
+		else
+		{
+			rc = curl_easy_setopt(curl, CURLOPT_WRITEDATA, &requestParams->fResponse);
+			rc = curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteData);
+		}
+
+		rc = curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+		rc = curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, curlProgress);
+		rc = curl_easy_setopt(curl, CURLOPT_XFERINFODATA, requestParams);
 		rc = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
 		rc = curl_easy_setopt(curl, CURLOPT_TIMEOUT, requestParams->getTimeout());
 
@@ -349,9 +465,7 @@ int	NetworkLibrary::sendRequest(lua_State *L)
 		requestState->setPhase("ended");
 		requestState->setBytesEstimated(requestParams->fResponse.size());
 		requestState->setBytesTransferred(requestParams->fResponse.size());
-		int still_running = 0;
-		CURLM* cm = requestParams->getMultiCURL();
-		curl_multi_perform(cm, &still_running);
+		NetworkThread::Get().add(curl, requestParams->getResult());
 
 		// onEnterFrame
 		Runtime* runtime = LuaContext::GetRuntime(L);
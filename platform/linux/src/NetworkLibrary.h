@@ -87,6 +87,9 @@ namespace Rtt
 			, fRequestParams(requestParams)
 			, fRequestState(requestState)
 			, fNetworkLibrary(lib)
+			, fBytesReported(0)
+			, fHasBegun(false)
+			, fHasRestarted(false)
 		{
 		}
 
@@ -95,6 +98,13 @@ namespace Rtt
 		smart_ptr<NetworkRequestParameters> fRequestParams;
 		smart_ptr<NetworkRequestState> fRequestState;
 		NetworkLibrary* fNetworkLibrary;
+
+	private:
+		void reportProgress();
+
+		long long fBytesReported;
+		bool fHasBegun;
+		bool fHasRestarted;
 	};
 // }
 #endif // _NetworkLibrary_H__
@@ -10,11 +10,13 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <math.h>
 #include <string.h>
 
 #include "Corona/CoronaLog.h"
 #include "NetworkSupport.h"
+#include "NetworkThread.h"
 #include "Core/Rtt_Assert.h"
 
 #ifdef _WIN32
@@ -567,7 +569,12 @@ NetworkRequestParameters::NetworkRequestParameters( lua_State *luaState)
 	fLuaCallback = NULL;
     fFileHandle = NULL;
 	fCURL = NULL;
-	fMultiCURL = NULL;
+	fResult = Rtt::NetworkThread::kPending;
+	fBytesTransferred = 0;
+	fBytesEstimated = 0;
+	fIsResumable = false;
+	fResponseHandle = NULL;
+	fResumeOffset = 0;
 
 	int arg = 1;
 	// First argument - url (required)
@@ -994,6 +1001,17 @@ NetworkRequestParameters::NetworkRequestParameters( lua_State *luaState)
 			}
 			lua_pop( luaState, 1 );
 
+			fIsResumable = false;
+			lua_getfield( luaState, paramsTableStackIndex, "resume" );
+			if (!lua_isnil( luaState, -1 ))
+			{
+				if ( LUA_TBOOLEAN == lua_type( luaState, -1 ) )
+				{
+					fIsResumable = ( 0 != lua_toboolean( luaState, -1 ) );
+				}
+			}
+			lua_pop( luaState, 1 );
+
 			fHandleRedirects = true;
 			lua_getfield( luaState, paramsTableStackIndex, "handleRedirects" );
 			if (!lua_isnil( luaState, -1 ))
@@ -1017,23 +1035,121 @@ NetworkRequestParameters::NetworkRequestParameters( lua_State *luaState)
 
 void NetworkRequestParameters::cancel()
 {
-	if (fCURL != 0 && fMultiCURL != NULL)
+	if (fCURL != NULL)
 	{
-		curl_multi_remove_handle(fMultiCURL, fCURL);
+		Rtt::NetworkThread::Get().remove(fCURL);
 		curl_easy_cleanup(fCURL);
-		curl_multi_cleanup(fMultiCURL);
 
         if (fFileHandle != NULL) {
             fclose(fFileHandle);
         }
 
+		// A cancelled download may still be resumed
+		closeResponseFile(false);
+
 		// to prevent multiple calls
-		fMultiCURL = NULL;
 		fCURL = NULL;
         fFileHandle = NULL;
 	}
 }
 
+bool NetworkRequestParameters::openResponseFile()
+{
+	Rtt_ASSERT(fResponseFile && fResponseHandle == NULL);
+
+	UTF8String partialPath = fResponseFile->getFullPath() + ".download";
+
+	fResumeOffset = 0;
+	if (fIsResumable)
+	{
+		struct stat info;
+		if (stat(partialPath.c_str(), &info) == 0)
+		{
+			fResumeOffset = info.st_size;
+		}
+	}
+
+	fResponseHandle = fopen(partialPath.c_str(), fResumeOffset > 0 ? "ab" : "wb");
+	if (fResponseHandle == NULL)
+	{
+		fResumeOffset = 0;
+		return false;
+	}
+	return true;
+}
+
+// Called on the network thread
+size_t NetworkRequestParameters::writeResponseFile(const void* data, size_t size)
+{
+	if (fResponseHandle == NULL)
+	{
+		return 0;
+	}
+
+	long status = 0;
+	curl_easy_getinfo(fCURL, CURLINFO_RESPONSE_CODE, &status);
+
+	// Error bodies aren't saved, and mustn't end up in a partial file
+	if (status != 200 && status != 206)
+	{
+		return size;
+	}
+
+	// The server ignored the range and sent the whole body
+	if (status == 200 && fResumeOffset > 0)
+	{
+		fflush(fResponseHandle);
+		if (ftruncate(fileno(fResponseHandle), 0) != 0)
+		{
+			return 0;
+		}
+		fseek(fResponseHandle, 0, SEEK_SET);
+		fResumeOffset = 0;
+	}
+
+	return fwrite(data, 1, size, fResponseHandle);
+}
+
+bool NetworkRequestParameters::restartResponseFile()
+{
+	if (fResponseHandle != NULL)
+	{
+		fclose(fResponseHandle);
+	}
+
+	UTF8String partialPath = fResponseFile->getFullPath() + ".download";
+
+	fResumeOffset = 0;
+	fBytesTransferred.store(0, std::memory_order_relaxed);
+	fBytesEstimated.store(0, std::memory_order_relaxed);
+
+	fResponseHandle = fopen(partialPath.c_str(), "wb");
+	return fResponseHandle != NULL;
+}
+
+bool NetworkRequestParameters::closeResponseFile(bool isComplete)
+{
+	if (fResponseHandle == NULL)
+	{
+		return false;
+	}
+
+	bool result = (fclose(fResponseHandle) == 0) && isComplete;
+	fResponseHandle = NULL;
+
+	UTF8String path = fResponseFile->getFullPath();
+	UTF8String partialPath = path + ".download";
+	if (result)
+	{
+		result = (rename(partialPath.c_str(), path.c_str()) == 0);
+	}
+	else if (!fIsResumable)
+	{
+		remove(partialPath.c_str());
+	}
+	return result;
+}
+
 NetworkRequestParameters::~NetworkRequestParameters()
 {
 	cancel();
@@ -14,6 +14,7 @@
 
 #define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
 
+#include <atomic>
 #include <map>
 #include <vector>
 #include <string>
@@ -225,20 +226,36 @@ public:
 	CoronaFileSpec* getResponseFile();
 	LuaCallback* getLuaCallback();
 	int getTimeout();
+	bool isResumable() const { return fIsResumable; };
 	bool isDebug();
 	bool getHandleRedirects();
 	lua_State* getLuaState() const { return fL; };
 	FILE* getFileHandle() const { return fFileHandle; };
 	CURL* getCURL() const { return fCURL; };
-	CURLM* getMultiCURL() const { return fMultiCURL; };
-	void setCURL(CURLM* curlMulti, CURL* curl) { fCURL = curl; fMultiCURL = curlMulti; };
+	void setCURL(CURL* curl) { fCURL = curl; };
+	// NetworkThread::kPending until the transfer finishes, then its CURLcode
+	std::atomic<int>* getResult() { return &fResult; };
 	void setFileHandle(FILE* handle) { fFileHandle = handle; };
 	unsigned int getID() const { return fID; }
 	void cancel();
 
+	// Response files are written as they download, to a ".download" file
+	// next to the destination, which is renamed into place when complete.
+	// With 'resume', a partial file left by an earlier request is continued
+	// with a range request, if the server supports it.
+	bool openResponseFile();
+	size_t writeResponseFile(const void* data, size_t size);
+	bool closeResponseFile(bool isComplete);
+	bool restartResponseFile(); // discards the partial file
+	long long getResumeOffset() const { return fResumeOffset; };
+
 	membuf fResponse;
     UTF8String fResponseHeaders;
 
+	// Updated by the network thread while the transfer runs
+	std::atomic<long long> fBytesTransferred;
+	std::atomic<long long> fBytesEstimated;
+
 private:
 
 	UTF8String		fRequestUrl;
@@ -258,7 +275,10 @@ private:
 	lua_State* fL;
 	FILE* fFileHandle;
 	CURL* fCURL;
-	CURLM* fMultiCURL;
+	std::atomic<int> fResult;
+	bool			fIsResumable;
+	FILE*			fResponseHandle;
+	long long		fResumeOffset;
 	unsigned int fID;
 };
 
@@ -0,0 +1,241 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Types.h"
+#include "Core/Rtt_Assert.h"
+#include "NetworkThread.h"
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+namespace Rtt
+{
+	NetworkThread& NetworkThread::Get()
+	{
+		static NetworkThread sInstance;
+		return sInstance;
+	}
+
+	NetworkThread::NetworkThread()
+		: fMulti(curl_multi_init())
+		, fShare(curl_share_init())
+		, fEpoll(epoll_create1(EPOLL_CLOEXEC))
+		, fWakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+		, fHasDeadline(false)
+		, fQuit(false)
+	{
+		curl_multi_setopt(fMulti, CURLMOPT_SOCKETFUNCTION, onSocket);
+		curl_multi_setopt(fMulti, CURLMOPT_SOCKETDATA, this);
+		curl_multi_setopt(fMulti, CURLMOPT_TIMERFUNCTION, onTimer);
+		curl_multi_setopt(fMulti, CURLMOPT_TIMERDATA, this);
+		curl_multi_setopt(fMulti, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+		// Connections are shared through the multi handle; these aren't.
+		// The main thread uses the share too, when it cleans up a handle.
+		curl_share_setopt(fShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		curl_share_setopt(fShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+		curl_share_setopt(fShare, CURLSHOPT_LOCKFUNC, onLockShare);
+		curl_share_setopt(fShare, CURLSHOPT_UNLOCKFUNC, onUnlockShare);
+		curl_share_setopt(fShare, CURLSHOPT_USERDATA, this);
+
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.fd = fWakeFd;
+		epoll_ctl(fEpoll, EPOLL_CTL_ADD, fWakeFd, &event);
+
+		fThread = std::thread([this]() { run(); });
+	}
+
+	NetworkThread::~NetworkThread()
+	{
+		fQuit = true;
+		wake();
+		if (fThread.joinable())
+		{
+			fThread.join();
+		}
+
+		// Handles still attached belong to requests that were never collected
+		curl_multi_cleanup(fMulti);
+		curl_share_cleanup(fShare);
+		close(fWakeFd);
+		close(fEpoll);
+	}
+
+	void NetworkThread::add(CURL* curl, std::atomic<int>* result)
+	{
+		result->store(kPending);
+
+		curl_easy_setopt(curl, CURLOPT_PRIVATE, result);
+		curl_easy_setopt(curl, CURLOPT_SHARE, fShare);
+
+		// Wait for a connection that can multiplex instead of opening another
+		curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+		curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+
+		{
+			std::lock_guard<std::mutex> lock(fMutex);
+			curl_multi_add_handle(fMulti, curl);
+		}
+
+		// Adding the handle set a timer the thread isn't waiting on yet
+		wake();
+	}
+
+	void NetworkThread::remove(CURL* curl)
+	{
+		// A handle that already finished was removed by checkDone()
+		std::lock_guard<std::mutex> lock(fMutex);
+		curl_multi_remove_handle(fMulti, curl);
+	}
+
+	void NetworkThread::wake()
+	{
+		uint64_t one = 1;
+		ssize_t rc = write(fWakeFd, &one, sizeof(one));
+		(void)rc;
+	}
+
+	int NetworkThread::onSocket(CURL* curl, curl_socket_t s, int what, void* userp, void* socketp)
+	{
+		NetworkThread* thiz = (NetworkThread*)userp;
+
+		if (what == CURL_POLL_REMOVE)
+		{
+			epoll_ctl(thiz->fEpoll, EPOLL_CTL_DEL, s, NULL);
+			return 0;
+		}
+
+		epoll_event event = {};
+		event.data.fd = s;
+		event.events = ((what & CURL_POLL_IN) ? EPOLLIN : 0) | ((what & CURL_POLL_OUT) ? EPOLLOUT : 0);
+
+		if (socketp == NULL)
+		{
+			// A closed socket's descriptor may have been reused
+			if (epoll_ctl(thiz->fEpoll, EPOLL_CTL_ADD, s, &event) < 0 && errno == EEXIST)
+			{
+				epoll_ctl(thiz->fEpoll, EPOLL_CTL_MOD, s, &event);
+			}
+			curl_multi_assign(thiz->fMulti, s, thiz);
+		}
+		else
+		{
+			epoll_ctl(thiz->fEpoll, EPOLL_CTL_MOD, s, &event);
+		}
+		return 0;
+	}
+
+	int NetworkThread::onTimer(CURLM* multi, long timeoutMs, void* userp)
+	{
+		NetworkThread* thiz = (NetworkThread*)userp;
+
+		// Called with fMutex held
+		thiz->fHasDeadline = (timeoutMs >= 0);
+		if (thiz->fHasDeadline)
+		{
+			thiz->fDeadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+		}
+		return 0;
+	}
+
+	void NetworkThread::onLockShare(CURL* curl, curl_lock_data data, curl_lock_access access, void* userp)
+	{
+		NetworkThread* thiz = (NetworkThread*)userp;
+		thiz->fShareLocks[data].lock();
+	}
+
+	void NetworkThread::onUnlockShare(CURL* curl, curl_lock_data data, void* userp)
+	{
+		NetworkThread* thiz = (NetworkThread*)userp;
+		thiz->fShareLocks[data].unlock();
+	}
+
+	void NetworkThread::run()
+	{
+		const int kMaxEvents = 32;
+		epoll_event events[kMaxEvents];
+
+		while (!fQuit)
+		{
+			int timeoutMs = -1;
+			{
+				std::lock_guard<std::mutex> lock(fMutex);
+				if (fHasDeadline)
+				{
+					auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(fDeadline - Clock::now()).count();
+					timeoutMs = remaining > 0 ? (int)remaining : 0;
+				}
+			}
+
+			int n = epoll_wait(fEpoll, events, kMaxEvents, timeoutMs);
+			if (n < 0 && errno != EINTR)
+			{
+				Rtt_LogException("Network thread: epoll_wait failed (%d)\n", errno);
+				break;
+			}
+
+			std::lock_guard<std::mutex> lock(fMutex);
+			int running = 0;
+
+			for (int i = 0; i < n; i++)
+			{
+				int fd = events[i].data.fd;
+				if (fd == fWakeFd)
+				{
+					uint64_t count;
+					ssize_t rc = read(fWakeFd, &count, sizeof(count));
+					(void)rc;
+					continue;
+				}
+
+				int flags = 0;
+				if (events[i].events & EPOLLIN) { flags |= CURL_CSELECT_IN; }
+				if (events[i].events & EPOLLOUT) { flags |= CURL_CSELECT_OUT; }
+				if (events[i].events & (EPOLLERR | EPOLLHUP)) { flags |= CURL_CSELECT_ERR; }
+				curl_multi_socket_action(fMulti, fd, flags, &running);
+			}
+
+			if (fHasDeadline && Clock::now() >= fDeadline)
+			{
+				fHasDeadline = false;
+				curl_multi_socket_action(fMulti, CURL_SOCKET_TIMEOUT, 0, &running);
+			}
+
+			checkDone();
+		}
+	}
+
+	void NetworkThread::checkDone()
+	{
+		int pending = 0;
+		while (CURLMsg* msg = curl_multi_info_read(fMulti, &pending))
+		{
+			if (msg->msg != CURLMSG_DONE)
+			{
+				continue;
+			}
+
+			CURL* curl = msg->easy_handle;
+			CURLcode code = msg->data.result;
+
+			std::atomic<int>* result = NULL;
+			curl_easy_getinfo(curl, CURLINFO_PRIVATE, (char**)&result);
+			curl_multi_remove_handle(fMulti, curl);
+
+			// Publishes the response written by the transfer's callbacks
+			if (result)
+			{
+				result->store(code, std::memory_order_release);
+			}
+		}
+	}
+}
@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _NetworkThread_H__
+#define _NetworkThread_H__
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <curl/curl.h>
+
+namespace Rtt
+{
+	// Runs the transfers of every network.request() on one thread, with a
+	// single curl multi handle driven by epoll. Since they share the multi
+	// handle, requests reuse connections, TLS sessions and DNS lookups, and
+	// HTTP/2 requests to the same host are multiplexed over one connection.
+	//
+	// The multi handle is only used with fMutex held. The thread releases it
+	// while waiting in epoll, so the main thread adds and removes transfers
+	// directly.
+	class NetworkThread
+	{
+	public:
+		// The transfer hasn't finished yet
+		static const int kPending = -1;
+
+		// Process-wide instance, started on first use
+		static NetworkThread& Get();
+
+		NetworkThread();
+		~NetworkThread();
+
+		// Starts the transfer. When it finishes, the thread removes it and
+		// stores its CURLcode in *result, which the caller polls.
+		void add(CURL* curl, std::atomic<int>* result);
+
+		// Stops the transfer if it's still running. Once this returns, the
+		// thread no longer touches the handle, so it can be cleaned up.
+		void remove(CURL* curl);
+
+	private:
+		static int onSocket(CURL* curl, curl_socket_t s, int what, void* userp, void* socketp);
+		static int onTimer(CURLM* multi, long timeoutMs, void* userp);
+		static void onLockShare(CURL* curl, curl_lock_data data, curl_lock_access access, void* userp);
+		static void onUnlockShare(CURL* curl, curl_lock_data data, void* userp);
+
+		void run();
+		void wake();
+		void checkDone();
+
+		typedef std::chrono::steady_clock Clock;
+
+		CURLM* fMulti;
+		CURLSH* fShare;
+		int fEpoll;
+		int fWakeFd;
+
+		std::mutex fMutex;
+		std::mutex fShareLocks[CURL_LOCK_DATA_LAST];
+		bool fHasDeadline;
+		Clock::time_point fDeadline;
+
+		std::atomic<bool> fQuit;
+		std::thread fThread;
+	};
+}
+
+#endif // _NetworkThread_H__
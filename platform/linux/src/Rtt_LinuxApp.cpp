@@ -395,12 +395,12 @@ namespace Rtt
 
 	void SolarApp::Run()
 	{
-		int fps = fContext->GetFPS();
-		float frameDuration = 1000.0f / fps;
-
 		// main app loop
 		while (1)
 		{
+			// renderSync can change it at any time
+			float frameDuration = fContext->GetFrameDuration();
+
 			U64 start_time = Rtt_AbsoluteToMilliseconds(Rtt_GetAbsoluteTime());
 
 			if (!PollEvents())
@@ -440,18 +440,31 @@ namespace Rtt
 			return;
 
 		SDL_GL_MakeCurrent(fWindow, fGLcontext);
+		LayoutGUI();
+
+		if (IsSuspended())
+		{
+			glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+		}
+
+		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	}
+
+	void SolarApp::LayoutGUI()
+	{
+		if (fImCtx == NULL)
+			return;
+
 		ImGui::SetCurrentContext(fImCtx);
 
-		// draw GUI
+		// lay out GUI
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplSDL2_NewFrame();
 		ImGui::NewFrame();
 
 		if (IsSuspended())
 		{
-			glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-			glClear(GL_COLOR_BUFFER_BIT);
-
 			// Always center this window when appearing
 			ImVec2 center = ImGui::GetMainViewport()->GetCenter();
 			ImGui::SetNextWindowPos(center, ImGuiCond_Always, ImVec2(0.5f, 0.5f));
@@ -479,7 +492,6 @@ namespace Rtt
 		ImGui::EndFrame();
 
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 	}
 
 	void SolarApp::OnIconized()
@@ -90,9 +90,15 @@ namespace Rtt
 		SolarAppContext* GetContext() const { return fContext; }
 
 		virtual bool IsRunningOnSimulator() { return false; }
+		// Whether renderThread=true in the app's config file may take effect.
+		// The simulator keeps the context on its main thread, where its dialogs use it.
+		virtual bool AllowsRenderThread() { return !IsRunningOnSimulator(); }
 		bool IsSuspended() const { return GetRuntime()->IsSuspended(); }
 
 		void RenderGUI();
+
+		// The CPU side of RenderGUI(), up to ImGui::Render(); needs no GL context.
+		void LayoutGUI();
 		inline void Pause() { fContext->Pause(); }
 		inline void Resume() { fContext->Resume(); }
 		void Log(const char* buf, int len);
@@ -122,6 +128,9 @@ namespace Rtt
 
 		virtual int GetMenuHeight() const { return 0; }
 
+		SDL_GLContext GetGLContext() const { return fGLcontext; }
+		ImGuiContext* GetImGuiContext() const { return fImCtx; }
+
 	protected:
 
 		virtual void SolarEvent(const SDL_Event& e) {}
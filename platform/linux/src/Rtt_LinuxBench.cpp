@@ -0,0 +1,250 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Rtt_LinuxBench.h"
+#include <algorithm>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace Rtt
+{
+	// Runs stop growing past this, however fast they are
+	static const U64 kMaxIterations = 1000000000;
+
+	static double Now(clockid_t clock)
+	{
+		timespec t;
+		clock_gettime(clock, &t);
+		return t.tv_sec + t.tv_nsec * 1e-9;
+	}
+
+	BenchState::BenchState(U64 maxIterations, const vector<S64>& args)
+		: fMaxIterations(maxIterations)
+		, fIterations(0)
+		, fArgs(args)
+		, fStarted(false)
+		, fRunning(false)
+		, fRealStart(0.0)
+		, fCPUStart(0.0)
+		, fRealTime(0.0)
+		, fCPUTime(0.0)
+		, fItemsProcessed(0)
+	{
+	}
+
+	bool BenchState::KeepRunning()
+	{
+		if (!fStarted)
+		{
+			fStarted = true;
+			Start();
+		}
+
+		if (fIterations < fMaxIterations)
+		{
+			fIterations++;
+			return true;
+		}
+
+		if (fRunning)
+		{
+			Stop();
+		}
+		return false;
+	}
+
+	void BenchState::PauseTiming()
+	{
+		if (fRunning)
+		{
+			Stop();
+		}
+	}
+
+	void BenchState::ResumeTiming()
+	{
+		if (!fRunning)
+		{
+			Start();
+		}
+	}
+
+	void BenchState::Start()
+	{
+		fRunning = true;
+		fRealStart = Now(CLOCK_MONOTONIC);
+		fCPUStart = Now(CLOCK_PROCESS_CPUTIME_ID);
+	}
+
+	void BenchState::Stop()
+	{
+		fRunning = false;
+		fRealTime += Now(CLOCK_MONOTONIC) - fRealStart;
+		fCPUTime += Now(CLOCK_PROCESS_CPUTIME_ID) - fCPUStart;
+	}
+
+	static vector<Benchmark*>& Registry()
+	{
+		// Function-local so that registration from static initializers in
+		// other files doesn't depend on initialization order
+		static vector<Benchmark*> sBenchmarks;
+		return sBenchmarks;
+	}
+
+	Benchmark::Benchmark(const char* name, BenchFunction function)
+		: fName(name)
+		, fFunction(function)
+	{
+	}
+
+	Benchmark* Benchmark::Register(const char* name, BenchFunction function)
+	{
+		Benchmark* result = new Benchmark(name, function);
+		Registry().push_back(result);
+		return result;
+	}
+
+	const vector<Benchmark*>& Benchmark::All()
+	{
+		return Registry();
+	}
+
+	Benchmark* Benchmark::Arg(S64 a)
+	{
+		fArgs.push_back(vector<S64>(1, a));
+		return this;
+	}
+
+	Benchmark* Benchmark::Args(const vector<S64>& args)
+	{
+		fArgs.push_back(args);
+		return this;
+	}
+
+	BenchOptions::BenchOptions()
+		: minTime(0.5)
+	{
+	}
+
+	static string RunName(const Benchmark& benchmark, const vector<S64>& args)
+	{
+		string result(benchmark.GetName());
+		for (size_t i = 0; i < args.size(); i++)
+		{
+			result += "/" + to_string(args[i]);
+		}
+		return result;
+	}
+
+	// Same growth policy as Google Benchmark: predict the count that fills
+	// minTime from the last run, with some headroom, but at most 10x
+	static U64 NextIterations(U64 iterations, double elapsed, double minTime)
+	{
+		double multiplier = elapsed > 0.0 ? max(minTime * 1.4 / elapsed, 1.0) : 10.0;
+		multiplier = min(multiplier, 10.0);
+		U64 next = (U64)(iterations * multiplier);
+		return min(max(next, iterations + 1), kMaxIterations);
+	}
+
+	int RunBenchmarks(const BenchOptions& options)
+	{
+		FILE* f = options.output.empty() ? stdout : fopen(options.output.c_str(), "w");
+		if (!f)
+		{
+			fprintf(stderr, "Cannot write %s\n", options.output.c_str());
+			return 1;
+		}
+
+		char host[256] = "";
+		gethostname(host, sizeof(host) - 1);
+		time_t now = time(NULL);
+		char date[64];
+		strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+
+		fprintf(f, "{\n");
+		fprintf(f, "\t\"context\": {\n");
+		fprintf(f, "\t\t\"date\": \"%s\",\n", date);
+		fprintf(f, "\t\t\"host_name\": \"%s\",\n", host);
+		fprintf(f, "\t\t\"executable\": \"solar2d_bench\",\n");
+		fprintf(f, "\t\t\"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+#ifdef Rtt_DEBUG
+		fprintf(f, "\t\t\"library_build_type\": \"debug\"\n");
+#else
+		fprintf(f, "\t\t\"library_build_type\": \"release\"\n");
+#endif
+		fprintf(f, "\t},\n");
+		fprintf(f, "\t\"benchmarks\": [");
+
+		bool first = true;
+		const vector<Benchmark*>& benchmarks = Benchmark::All();
+		for (size_t i = 0; i < benchmarks.size(); i++)
+		{
+			const Benchmark& benchmark = *benchmarks[i];
+
+			vector< vector<S64> > runs = benchmark.GetArgs();
+			if (runs.empty())
+			{
+				runs.push_back(vector<S64>());
+			}
+
+			for (size_t j = 0; j < runs.size(); j++)
+			{
+				string name = RunName(benchmark, runs[j]);
+				if (!options.filter.empty() && name.find(options.filter) == string::npos)
+				{
+					continue;
+				}
+
+				U64 iterations = 1;
+				for (;;)
+				{
+					BenchState state(iterations, runs[j]);
+					benchmark.GetFunction()(state);
+
+					if (state.RealTime() >= options.minTime || iterations >= kMaxIterations)
+					{
+						double realTime = state.RealTime() * 1e9 / iterations;
+						double cpuTime = state.CPUTime() * 1e9 / iterations;
+						fprintf(stderr, "%-48s %12.1f ns %12.1f ns %12llu\n", name.c_str(), realTime, cpuTime, (unsigned long long)iterations);
+
+						fprintf(f, "%s\n\t\t{\n", first ? "" : ",");
+						fprintf(f, "\t\t\t\"name\": \"%s\",\n", name.c_str());
+						fprintf(f, "\t\t\t\"run_type\": \"iteration\",\n");
+						fprintf(f, "\t\t\t\"iterations\": %llu,\n", (unsigned long long)iterations);
+						fprintf(f, "\t\t\t\"real_time\": %.3f,\n", realTime);
+						fprintf(f, "\t\t\t\"cpu_time\": %.3f,\n", cpuTime);
+						if (state.ItemsProcessed() > 0 && state.RealTime() > 0.0)
+						{
+							fprintf(f, "\t\t\t\"items_per_second\": %.3f,\n", state.ItemsProcessed() / state.RealTime());
+						}
+						if (!state.Label().empty())
+						{
+							fprintf(f, "\t\t\t\"label\": \"%s\",\n", state.Label().c_str());
+						}
+						fprintf(f, "\t\t\t\"time_unit\": \"ns\"\n\t\t}");
+						first = false;
+						break;
+					}
+
+					iterations = NextIterations(iterations, state.RealTime(), options.minTime);
+				}
+			}
+		}
+
+		fprintf(f, "\n\t]\n}\n");
+		if (f != stdout)
+		{
+			fclose(f);
+		}
+		return 0;
+	}
+}
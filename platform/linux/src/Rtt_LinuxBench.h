@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Core/Rtt_Types.h"
+#include <string>
+#include <vector>
+
+namespace Rtt
+{
+	// Micro-benchmark harness for solar2d_bench. It follows Google Benchmark's
+	// API closely enough that cases read the same, and writes the same JSON
+	// layout, so the usual comparison scripts work on the results:
+	//
+	//	static void BM_Something(BenchState& state)
+	//	{
+	//		// setup
+	//		while (state.KeepRunning())
+	//		{
+	//			// measured
+	//		}
+	//		state.SetItemsProcessed(state.Iterations() * state.Range(0));
+	//	}
+	//	Rtt_BENCHMARK(BM_Something)->Arg(16)->Arg(256);
+	class BenchState
+	{
+	public:
+		BenchState(U64 maxIterations, const std::vector<S64>& args);
+
+		// Returns true until the iteration count is reached. Timing starts on
+		// the first call, so setup before the loop is not measured.
+		bool KeepRunning();
+
+		// For per-iteration setup that should not be measured.
+		void PauseTiming();
+		void ResumeTiming();
+
+		S64 Range(size_t index = 0) const { return index < fArgs.size() ? fArgs[index] : 0; }
+		U64 Iterations() const { return fIterations; }
+
+		void SetItemsProcessed(S64 items) { fItemsProcessed = items; }
+		void SetLabel(const std::string& label) { fLabel = label; }
+
+	public:
+		double RealTime() const { return fRealTime; }
+		double CPUTime() const { return fCPUTime; }
+		S64 ItemsProcessed() const { return fItemsProcessed; }
+		const std::string& Label() const { return fLabel; }
+
+	private:
+		void Start();
+		void Stop();
+
+		U64 fMaxIterations;
+		U64 fIterations;
+		std::vector<S64> fArgs;
+		bool fStarted;
+		bool fRunning;
+		double fRealStart;
+		double fCPUStart;
+		double fRealTime;	// seconds
+		double fCPUTime;
+		S64 fItemsProcessed;
+		std::string fLabel;
+	};
+
+	typedef void (*BenchFunction)(BenchState& state);
+
+	class Benchmark
+	{
+	public:
+		static Benchmark* Register(const char* name, BenchFunction function);
+		static const std::vector<Benchmark*>& All();
+
+		// Each call adds a run with the given arguments.
+		Benchmark* Arg(S64 a);
+		Benchmark* Args(const std::vector<S64>& args);
+
+		const char* GetName() const { return fName; }
+		BenchFunction GetFunction() const { return fFunction; }
+		const std::vector< std::vector<S64> >& GetArgs() const { return fArgs; }
+
+	private:
+		Benchmark(const char* name, BenchFunction function);
+
+		const char* fName;
+		BenchFunction fFunction;
+		std::vector< std::vector<S64> > fArgs;
+	};
+
+	struct BenchOptions
+	{
+		BenchOptions();
+
+		std::string filter;		// runs whose name contains it, empty for all
+		double minTime;			// seconds per run
+		std::string output;		// JSON file, empty for stdout
+	};
+
+	// Returns the process exit code.
+	int RunBenchmarks(const BenchOptions& options);
+
+	// Keeps the compiler from discarding a result that is never used.
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+}
+
+#define Rtt_BENCHMARK_NAME(function, line) Rtt_BENCHMARK_NAME2(function, line)
+#define Rtt_BENCHMARK_NAME2(function, line) sBenchmark_##function##_##line
+#define Rtt_BENCHMARK(function) \
+	static Rtt::Benchmark* Rtt_BENCHMARK_NAME(function, __LINE__) __attribute__((unused)) = Rtt::Benchmark::Register(#function, function)
@@ -0,0 +1,402 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+#include "Core/Rtt_Allocator.h"
+#include "Core/Rtt_FileSystem.h"
+#include "Core/Rtt_StringHash.h"
+#include "Display/Rtt_GroupObject.h"
+#include "Display/Rtt_ShaderResource.h"
+#include "Display/Rtt_ShaderTypes.h"
+#include "Display/Rtt_TesselatorCircle.h"
+#include "Input/Rtt_GameControllerDB.h"
+#include "Renderer/Rtt_Geometry_Renderer.h"
+#include "Renderer/Rtt_NullRenderer.h"
+#include "Renderer/Rtt_Program.h"
+#include "Renderer/Rtt_RenderData.h"
+#include "Rtt_Archive.h"
+#include "Rtt_Lua.h"
+#include "Rtt_LuaFrameworks.h"
+#include "Rtt_LuaLibJSON.h"
+#include "Rtt_Matrix.h"
+#include "Rtt_LinuxBench.h"
+#include <stdio.h>
+#include <string>
+
+extern "C"
+{
+	int luaopen_lpeg(lua_State* L);
+}
+
+using namespace std;
+
+namespace Rtt
+{
+	// One allocator for every case; the engine never frees it either
+	static Rtt_Allocator* Allocator()
+	{
+		static Rtt_Allocator* sAllocator = Rtt_AllocatorCreate();
+		return sAllocator;
+	}
+
+	// ------------------------------------------------------------------------
+	// Renderer
+
+	// Quads per frame through Insert(), then the frame is submitted to the
+	// null backend. Range(1) is the number of programs drawn in turn: 1
+	// batches everything, more breaks the batch on every quad.
+	static void BM_RendererInsert(BenchState& state)
+	{
+		Rtt_Allocator* allocator = Allocator();
+		NullRenderer renderer(allocator);
+		renderer.Initialize();
+
+		vector<ShaderResource*> shaders;
+		vector<RenderData> data;
+		Geometry quad(allocator, Geometry::kTriangleStrip, 4, 0, false);
+		const Real kCorners[4][2] = { { 0, 0 }, { 0, 16 }, { 16, 0 }, { 16, 16 } };
+		for (int i = 0; i < 4; i++)
+		{
+			Geometry::Vertex& v = quad.GetVertexData()[i];
+			memset(&v, 0, sizeof(v));
+			v.x = kCorners[i][0];
+			v.y = kCorners[i][1];
+			v.rs = v.gs = v.bs = v.as = 255;
+		}
+		quad.SetVerticesUsed(4);
+
+		for (S64 i = 0; i < Max<S64>(state.Range(1), 1); i++)
+		{
+			Program* program = Rtt_NEW(allocator, Program(allocator));
+			ShaderResource* shader = Rtt_NEW(allocator, ShaderResource(program, ShaderTypes::kCategoryDefault));
+			program->SetShaderResource(shader);
+			shaders.push_back(shader);
+
+			RenderData d;
+			d.fGeometry = &quad;
+			d.fProgram = program;
+			data.push_back(d);
+		}
+
+		const S64 count = state.Range(0);
+		TimeTransform timeTransform;
+		while (state.KeepRunning())
+		{
+			renderer.BeginFrame(0.0f, 0.0f, &timeTransform, 1.0f);
+			for (S64 i = 0; i < count; i++)
+			{
+				renderer.Insert(&data[i % data.size()]);
+			}
+			renderer.EndFrame();
+			renderer.Swap();
+			renderer.Render();
+		}
+		state.SetItemsProcessed(state.Iterations() * count);
+
+		for (size_t i = 0; i < shaders.size(); i++)
+		{
+			Rtt_DELETE(shaders[i]);
+		}
+	}
+	Rtt_BENCHMARK(BM_RendererInsert)->Args({ 100, 1 })->Args({ 1000, 1 })->Args({ 10000, 1 })->Args({ 1000, 2 });
+
+	// ------------------------------------------------------------------------
+	// Display
+
+	static void AddChildren(GroupObject* parent, S64 depth, S64 fanout, S64& count)
+	{
+		for (S64 i = 0; i < fanout && depth > 0; i++)
+		{
+			GroupObject* child = Rtt_NEW(parent->Allocator(), GroupObject(parent->Allocator(), NULL));
+			parent->Insert(-1, child, false);
+			count++;
+			AddChildren(child, depth - 1, fanout, count);
+		}
+	}
+
+	// Moves the root of a tree Range(0) levels deep with Range(1) children
+	// per group, so every transform below it is recomputed.
+	static void BM_GroupUpdateTransform(BenchState& state)
+	{
+		Rtt_Allocator* allocator = Allocator();
+		GroupObject* root = Rtt_NEW(allocator, GroupObject(allocator, NULL));
+		S64 count = 1;
+		AddChildren(root, state.Range(0), state.Range(1), count);
+
+		Matrix identity;
+		root->UpdateTransform(identity);
+
+		Real dx = Rtt_REAL_1;
+		while (state.KeepRunning())
+		{
+			dx = -dx;
+			root->Translate(dx, 0);
+			root->UpdateTransform(identity);
+		}
+		state.SetItemsProcessed(state.Iterations() * count);
+
+		Rtt_DELETE(root);
+	}
+	Rtt_BENCHMARK(BM_GroupUpdateTransform)->Args({ 1, 1000 })->Args({ 3, 10 })->Args({ 10, 2 })->Args({ 100, 1 });
+
+	// Radius in content units; the subdivision depth grows with it.
+	static void BM_TesselatorAppendCircle(BenchState& state)
+	{
+		TesselatorCircle circle(Rtt_IntToReal(state.Range(0)));
+		ArrayVertex2 vertices(Allocator());
+
+		S64 generated = 0;
+		while (state.KeepRunning())
+		{
+			vertices.Clear();
+			circle.GenerateFill(vertices);
+			generated += vertices.Length();
+		}
+		state.SetItemsProcessed(generated);
+	}
+	Rtt_BENCHMARK(BM_TesselatorAppendCircle)->Arg(4)->Arg(64)->Arg(512);
+
+	static void BM_MatrixConcat(BenchState& state)
+	{
+		Matrix parent;
+		parent.Translate(Rtt_IntToReal(120), Rtt_IntToReal(40));
+		parent.Rotate(Rtt_IntToReal(30));
+		Matrix child;
+		child.Scale(Rtt_REAL_2, Rtt_REAL_HALF);
+		child.Translate(Rtt_IntToReal(8), Rtt_IntToReal(-8));
+
+		while (state.KeepRunning())
+		{
+			Matrix m(parent);
+			m.Concat(child);
+			DoNotOptimize(m);
+		}
+		state.SetItemsProcessed(state.Iterations());
+	}
+	Rtt_BENCHMARK(BM_MatrixConcat);
+
+	// ------------------------------------------------------------------------
+	// Core
+
+	// The display object property table, looked up the way Lua field access
+	// does. A quarter of the lookups miss.
+	static void BM_StringHashLookup(BenchState& state)
+	{
+		static const char* keys[] =
+		{
+			"translate", "scale", "rotate", "getParent", "setReferencePoint",
+			"removeSelf", "localToContent", "contentToLocal", "isVisible", "isHitTestable",
+			"alpha", "parent", "stage", "x", "y",
+			"anchorX", "anchorY", "contentBounds", "contentWidth", "contentHeight",
+			"toFront", "toBack", "setMask", "maskX", "maskY",
+			"maskScaleX", "maskScaleY", "maskRotation", "isHitTestMasked", "_setHasListener",
+		};
+		const int numKeys = sizeof(keys) / sizeof(const char*);
+		static StringHash sHash(*Allocator(), keys, numKeys, 30, 29, 6, __FILE__, __LINE__);
+
+		static const char* queries[] =
+		{
+			"x", "y", "alpha", "isVisible", "rotation", "contentBounds", "width", "anchorX",
+		};
+		const int numQueries = sizeof(queries) / sizeof(const char*);
+
+		int sum = 0;
+		while (state.KeepRunning())
+		{
+			for (int i = 0; i < numQueries; i++)
+			{
+				sum += sHash.Lookup(queries[i]);
+			}
+		}
+		DoNotOptimize(sum);
+		state.SetItemsProcessed(state.Iterations() * numQueries);
+	}
+	Rtt_BENCHMARK(BM_StringHashLookup);
+
+	static int WriteChunk(lua_State* L, const void* p, size_t size, void* ud)
+	{
+		return fwrite(p, 1, size, (FILE*)ud) == size ? 0 : 1;
+	}
+
+	// Loads a precompiled chunk with Range(0) functions from a .car, as
+	// require() does for every module of a built app.
+	static void BM_ArchiveLoadResource(BenchState& state)
+	{
+		char dirTemplate[] = "/tmp/Solar2DBenchXXXXXX";
+		const char* dir = Rtt_MakeTempDirectory(dirTemplate);
+		if (!dir)
+		{
+			state.SetLabel("no temp directory");
+			while (state.KeepRunning()) {}
+			return;
+		}
+		string luPath = string(dir) + "/bench.lu";
+		string carPath = string(dir) + "/bench.car";
+
+		lua_State* L = luaL_newstate();
+
+		string source;
+		for (S64 i = 0; i < state.Range(0); i++)
+		{
+			source += "local function f" + to_string(i) + "(a, b) return a * " + to_string(i) + " + b end\n";
+		}
+		source += "return true\n";
+		luaL_loadstring(L, source.c_str());
+		FILE* f = Rtt_FileOpen(luPath.c_str(), "wb");
+		if (f)
+		{
+			lua_dump(L, WriteChunk, f);
+			Rtt_FileClose(f);
+		}
+		lua_pop(L, 1);
+
+		const char* srcPaths[] = { luPath.c_str() };
+		Archive::Serialize(carPath.c_str(), 1, srcPaths);
+
+		{
+			Archive archive(*Allocator(), carPath.c_str());
+			while (state.KeepRunning())
+			{
+				archive.LoadResource(L, "bench.lu");
+				lua_pop(L, 1);
+			}
+		}
+		state.SetItemsProcessed(state.Iterations());
+
+		lua_close(L);
+		Rtt_DeleteFile(carPath.c_str());
+		Rtt_DeleteFile(luPath.c_str());
+		Rtt_DeleteDirectory(dir);
+	}
+	Rtt_BENCHMARK(BM_ArchiveLoadResource)->Arg(10)->Arg(1000);
+
+	// ------------------------------------------------------------------------
+	// Input
+
+	// Range(0) lines in the gamecontrollerdb.txt format, half of them for
+	// another platform. ParseLine() is private, so this goes through
+	// LoadFromString(), which only adds the line splitting.
+	static void BM_GameControllerDBParseLine(BenchState& state)
+	{
+		string text("# Game Controller DB\n");
+		for (S64 i = 0; i < state.Range(0); i++)
+		{
+			char line[512];
+			snprintf(line, sizeof(line),
+				"03000000%04x0000%04x000001000000,Benchmark Pad %d,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,"
+				"dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,"
+				"rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:%s,\n",
+				(unsigned)(i & 0xffff), (unsigned)((i * 7) & 0xffff), (int)i, (i & 1) ? "Windows" : "Linux");
+			text += line;
+		}
+
+		GameControllerDB* db = GameControllerDB::GetInstance();
+		while (state.KeepRunning())
+		{
+			db->Clear();
+			db->LoadFromString(text.c_str());
+		}
+		db->Clear();
+		state.SetItemsProcessed(state.Iterations() * state.Range(0));
+	}
+	Rtt_BENCHMARK(BM_GameControllerDBParseLine)->Arg(100)->Arg(2000);
+
+	// ------------------------------------------------------------------------
+	// JSON
+
+	// Leaves json and a table of Range(0) records on the stack. json only
+	// finds the native codec when Range(1) is 1, so it's pure dkjson otherwise.
+	static lua_State* NewJsonState(S64 count, bool useNative)
+	{
+		lua_State* L = luaL_newstate();
+		luaL_openlibs(L);
+		Lua::RegisterModuleLoader(L, "dkjson", Lua::Open< luaload_dkjson >);
+		Lua::RegisterModuleLoader(L, "json", Lua::Open< luaload_json >);
+		Lua::RegisterModuleLoader(L, "lpeg", luaopen_lpeg);
+		if (useNative)
+		{
+			Lua::RegisterModuleLoader(L, "json.native", LuaLibJSON::Open);
+		}
+
+		const char kSetup[] =
+			"local n = ...\n"
+			"local t = {}\n"
+			"for i = 1, n do\n"
+			"  t[i] = { id = i, name = 'item' .. i, x = i * 0.5, tags = { 'a', 'b' }, flag = i % 2 == 0 }\n"
+			"end\n"
+			"return require 'json', t\n";
+		if (luaL_loadstring(L, kSetup) != 0)
+		{
+			fprintf(stderr, "%s\n", lua_tostring(L, -1));
+			lua_close(L);
+			return NULL;
+		}
+		lua_pushinteger(L, (lua_Integer)count);
+		if (lua_pcall(L, 1, 2, 0) != 0)
+		{
+			fprintf(stderr, "%s\n", lua_tostring(L, -1));
+			lua_close(L);
+			return NULL;
+		}
+		return L;
+	}
+
+	static void BM_JsonEncode(BenchState& state)
+	{
+		lua_State* L = NewJsonState(state.Range(0), state.Range(1) != 0);
+		if (!L)
+		{
+			state.SetLabel("json module missing");
+			while (state.KeepRunning()) {}
+			return;
+		}
+
+		lua_getfield(L, -2, "encode");
+		int encode = lua_gettop(L);
+		int table = encode - 1;
+		while (state.KeepRunning())
+		{
+			lua_pushvalue(L, encode);
+			lua_pushvalue(L, table);
+			lua_call(L, 1, 1);
+			lua_pop(L, 1);
+		}
+		state.SetItemsProcessed(state.Iterations() * state.Range(0));
+		lua_close(L);
+	}
+	Rtt_BENCHMARK(BM_JsonEncode)->Args({10, 0})->Args({10, 1})->Args({1000, 0})->Args({1000, 1});
+
+	static void BM_JsonDecode(BenchState& state)
+	{
+		lua_State* L = NewJsonState(state.Range(0), state.Range(1) != 0);
+		if (!L)
+		{
+			state.SetLabel("json module missing");
+			while (state.KeepRunning()) {}
+			return;
+		}
+
+		lua_getfield(L, -2, "encode");
+		lua_pushvalue(L, -2);
+		lua_call(L, 1, 1);
+		int text = lua_gettop(L);
+		lua_getfield(L, -3, "decode");
+		int decode = lua_gettop(L);
+		while (state.KeepRunning())
+		{
+			lua_pushvalue(L, decode);
+			lua_pushvalue(L, text);
+			lua_call(L, 1, 1);
+			lua_pop(L, 1);
+		}
+		state.SetItemsProcessed(state.Iterations() * state.Range(0));
+		lua_close(L);
+	}
+	Rtt_BENCHMARK(BM_JsonDecode)->Args({10, 0})->Args({10, 1})->Args({1000, 0})->Args({1000, 1});
+}
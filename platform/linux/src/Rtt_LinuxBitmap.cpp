@@ -13,6 +13,7 @@
 #include "Rtt_LinuxContainer.h"
 #include "Display/Rtt_Display.h"
 #include "Core/Rtt_Types.h"
+#include "Core/Rtt_MappedFile.h"
 #include "Rtt_BitmapUtils.h"
 
 namespace Rtt
@@ -103,15 +104,15 @@ namespace Rtt
 	{
 		Rtt_ASSERT(fData == NULL);
 
-		FILE* f = fopen(path, "rb");
-		if (f)
+		// Decode straight from the mapped file rather than through stdio
+		SharedPtr<MappedFile> file = MappedFile::Open(&context, path);
+		if (file.NotNull())
 		{
-			fData = bitmapUtil::loadPNG(f, fWidth, fHeight);
+			fData = bitmapUtil::loadPNG(file->GetBytes(), file->GetLength(), fWidth, fHeight);
 			if (fData)
 			{
 				fFormat = kRGBA;
 			}
-			fclose(f);
 		}
 
 		if (fData && fFormat == kRGBA)
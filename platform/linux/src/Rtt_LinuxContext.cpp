@@ -28,6 +28,7 @@
 #include "Rtt_LinuxUtils.h"
 #include "Rtt_MPlatformServices.h"
 #include "Rtt_LinuxApp.h"
+#include "Rtt_LinuxRenderThread.h"
 #include "Rtt_HTTPClient.h"
 #include "Rtt_LinuxCEF.h"
 #include <curl/curl.h>
@@ -60,6 +61,10 @@ namespace Rtt
 		, fProjectSettings(new ProjectSettings())
 		, fWindow(window)
 		, fBeginRunLoop(true)
+		, fRenderThread(NULL)
+		, fNextStepTime(0)
+		, fBackend(NULL)
+		, fBackendState(NULL)
 	{
 	}
 
@@ -74,6 +79,12 @@ namespace Rtt
 		fConfig["w"] = w;
 		fConfig["h"] = h;
 
+		if (fRenderThread)
+		{
+			fRuntime->GetDisplay().SetRenderThread(NULL);
+			delete fRenderThread;
+		}
+
 		delete fRuntime;
 		delete fRuntimeDelegate;
 		delete fPlatform;
@@ -124,6 +135,10 @@ namespace Rtt
 		fPlatform = new LinuxPlatform(fPathToApp.c_str(), documentsDir.c_str(), temporaryDir.c_str(), cachesDir.c_str(), systemCachesDir.c_str(), skinDir.c_str(), GetStartupPath(NULL));
 		fRuntime = new LinuxRuntime(*fPlatform, NULL);
 		fRuntime->SetDelegate(fRuntimeDelegate);
+		if (fBackend)
+		{
+			fRuntime->SetBackend(fBackend, fBackendState);
+		}
 
 		if (app->IsRunningOnSimulator())
 		{
@@ -330,6 +345,14 @@ namespace Rtt
 		}
 
 		SetTitle(title.empty() ? fAppName : title);
+
+		// Opt-in: renderThread=true in the app's config file
+		if (RequestsRenderThread() && app->AllowsRenderThread())
+		{
+			fRenderThread = new LinuxRenderThread(fWindow, app->GetGLContext(), app->GetImGuiContext());
+			fRuntime->GetDisplay().SetRenderThread(fRenderThread);
+			fRenderThread->Start();
+		}
 		return true;
 	}
 
@@ -355,14 +378,67 @@ namespace Rtt
 		deviceManager.dispatchEvents(fRuntime);
 
 		// advance engine
-		(*fRuntime)();
+		if (fRuntime->GetTimer()->GetFrameSync())
+		{
+			// Render on every pass, at the display's refresh rate, but only
+			// step logic at the configured fps. A late tick moves the schedule
+			// instead of running extra ticks to catch up.
+			uint64_t now = Rtt_AbsoluteToMicroseconds(Rtt_GetAbsoluteTime());
+			if (now >= fNextStepTime)
+			{
+				uint64_t interval = 1000000 / fRuntime->GetFPS();
+				fNextStepTime = (now - fNextStepTime < interval) ? fNextStepTime + interval : now + interval;
+				fRuntime->Step();
+			}
+			fRuntime->Render();
+		}
+		else
+		{
+			(*fRuntime)();
+		}
+	}
+
+	float SolarAppContext::GetFrameDuration() const
+	{
+		double rate = GetFPS();
+		if (fRuntime && fRuntime->GetTimer()->GetFrameSync())
+		{
+			double refreshRate = fRuntime->GetTimer()->GetRefreshRate();
+			if (refreshRate > rate)
+			{
+				rate = refreshRate;
+			}
+		}
+		return (float)(1000.0 / rate);
 	}
 
 	void SolarAppContext::Flush()
 	{
-		app->RenderGUI();
-		fRuntime->GetDisplay().Invalidate();
-		SDL_GL_SwapWindow(fWindow);
+		if (fRenderThread && fRenderThread->IsRunning())
+		{
+			app->LayoutGUI();
+		}
+		else
+		{
+			app->RenderGUI();
+		}
+
+		// With partial redraw the scene decides itself when to present. The
+		// simulator keeps redrawing so its GUI stays responsive.
+		Display& display = fRuntime->GetDisplay();
+		if (!display.GetDefaults().IsPartialRedraw() || app->IsRunningOnSimulator())
+		{
+			display.Invalidate();
+		}
+
+		if (fRenderThread && fRenderThread->IsRunning())
+		{
+			fRenderThread->Present(fRuntime->IsSuspended());
+		}
+		else
+		{
+			SDL_GL_SwapWindow(fWindow);
+		}
 	}
 
 	void SolarAppContext::Pause()
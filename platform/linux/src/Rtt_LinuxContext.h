@@ -31,6 +31,7 @@ namespace Rtt
 {
 	class SolarApp;
 	class LinuxPlatform;
+	class LinuxRenderThread;
 
 	struct Config
 	{
@@ -70,6 +71,7 @@ namespace Rtt
 		void Resume();
 		void RestartRenderer();
 		int GetFPS() const { return fRuntime ? fRuntime->GetFPS() : 30; }
+		float GetFrameDuration() const;	// main loop interval in ms
 		int GetWidth() const;
 		void SetWidth(int val);
 		int GetHeight() const;
@@ -77,6 +79,11 @@ namespace Rtt
 		const ProjectSettings* GetProjectSettings() const { return fProjectSettings;}
 		void Flush();
 		bool LoadApp(const std::string& appPath);
+		// Takes effect on the next LoadApp(); see Runtime::SetBackend()
+		void SetBackend(const char* backend, void* backendState) { fBackend = backend; fBackendState = backendState; }
+		// renderThread=true in the app's config file; see SolarApp::AllowsRenderThread()
+		bool RequestsRenderThread() const { return fConfig.HasItem("renderThread") && fConfig["renderThread"].to_bool(); }
+		bool UsesRenderThread() const { return NULL != fRenderThread; }
 		const std::string& GetAppPath() const { return fPathToApp; }
 		LinuxPlatform* GetPlatform() const { return fPlatform; }
 		const std::string& GetAppName() const { return fAppName; }
@@ -115,6 +122,10 @@ namespace Rtt
 		SDL_Window* fWindow;
 		Config fConfig;
 		bool fBeginRunLoop;
+		LinuxRenderThread* fRenderThread;
+		uint64_t fNextStepTime;	// microseconds, with renderSync
+		const char* fBackend;
+		void* fBackendState;
 	};
 }; // namespace Rtt
 
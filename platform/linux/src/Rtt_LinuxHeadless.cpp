@@ -0,0 +1,275 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+#include "Core/Rtt_Time.h"
+#include "Rtt_LinuxHeadless.h"
+#include "Display/Rtt_Display.h"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+namespace Rtt
+{
+	// Renderer::Statistics as (name, value) pairs, in declaration order
+	static const char* kStatisticsNames[] =
+	{
+		"resourceCreateTime",
+		"resourceUpdateTime",
+		"resourceDestroyTime",
+		"preparationTime",
+		"renderTimeCPU",
+		"renderTimeGPU",
+		"drawCallCount",
+		"triangleCount",
+		"lineCount",
+		"geometryBindCount",
+		"programBindCount",
+		"textureBindCount",
+		"uniformBindCount",
+	};
+
+	enum { kStatisticsCount = sizeof(kStatisticsNames) / sizeof(kStatisticsNames[0]) };
+
+	static void GetStatisticsValues(const Renderer::Statistics& s, double values[kStatisticsCount])
+	{
+		int i = 0;
+		values[i++] = s.fResourceCreateTime;
+		values[i++] = s.fResourceUpdateTime;
+		values[i++] = s.fResourceDestroyTime;
+		values[i++] = s.fPreparationTime;
+		values[i++] = s.fRenderTimeCPU;
+		values[i++] = s.fRenderTimeGPU;
+		values[i++] = s.fDrawCallCount;
+		values[i++] = s.fTriangleCount;
+		values[i++] = s.fLineCount;
+		values[i++] = s.fGeometryBindCount;
+		values[i++] = s.fProgramBindCount;
+		values[i++] = s.fTextureBindCount;
+		values[i++] = s.fUniformBindCount;
+		Rtt_ASSERT(i == kStatisticsCount);
+	}
+
+	static string JsonString(const char* s)
+	{
+		string result("\"");
+		for (; s && *s; s++)
+		{
+			switch (*s)
+			{
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n"; break;
+			default:
+				if ((unsigned char)*s >= 0x20)
+				{
+					result += *s;
+				}
+				break;
+			}
+		}
+		result += "\"";
+		return result;
+	}
+
+	// Nearest rank, on sorted values
+	static double Percentile(const vector<double>& sorted, double p)
+	{
+		if (sorted.empty())
+		{
+			return 0.0;
+		}
+		size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+		return sorted[Min(index, sorted.size() - 1)];
+	}
+
+	HeadlessApp::Options::Options()
+		: frames(600)
+		, width(0)
+		, height(0)
+		, nullRenderer(false)
+		, captureFrame(-1)
+	{
+	}
+
+	HeadlessApp::HeadlessApp(const string& appPath, const Options& options)
+		: SolarApp(appPath)
+		, fOptions(options)
+	{
+	}
+
+	HeadlessApp::~HeadlessApp()
+	{
+	}
+
+	bool HeadlessApp::Init()
+	{
+		// Can still be overridden, e.g. SDL_VIDEODRIVER=x11 to watch a run
+		setenv("SDL_VIDEODRIVER", "offscreen", 0);
+
+		if (!InitSDL())
+		{
+			return false;
+		}
+
+		// Presenting would only throttle the run
+		SDL_GL_SetSwapInterval(0);
+
+		if (!LoadApp(fResourceDir))
+		{
+			return false;
+		}
+
+		if (fOptions.width > 0 && fOptions.height > 0)
+		{
+			fContext->SetSize(fOptions.width, fOptions.height);
+		}
+
+		if (fContext->RequestsRenderThread())
+		{
+			Rtt_LogException("WARNING: renderThread is ignored; frames are measured with rendering on the main thread\n");
+		}
+		return true;
+	}
+
+	bool HeadlessApp::LoadApp(const string& path)
+	{
+		fContext = new SolarAppContext(fWindow);
+		if (fOptions.nullRenderer)
+		{
+			const char* stream = fOptions.commandStream.empty() ? NULL : fOptions.commandStream.c_str();
+			fContext->SetBackend("nullBackend", (void*)stream);
+		}
+		return fContext->LoadApp(path);
+	}
+
+	int HeadlessApp::RunFrames()
+	{
+		Runtime* runtime = GetRuntime();
+		if (!runtime)
+		{
+			return 1;
+		}
+
+		runtime->SetUsesFixedTime(true);
+		runtime->GetDisplay().GetRenderer().SetStatisticsEnabled(true);
+
+		// Rtt_AbsoluteTime is in microseconds on Linux
+		const Rtt_AbsoluteTime step = 1000000 / runtime->GetFPS();
+
+		vector<FrameRecord> records;
+		records.reserve(fOptions.frames);
+
+		Rtt_AbsoluteTime start = Rtt_GetAbsoluteTime();
+		for (int i = 0; i < fOptions.frames; i++)
+		{
+			if (!PollEvents())
+			{
+				break;
+			}
+
+			runtime->AdvanceFixedTime(step);
+
+			if (i == fOptions.captureFrame)
+			{
+				runtime->GetDisplay().GetRenderer().CaptureNextFrame(fOptions.capturePath.c_str());
+			}
+
+			Rtt_AbsoluteTime frameStart = Rtt_GetAbsoluteTime();
+			fContext->advance();
+
+			FrameRecord record;
+			record.fFrameTime = Rtt_AbsoluteToMicroseconds(Rtt_GetAbsoluteTime() - frameStart) / 1000.0;
+			record.fStatistics = runtime->GetDisplay().GetRenderer().GetFrameStatistics();
+			records.push_back(record);
+		}
+		double totalTime = Rtt_AbsoluteToMicroseconds(Rtt_GetAbsoluteTime() - start) / 1000.0;
+
+		return WriteReport(records, totalTime) ? 0 : 1;
+	}
+
+	bool HeadlessApp::WriteReport(const vector<FrameRecord>& records, double totalTime) const
+	{
+		FILE* f = fOptions.output.empty() ? stdout : fopen(fOptions.output.c_str(), "w");
+		if (!f)
+		{
+			Rtt_LogException("Cannot write %s\n", fOptions.output.c_str());
+			return false;
+		}
+
+		const Runtime* runtime = GetRuntime();
+		const size_t count = records.size();
+
+		vector<double> frameTimes;
+		double sums[kStatisticsCount] = {};
+		double maxima[kStatisticsCount] = {};
+		for (size_t i = 0; i < count; i++)
+		{
+			frameTimes.push_back(records[i].fFrameTime);
+
+			double values[kStatisticsCount];
+			GetStatisticsValues(records[i].fStatistics, values);
+			for (int j = 0; j < kStatisticsCount; j++)
+			{
+				sums[j] += values[j];
+				maxima[j] = Max(maxima[j], values[j]);
+			}
+		}
+		sort(frameTimes.begin(), frameTimes.end());
+
+		fprintf(f, "{\n");
+		fprintf(f, "\t\"app\": %s,\n", JsonString(GetAppName().c_str()).c_str());
+		fprintf(f, "\t\"renderer\": \"%s\",\n", fOptions.nullRenderer ? "null" : "gl");
+		fprintf(f, "\t\"gpu\": %s,\n", JsonString(Display::GetGlString("GL_RENDERER")).c_str());
+		fprintf(f, "\t\"width\": %d,\n", fContext->GetWidth());
+		fprintf(f, "\t\"height\": %d,\n", fContext->GetHeight());
+		fprintf(f, "\t\"fps\": %u,\n", runtime->GetFPS());
+		fprintf(f, "\t\"renderThread\": %s,\n", fContext->UsesRenderThread() ? "true" : "false");
+		fprintf(f, "\t\"renderThreadRequested\": %s,\n", fContext->RequestsRenderThread() ? "true" : "false");
+		fprintf(f, "\t\"frames\": %zu,\n", count);
+		fprintf(f, "\t\"totalTime\": %.3f,\n", totalTime);
+		fprintf(f, "\t\"frameTime\": { \"mean\": %.3f, \"min\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n",
+			count > 0 ? totalTime / count : 0.0,
+			count > 0 ? frameTimes.front() : 0.0,
+			Percentile(frameTimes, 0.5), Percentile(frameTimes, 0.95), Percentile(frameTimes, 0.99),
+			count > 0 ? frameTimes.back() : 0.0);
+
+		fprintf(f, "\t\"statistics\": {\n");
+		for (int j = 0; j < kStatisticsCount; j++)
+		{
+			fprintf(f, "\t\t\"%s\": { \"mean\": %.3f, \"max\": %.3f }%s\n", kStatisticsNames[j],
+				count > 0 ? sums[j] / count : 0.0, maxima[j], j + 1 < kStatisticsCount ? "," : "");
+		}
+		fprintf(f, "\t},\n");
+
+		fprintf(f, "\t\"perFrame\": [\n");
+		for (size_t i = 0; i < count; i++)
+		{
+			double values[kStatisticsCount];
+			GetStatisticsValues(records[i].fStatistics, values);
+
+			fprintf(f, "\t\t{ \"frameTime\": %.3f", records[i].fFrameTime);
+			for (int j = 0; j < kStatisticsCount; j++)
+			{
+				fprintf(f, ", \"%s\": %.3f", kStatisticsNames[j], values[j]);
+			}
+			fprintf(f, " }%s\n", i + 1 < count ? "," : "");
+		}
+		fprintf(f, "\t]\n");
+		fprintf(f, "}\n");
+
+		if (f != stdout)
+		{
+			fclose(f);
+		}
+		return true;
+	}
+}
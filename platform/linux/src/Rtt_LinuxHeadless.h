@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Rtt_LinuxApp.h"
+#include "Renderer/Rtt_Renderer.h"
+
+namespace Rtt
+{
+	// Runs an app without a visible window for a fixed number of frames, e.g.
+	// for performance regression runs on CI machines without a GPU. SDL's
+	// offscreen video driver backs the GL context with an EGL pbuffer, which
+	// Mesa's llvmpipe provides. Time advances by exactly one frame interval
+	// per frame, so every run executes the same Lua.
+	struct HeadlessApp : public SolarApp
+	{
+		struct Options
+		{
+			Options();
+
+			int frames;
+			int width;			// 0 keeps the app's own size
+			int height;
+			std::string output;	// empty for stdout
+			bool nullRenderer;	// measure the CPU side only, see NullRenderer
+			std::string commandStream;	// with nullRenderer, empty for none
+			int captureFrame;	// -1 for none, see CaptureCommandBuffer
+			std::string capturePath;
+		};
+
+		HeadlessApp(const std::string& appPath, const Options& options);
+		virtual ~HeadlessApp();
+
+		bool Init() override;
+		bool LoadApp(const std::string& path) override;
+		// Off even if the app's config file asks for it: the runner reads GL
+		// state and statistics between frames on the main thread. The report
+		// records whether the app would have used one.
+		bool AllowsRenderThread() override { return false; }
+
+		// Returns the process exit code.
+		int RunFrames();
+
+	private:
+		struct FrameRecord
+		{
+			double fFrameTime;	// ms of wall time, Lua and rendering
+			Renderer::Statistics fStatistics;
+		};
+
+		bool WriteReport(const std::vector<FrameRecord>& records, double totalTime) const;
+
+		Options fOptions;
+	};
+}
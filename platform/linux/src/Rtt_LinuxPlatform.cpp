@@ -38,7 +38,8 @@ namespace Rtt
 		fSystemCachesDir(fAllocator),
 		fInstallDir(fAllocator),
 		fSkinDir(fAllocator),
-		fScreenSurface(NULL)
+		fScreenSurface(NULL),
+		fPreferenceStore(systemCachesDir)
 	{
 		fResourceDir.Set(resourceDir);
 		fDocumentsDir.Set(documentsDir);
@@ -107,6 +108,16 @@ namespace Rtt
 		return result;
 	}
 
+	double LinuxTimer::GetRefreshRate() const
+	{
+		SDL_DisplayMode mode;
+		if (SDL_GetCurrentDisplayMode(0, &mode) == 0 && mode.refresh_rate > 0)
+		{
+			return mode.refresh_rate;
+		}
+		return 0.0;
+	}
+
 	PlatformTimer* LinuxPlatform::CreateTimerWithCallback(MCallback& callback) const
 	{
 		return Rtt_NEW(fAllocator, LinuxTimer(callback));
@@ -725,96 +736,28 @@ namespace Rtt
 
 	Preference::ReadValueResult LinuxPlatform::GetPreference(const char* categoryName, const char* keyName) const
 	{
-		// add category name as prefix
-		std::string key(categoryName);
-
-		if (strlen(keyName) > 0)
-		{
-			key += '.';
-			key += keyName;
-		}
-		char val[1024];
-
-		// maybe it would be better to use sqlite3 ??
-		std::string path = fSystemCachesDir.GetString();
-		path += '/';
-		path += key;
-		FILE* f = fopen(path.c_str(), "rb");
-		bool rc = false;
-
-		if (f)
-		{
-			int n = fread(val, 1, sizeof(val) - 1, f);
-			val[n] = '\0';
-			fclose(f);
-			rc = true;
-		}
-
-		return rc == false ? Preference::ReadValueResult::kPreferenceNotFound : Preference::ReadValueResult::SucceededWith(val);
+		return fPreferenceStore.Fetch(categoryName, keyName);
 	}
 
 	OperationResult LinuxPlatform::SetPreferences(const char* categoryName, const PreferenceCollection& preferences) const
 	{
-		bool rc = true;
-
-		for (int index = preferences.GetCount() - 1; index >= 0 && rc == true; index--)
-		{
-			// Fetch the next preference to write to the database.
-			auto preferencePointer = preferences.GetByIndex(index);
-
-			if (preferencePointer != NULL)
-			{
-				// add category name as prefix
-				std::string key(categoryName);
-				key += '.';
-				key += preferencePointer->GetKeyName();
-
-				PreferenceValue pval = preferencePointer->GetValue();
-
-				// Insert the preference value as string.
-				PreferenceValue::StringResult strval = pval.ToString();
-				const char* val = strval.GetValue()->c_str();
-
-				// maybe it would be better to use sqlite3 ??
-				std::string path = fSystemCachesDir.GetString();
-				path += '/';
-				path += key;
-				FILE* f = fopen(path.c_str(), "wb");
-
-				if (f)
-				{
-					fwrite(val, 1, strlen(val), f);
-					fclose(f);
-					rc = true;
-				}
-			}
-		}
-		return rc == false ? OperationResult::FailedWith("SetPreferences failed") : Rtt::OperationResult::kSucceeded;
+		return fPreferenceStore.UpdateWith(categoryName, preferences);
 	}
 
 	OperationResult LinuxPlatform::DeletePreferences(const char* categoryName, const char** keyNameArray, U32 keyNameCount) const
 	{
-		bool rc = true;
-
-		for (int i = 0; i < keyNameCount && keyNameArray && rc; i++)
-		{
-			// Fetch the next preference key, add category name as prefix
-			std::string key(categoryName);
-			key += '.';
-			key += keyNameArray[i];
+		return fPreferenceStore.Delete(categoryName, keyNameArray, keyNameCount);
+	}
 
-			// maybe it would be better to use sqlite3 ??
-			std::string path = fSystemCachesDir.GetString();
-			path += '/';
-			path += key;
-			int n = Rtt_DeleteFile(path.c_str());
-			rc = n == 0 ? true : false;
-		}
-		return rc == false ? OperationResult::FailedWith("DeletePreferences failed") : Rtt::OperationResult::kSucceeded;
+	OperationResult LinuxPlatform::FlushPreferences() const
+	{
+		return fPreferenceStore.Flush();
 	}
 
 	void LinuxPlatform::Suspend() const
 	{
+		// The app may not come back
+		fPreferenceStore.Flush();
 	}
 
 	void LinuxPlatform::Resume() const
@@ -12,6 +12,7 @@
 #include "Rtt_LinuxDevice.h"
 #include "Rtt_MPlatform.h"
 #include "Rtt_LinuxCrypto.h"
+#include "Rtt_LinuxPreferenceStore.h"
 #include "Core/Rtt_String.h"
 #include "Rtt_PlatformTimer.h"
 #include "Rtt_PlatformSimulator.h"
@@ -24,15 +25,27 @@ namespace Rtt
 	class RenderingStream;
 	class LinuxScreenSurface;
 
+	// The main loop in SolarApp::Run() drives the runtime, so this only
+	// carries its settings.
 	class LinuxTimer : public PlatformTimer
 	{
 	public:
-		LinuxTimer(MCallback &callback) : PlatformTimer(callback) {};
+		LinuxTimer(MCallback &callback) : PlatformTimer(callback), fFrameSync(false) {};
 
 		virtual void Start() {};
 		virtual void Stop() {};
 		virtual void SetInterval(U32 milliseconds) {};
 		virtual bool IsRunning() const { return true; };
+
+		virtual double GetRefreshRate() const;
+
+		// When true, the main loop renders at the refresh rate and runs logic
+		// ticks at the configured fps; see SolarAppContext::advance().
+		virtual bool GetFrameSync() const { return fFrameSync; }
+		virtual void SetFrameSync(bool enabled) { fFrameSync = enabled; }
+
+	private:
+		bool fFrameSync;
 	};
 
 	class LinuxPlatform : public MPlatform
@@ -141,12 +154,14 @@ namespace Rtt
 		String fSkinDir;
 		LinuxCrypto fCrypto;
 		mutable LinuxScreenSurface *fScreenSurface;
+		mutable LinuxPreferenceStore fPreferenceStore;
 
 	public:
 		virtual void GetSafeAreaInsetsPixels(Rtt_Real &top, Rtt_Real &left, Rtt_Real &bottom, Rtt_Real &right) const override;
 		virtual Preference::ReadValueResult GetPreference(const char *categoryName, const char *keyName) const override;
 		virtual OperationResult SetPreferences(const char *categoryName, const PreferenceCollection &collection) const override;
 		virtual OperationResult DeletePreferences(const char *categoryName, const char **keyNameArray, U32 keyNameCount) const override;
+		virtual OperationResult FlushPreferences() const override;
 		virtual void Suspend() const override;
 		virtual void Resume() const override;
 	};
@@ -0,0 +1,481 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+#include "Core/Rtt_FileSystem.h"
+#include "Rtt_LinuxPreferenceStore.h"
+#include "sqlite3.h"
+#include <stdio.h>
+
+namespace Rtt
+{
+	LinuxPreferenceStore::LinuxPreferenceStore(const char *directoryPath)
+		: fDirectoryPath(directoryPath ? directoryPath : ""),
+		fDatabase(NULL),
+		fInsertStatement(NULL),
+		fDeleteStatement(NULL),
+		fQuit(false)
+	{
+	}
+
+	LinuxPreferenceStore::~LinuxPreferenceStore()
+	{
+		Close();
+	}
+
+	std::string LinuxPreferenceStore::MakeKey(const char *categoryName, const char *keyName)
+	{
+		// add category name as prefix
+		std::string key(categoryName);
+
+		if (keyName && strlen(keyName) > 0)
+		{
+			key += '.';
+			key += keyName;
+		}
+		return key;
+	}
+
+	bool LinuxPreferenceStore::MakeRow(const PreferenceValue &value, Row &row)
+	{
+		PreferenceValue::TypeSet supportedTypes;
+		supportedTypes.Add(PreferenceValue::kTypeSignedInt64);
+		supportedTypes.Add(PreferenceValue::kTypeFloatDouble);
+		supportedTypes.Add(PreferenceValue::kTypeString);
+
+		ValueResult<PreferenceValue> conversion = value.ToClosestValueTypeIn(supportedTypes);
+		if (conversion.HasFailed())
+		{
+			return false;
+		}
+
+		PreferenceValue closest = conversion.GetValue();
+		switch (closest.GetType())
+		{
+			case PreferenceValue::kTypeSignedInt64:
+				row.type = SQLITE_INTEGER;
+				row.integer = closest.ToSignedInt64().GetValue();
+				break;
+			case PreferenceValue::kTypeFloatDouble:
+				row.type = SQLITE_FLOAT;
+				row.number = closest.ToFloatDouble().GetValue();
+				break;
+			default:
+			{
+				SharedConstStdStringPtr str = closest.ToString().GetValue();
+				if (str.IsNull())
+				{
+					row.type = SQLITE_NULL;
+				}
+				else
+				{
+					// Strings with embedded nulls are kept whole as blobs
+					row.type = (str->find('\0') != std::string::npos) ? SQLITE_BLOB : SQLITE_TEXT;
+					row.text = *str;
+				}
+				break;
+			}
+		}
+		return true;
+	}
+
+	PreferenceValue LinuxPreferenceStore::MakeValue(const Row &row)
+	{
+		switch (row.type)
+		{
+			case SQLITE_INTEGER:
+				return PreferenceValue(row.integer);
+			case SQLITE_FLOAT:
+				return PreferenceValue(row.number);
+			case SQLITE_TEXT:
+			case SQLITE_BLOB:
+				return PreferenceValue(Rtt_MakeSharedConstStdStringPtr(row.text));
+			default:
+				return PreferenceValue("");
+		}
+	}
+
+	Preference::ReadValueResult LinuxPreferenceStore::Fetch(const char *categoryName, const char *keyName)
+	{
+		OperationResult result = Open();
+		if (result.HasFailed())
+		{
+			return Preference::ReadValueResult::FailedWith(result.GetUtf8Message());
+		}
+
+		std::string key = MakeKey(categoryName, keyName);
+		CacheType::const_iterator it = fCache.find(key);
+		if (it == fCache.end())
+		{
+			if (!ImportLegacyFile(key))
+			{
+				return Preference::ReadValueResult::kPreferenceNotFound;
+			}
+			it = fCache.find(key);
+		}
+		return Preference::ReadValueResult::SucceededWith(it->second);
+	}
+
+	OperationResult LinuxPreferenceStore::UpdateWith(const char *categoryName, const PreferenceCollection &preferences)
+	{
+		OperationResult result = Open();
+		if (result.HasFailed())
+		{
+			return result;
+		}
+
+		// Convert everything first, so a bad value changes nothing
+		UpdateMap updates;
+		for (int index = 0; index < preferences.GetCount(); index++)
+		{
+			Preference *preferencePointer = preferences.GetByIndex(index);
+			if (preferencePointer)
+			{
+				Row &row = updates[MakeKey(categoryName, preferencePointer->GetKeyName())];
+				if (!MakeRow(preferencePointer->GetValue(), row))
+				{
+					return OperationResult::FailedWith("Unsupported preference value type");
+				}
+			}
+		}
+		if (updates.empty())
+		{
+			return OperationResult::kSucceeded;
+		}
+
+		for (UpdateMap::const_iterator it = updates.begin(); it != updates.end(); ++it)
+		{
+			fCache[it->first] = MakeValue(it->second);
+		}
+
+		std::lock_guard<std::mutex> lock(fMutex);
+		if (fPendingUpdates.empty() && fPendingDeletes.empty())
+		{
+			fPendingSince = Clock::now();
+		}
+		for (UpdateMap::const_iterator it = updates.begin(); it != updates.end(); ++it)
+		{
+			fPendingDeletes.erase(it->first);
+			fPendingUpdates[it->first] = it->second;
+		}
+		fCondition.notify_one();
+		return OperationResult::kSucceeded;
+	}
+
+	OperationResult LinuxPreferenceStore::Delete(const char *categoryName, const char **keyNameArray, U32 keyNameCount)
+	{
+		OperationResult result = Open();
+		if (result.HasFailed())
+		{
+			return result;
+		}
+		if (!keyNameArray || keyNameCount == 0)
+		{
+			return OperationResult::kSucceeded;
+		}
+
+		std::lock_guard<std::mutex> lock(fMutex);
+		if (fPendingUpdates.empty() && fPendingDeletes.empty())
+		{
+			fPendingSince = Clock::now();
+		}
+		for (U32 i = 0; i < keyNameCount; i++)
+		{
+			if (keyNameArray[i])
+			{
+				std::string key = MakeKey(categoryName, keyNameArray[i]);
+				fCache.erase(key);
+				fPendingUpdates.erase(key);
+				fPendingDeletes.insert(key);
+			}
+		}
+		fCondition.notify_one();
+		return OperationResult::kSucceeded;
+	}
+
+	OperationResult LinuxPreferenceStore::Flush()
+	{
+		if (!fDatabase)
+		{
+			return OperationResult::kSucceeded;
+		}
+		return WritePending();
+	}
+
+	OperationResult LinuxPreferenceStore::Open()
+	{
+		if (fDatabase)
+		{
+			return OperationResult::kSucceeded;
+		}
+
+		std::string path = fDirectoryPath + "/preferences.sqlite";
+		for (int attemptCount = 1; attemptCount <= 2; attemptCount++)
+		{
+			int rc = sqlite3_open_v2(path.c_str(), &fDatabase, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, NULL);
+			if (rc == SQLITE_OK)
+			{
+				// A transaction is committed by appending to the WAL, instead of
+				// rewriting pages through a rollback journal
+				sqlite3_exec(fDatabase, "PRAGMA journal_mode=WAL", NULL, NULL, NULL);
+				sqlite3_exec(fDatabase, "PRAGMA synchronous=NORMAL", NULL, NULL, NULL);
+				rc = sqlite3_exec(fDatabase, "CREATE TABLE IF NOT EXISTS preference (key TEXT PRIMARY KEY NOT NULL, value VARIANT)", NULL, NULL, NULL);
+			}
+			if (rc == SQLITE_OK)
+			{
+				break;
+			}
+
+			OperationResult result = Fail("Failed to open preferences database");
+			Close();
+
+			// The file is corrupted or isn't a database; start over
+			if ((rc == SQLITE_NOTADB || rc == SQLITE_CORRUPT) && attemptCount == 1 && Rtt_DeleteFile(path.c_str()) == 0)
+			{
+				continue;
+			}
+			return result;
+		}
+
+		sqlite3_prepare_v2(fDatabase, "INSERT OR REPLACE INTO preference (key, value) VALUES (?, ?)", -1, &fInsertStatement, NULL);
+		sqlite3_prepare_v2(fDatabase, "DELETE FROM preference WHERE key = ?", -1, &fDeleteStatement, NULL);
+		if (!fInsertStatement || !fDeleteStatement)
+		{
+			OperationResult result = Fail("Failed to prepare preferences database");
+			Close();
+			return result;
+		}
+
+		// Read every preference up front, so fetching one is a lookup
+		fCache.clear();
+		sqlite3_stmt *statement = NULL;
+		sqlite3_prepare_v2(fDatabase, "SELECT key, value FROM preference", -1, &statement, NULL);
+		while (statement && sqlite3_step(statement) == SQLITE_ROW)
+		{
+			const char *key = (const char *)sqlite3_column_text(statement, 0);
+			if (!key)
+			{
+				continue;
+			}
+
+			Row row;
+			row.type = sqlite3_column_type(statement, 1);
+			switch (row.type)
+			{
+				case SQLITE_INTEGER:
+					row.integer = sqlite3_column_int64(statement, 1);
+					break;
+				case SQLITE_FLOAT:
+					row.number = sqlite3_column_double(statement, 1);
+					break;
+				case SQLITE_TEXT:
+				case SQLITE_BLOB:
+				{
+					const char *bytes = (const char *)sqlite3_column_blob(statement, 1);
+					int length = sqlite3_column_bytes(statement, 1);
+					if (bytes)
+					{
+						row.text.assign(bytes, (size_t)length);
+					}
+					break;
+				}
+			}
+			fCache[key] = MakeValue(row);
+		}
+		sqlite3_finalize(statement);
+
+		fQuit = false;
+		fWriter = std::thread([this]() { Run(); });
+
+		return OperationResult::kSucceeded;
+	}
+
+	void LinuxPreferenceStore::Close()
+	{
+		// The writer commits whatever is still pending before it exits
+		if (fWriter.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(fMutex);
+				fQuit = true;
+			}
+			fCondition.notify_one();
+			fWriter.join();
+		}
+
+		sqlite3_finalize(fInsertStatement);
+		sqlite3_finalize(fDeleteStatement);
+		fInsertStatement = NULL;
+		fDeleteStatement = NULL;
+
+		if (fDatabase)
+		{
+			sqlite3_close(fDatabase);
+			fDatabase = NULL;
+		}
+		fCache.clear();
+	}
+
+	void LinuxPreferenceStore::Run()
+	{
+		std::unique_lock<std::mutex> lock(fMutex);
+		while (true)
+		{
+			fCondition.wait(lock, [this]() { return fQuit || !fPendingUpdates.empty() || !fPendingDeletes.empty(); });
+			if (fPendingUpdates.empty() && fPendingDeletes.empty())
+			{
+				break;
+			}
+
+			// Let more changes gather, unless we're asked to stop
+			fCondition.wait_until(lock, fPendingSince + std::chrono::milliseconds(kWriteDelayMs), [this]() { return fQuit; });
+
+			lock.unlock();
+			OperationResult result = WritePending();
+			if (result.HasFailed())
+			{
+				Rtt_LogException("Failed to save preferences: %s\n", result.GetUtf8Message());
+			}
+			lock.lock();
+		}
+	}
+
+	OperationResult LinuxPreferenceStore::WritePending()
+	{
+		std::lock_guard<std::mutex> databaseLock(fDatabaseMutex);
+
+		UpdateMap updates;
+		DeleteSet deletes;
+		{
+			std::lock_guard<std::mutex> lock(fMutex);
+			updates.swap(fPendingUpdates);
+			deletes.swap(fPendingDeletes);
+		}
+
+		if (updates.empty() && deletes.empty())
+		{
+			return OperationResult::kSucceeded;
+		}
+		return Commit(updates, deletes);
+	}
+
+	OperationResult LinuxPreferenceStore::Commit(const UpdateMap &updates, const DeleteSet &deletes)
+	{
+		if (sqlite3_exec(fDatabase, "BEGIN IMMEDIATE", NULL, NULL, NULL) != SQLITE_OK)
+		{
+			return Fail("Failed to write preferences");
+		}
+
+		bool success = true;
+		for (UpdateMap::const_iterator it = updates.begin(); it != updates.end() && success; ++it)
+		{
+			success = Step(fInsertStatement, it->first, &it->second);
+		}
+		for (DeleteSet::const_iterator it = deletes.begin(); it != deletes.end() && success; ++it)
+		{
+			success = Step(fDeleteStatement, *it, NULL);
+		}
+
+		if (success && sqlite3_exec(fDatabase, "COMMIT", NULL, NULL, NULL) == SQLITE_OK)
+		{
+			// Otherwise ImportLegacyFile() would bring them back
+			for (DeleteSet::const_iterator it = deletes.begin(); it != deletes.end(); ++it)
+			{
+				std::string path = fDirectoryPath + '/' + *it;
+				Rtt_DeleteFile(path.c_str());
+			}
+			return OperationResult::kSucceeded;
+		}
+
+		OperationResult result = Fail("Failed to write preferences");
+		sqlite3_exec(fDatabase, "ROLLBACK", NULL, NULL, NULL);
+		return result;
+	}
+
+	bool LinuxPreferenceStore::Step(sqlite3_stmt *statement, const std::string &key, const Row *row)
+	{
+		sqlite3_bind_text(statement, 1, key.c_str(), (int)key.length(), SQLITE_STATIC);
+
+		if (row)
+		{
+			switch (row->type)
+			{
+				case SQLITE_INTEGER:
+					sqlite3_bind_int64(statement, 2, row->integer);
+					break;
+				case SQLITE_FLOAT:
+					sqlite3_bind_double(statement, 2, row->number);
+					break;
+				case SQLITE_TEXT:
+					sqlite3_bind_text(statement, 2, row->text.c_str(), (int)row->text.length(), SQLITE_STATIC);
+					break;
+				case SQLITE_BLOB:
+					sqlite3_bind_blob(statement, 2, row->text.c_str(), (int)row->text.length(), SQLITE_STATIC);
+					break;
+				default:
+					sqlite3_bind_null(statement, 2);
+					break;
+			}
+		}
+
+		bool success = (sqlite3_step(statement) == SQLITE_DONE);
+		sqlite3_clear_bindings(statement);
+		sqlite3_reset(statement);
+		return success;
+	}
+
+	OperationResult LinuxPreferenceStore::Fail(const char *defaultMessage) const
+	{
+		const char *message = fDatabase ? sqlite3_errmsg(fDatabase) : NULL;
+		return OperationResult::FailedWith(message ? message : defaultMessage);
+	}
+
+	bool LinuxPreferenceStore::ImportLegacyFile(const std::string &key)
+	{
+		// A deleted key's file is removed when the delete is written
+		std::lock_guard<std::mutex> databaseLock(fDatabaseMutex);
+		{
+			std::lock_guard<std::mutex> lock(fMutex);
+			if (fPendingDeletes.count(key) > 0)
+			{
+				return false;
+			}
+		}
+
+		// Preferences used to be stored one per file, named by key
+		std::string path = fDirectoryPath + '/' + key;
+		FILE *f = fopen(path.c_str(), "rb");
+		if (!f)
+		{
+			return false;
+		}
+
+		UpdateMap updates;
+		Row &row = updates[key];
+		row.type = SQLITE_TEXT;
+
+		char buf[1024];
+		size_t n;
+		while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		{
+			row.text.append(buf, n);
+		}
+		fclose(f);
+
+		// Written right away, since the file is removed
+		if (Commit(updates, DeleteSet()).HasFailed())
+		{
+			return false;
+		}
+
+		fCache[key] = MakeValue(row);
+		Rtt_DeleteFile(path.c_str());
+		return true;
+	}
+}; // namespace Rtt
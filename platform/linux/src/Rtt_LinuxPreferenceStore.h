@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Core/Rtt_OperationResult.h"
+#include "Rtt_Preference.h"
+#include "Rtt_PreferenceCollection.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace Rtt
+{
+	// Stores system.setPreferences() values in a single SQLite database, keyed
+	// by "category.key". Every value is cached in memory when the database is
+	// opened, so reads never touch the file.
+	//
+	// Changes are applied to the cache at once and written by a background
+	// thread, so the Lua thread never waits on the disk. The thread waits
+	// kWriteDelayMs after the first unwritten change, then commits everything
+	// changed since in one transaction; a key set several times in between
+	// is written once. Flush() writes pending changes immediately; it's
+	// called when the app is suspended, and by the destructor.
+	//
+	// Integer, float and string values keep their type. Other types are
+	// stored as the closest of those.
+	class LinuxPreferenceStore
+	{
+	public:
+		LinuxPreferenceStore(const char *directoryPath);
+		~LinuxPreferenceStore();
+
+		static const int kWriteDelayMs = 500;
+
+		Preference::ReadValueResult Fetch(const char *categoryName, const char *keyName);
+		OperationResult UpdateWith(const char *categoryName, const PreferenceCollection &preferences);
+		OperationResult Delete(const char *categoryName, const char **keyNameArray, U32 keyNameCount);
+		OperationResult Flush();
+
+	private:
+		// A value as it's bound to the database. Unlike PreferenceValue, it
+		// shares nothing, so it can be handed to the writer thread.
+		struct Row
+		{
+			int type;
+			S64 integer;
+			double number;
+			std::string text;
+		};
+
+		typedef std::map<std::string, PreferenceValue> CacheType;
+		typedef std::map<std::string, Row> UpdateMap;
+		typedef std::set<std::string> DeleteSet;
+		typedef std::chrono::steady_clock Clock;
+
+		OperationResult Open();
+		void Close();
+		void Run();
+		OperationResult WritePending();
+		OperationResult Commit(const UpdateMap &updates, const DeleteSet &deletes);
+		bool Step(sqlite3_stmt *statement, const std::string &key, const Row *row);
+		OperationResult Fail(const char *defaultMessage) const;
+		bool ImportLegacyFile(const std::string &key);
+
+		static std::string MakeKey(const char *categoryName, const char *keyName);
+		static bool MakeRow(const PreferenceValue &value, Row &row);
+		static PreferenceValue MakeValue(const Row &row);
+
+		std::string fDirectoryPath;
+		CacheType fCache;
+
+		// Held while a batch is taken and committed, so batches reach the
+		// database in the order they were made
+		std::mutex fDatabaseMutex;
+		sqlite3 *fDatabase;
+		sqlite3_stmt *fInsertStatement;
+		sqlite3_stmt *fDeleteStatement;
+
+		// Guards the pending changes, shared with the writer thread
+		std::mutex fMutex;
+		std::condition_variable fCondition;
+		UpdateMap fPendingUpdates;
+		DeleteSet fPendingDeletes;
+		Clock::time_point fPendingSince;
+		bool fQuit;
+		std::thread fWriter;
+	};
+}; // namespace Rtt
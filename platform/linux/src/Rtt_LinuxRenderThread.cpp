@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+#include "Rtt_LinuxRenderThread.h"
+#include "Rtt_LinuxApp.h"
+
+// See imconfig.h
+thread_local ImGuiContext* gImGuiContext = NULL;
+
+namespace Rtt
+{
+	// ImGui reuses its draw lists for the next frame, which the main thread
+	// starts laying out before the render thread gets to draw this one.
+	static ImDrawData* CloneDrawData(const ImDrawData* drawData)
+	{
+		ImDrawData* result = IM_NEW(ImDrawData)(*drawData);
+		result->CmdLists = NULL;
+		if (drawData->CmdListsCount > 0)
+		{
+			result->CmdLists = (ImDrawList**)IM_ALLOC(sizeof(ImDrawList*) * drawData->CmdListsCount);
+			for (int i = 0; i < drawData->CmdListsCount; i++)
+			{
+				result->CmdLists[i] = drawData->CmdLists[i]->CloneOutput();
+			}
+		}
+		return result;
+	}
+
+	static void DeleteDrawData(ImDrawData* drawData)
+	{
+		for (int i = 0; i < drawData->CmdListsCount; i++)
+		{
+			IM_DELETE(drawData->CmdLists[i]);
+		}
+		IM_FREE(drawData->CmdLists);
+		IM_DELETE(drawData);
+	}
+
+	LinuxRenderThread::LinuxRenderThread(SDL_Window* window, SDL_GLContext context, ImGuiContext* imCtx)
+		: fWindow(window)
+		, fContext(context)
+		, fImCtx(imCtx)
+	{
+		// The GUI's shaders and font texture are otherwise created by its
+		// first NewFrame(), which from now on runs without a context
+		if (fImCtx)
+		{
+			ImGuiContext* previous = ImGui::GetCurrentContext();
+			ImGui::SetCurrentContext(fImCtx);
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui::SetCurrentContext(previous);
+		}
+	}
+
+	LinuxRenderThread::~LinuxRenderThread()
+	{
+		Stop();
+	}
+
+	void LinuxRenderThread::Present(bool isSuspended)
+	{
+		ImDrawData* drawData = NULL;
+		if (fImCtx)
+		{
+			ImGuiContext* previous = ImGui::GetCurrentContext();
+			ImGui::SetCurrentContext(fImCtx);
+			ImDrawData* current = ImGui::GetDrawData();
+			drawData = current ? CloneDrawData(current) : NULL;
+			ImGui::SetCurrentContext(previous);
+		}
+
+		Job job = [this, drawData, isSuspended]()
+		{
+			if (isSuspended)
+			{
+				glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+				glClear(GL_COLOR_BUFFER_BIT);
+			}
+
+			if (drawData)
+			{
+				ImGui::SetCurrentContext(fImCtx);
+				ImGui_ImplOpenGL3_RenderDrawData(drawData);
+				DeleteDrawData(drawData);
+			}
+
+			SDL_GL_SwapWindow(fWindow);
+		};
+
+		if (isSuspended)
+		{
+			Run(job);
+		}
+		else
+		{
+			Post(job);
+		}
+	}
+
+	void LinuxRenderThread::MakeCurrent()
+	{
+		SDL_GL_MakeCurrent(fWindow, fContext);
+	}
+
+	void LinuxRenderThread::ReleaseCurrent()
+	{
+		SDL_GL_MakeCurrent(fWindow, NULL);
+	}
+}; // namespace Rtt
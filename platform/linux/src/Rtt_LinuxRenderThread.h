@@ -0,0 +1,44 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Renderer/Rtt_RenderThread.h"
+#include <SDL2/SDL.h>
+
+struct ImGuiContext;
+
+namespace Rtt
+{
+	// Owns the window's GL context while running. The main thread only runs
+	// Lua, prepares the Scene and lays out the GUI; drawing the GUI and
+	// swapping the window happen here, after the frame's Render().
+	class LinuxRenderThread : public RenderThread
+	{
+		Rtt_CLASS_NO_COPIES(LinuxRenderThread)
+
+	public:
+		LinuxRenderThread(SDL_Window* window, SDL_GLContext context, ImGuiContext* imCtx);
+		virtual ~LinuxRenderThread();
+
+		// Draws the GUI from the last ImGui::Render() over the frame, then
+		// swaps. With nothing else to wait on while the runtime is suspended,
+		// this waits for the swap too.
+		void Present(bool isSuspended);
+
+	protected:
+		virtual void MakeCurrent();
+		virtual void ReleaseCurrent();
+
+	private:
+		SDL_Window* fWindow;
+		SDL_GLContext fContext;
+		ImGuiContext* fImCtx;
+	};
+}; // namespace Rtt
@@ -9,6 +9,11 @@
 
 #include "Core/Rtt_Build.h"
 #include "Rtt_LinuxScreenSurface.h"
+#include <string.h>
+
+// Included last, Xlib defines macros such as None and Status
+#include <GL/glx.h>
+#include <GL/glxext.h>
 
 namespace Rtt
 {
@@ -17,6 +22,7 @@ namespace Rtt
 	#pragma region Constructors/Destructors
 	LinuxScreenSurface::LinuxScreenSurface()
 		: fContext(NULL)
+		, fHasBufferAge(-1)
 	{
 	}
 
@@ -46,6 +52,31 @@ namespace Rtt
 		return fContext->GetHeight();
 	}
 
+	S32 LinuxScreenSurface::BackBufferAge() const
+	{
+		// SDL creates the context with GLX on X11. On Wayland (EGL) there is
+		// no current GLX drawable and the back buffer is treated as undefined.
+		::Display* display = glXGetCurrentDisplay();
+		GLXDrawable drawable = glXGetCurrentDrawable();
+		if (display == NULL || drawable == 0)
+		{
+			return 0;
+		}
+
+		if (fHasBufferAge < 0)
+		{
+			const char* extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+			fHasBufferAge = (extensions && strstr(extensions, "GLX_EXT_buffer_age")) ? 1 : 0;
+		}
+
+		unsigned int age = 0;
+		if (fHasBufferAge)
+		{
+			glXQueryDrawable(display, drawable, GLX_BACK_BUFFER_AGE_EXT, &age);
+		}
+		return (S32)age;
+	}
+
 	void LinuxScreenSurface::getWindowSize(int* w, int* h)
 	{
 		*w = Width();
@@ -29,11 +29,13 @@ namespace Rtt
 		virtual S32 Height() const;
 		virtual S32 DeviceWidth() const;
 		virtual S32 DeviceHeight() const;
+		virtual S32 BackBufferAge() const;
 		void setWindow(void *ctx) { fContext = (SolarAppContext*) ctx; }
 		void getWindowSize(int *w, int *h);
 
 	private:
 		SolarAppContext* fContext;
+		mutable int fHasBufferAge; // -1 until GLX_EXT_buffer_age is queried
 	};
 
 	class LinuxOffscreenSurface : public PlatformSurface
@@ -115,6 +115,12 @@
 //---- Debug Tools: Enable slower asserts
 //#define IMGUI_DEBUG_PARANOID
 
+//---- Solar2D: the current context is per thread, so that the render thread (see Rtt_LinuxRenderThread.h)
+// can draw the GUI while the main thread lays out the next frame. Defined in Rtt_LinuxRenderThread.cpp.
+struct ImGuiContext;
+extern thread_local ImGuiContext* gImGuiContext;
+#define GImGui gImGuiContext
+
 //---- Tip: You can add extra functions within the ImGui:: namespace, here or in your own headers files.
 /*
 namespace ImGui
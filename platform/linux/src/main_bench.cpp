@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Rtt_LinuxBench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int Usage(const char* name)
+{
+	fprintf(stderr,
+		"usage: %s [--filter text] [--min-time seconds] [--output results.json] [--list]\n"
+		"\n"
+		"Runs the engine micro-benchmarks and writes the results as Google\n"
+		"Benchmark style JSON, to stdout unless --output is given. A summary\n"
+		"goes to stderr. --filter runs only those whose name contains text.\n", name);
+	return 2;
+}
+
+int main(int argc, char* argv[])
+{
+	Rtt::BenchOptions options;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (strcmp(arg, "--filter") == 0 && hasValue)
+		{
+			options.filter = argv[++i];
+		}
+		else if (strcmp(arg, "--min-time") == 0 && hasValue)
+		{
+			options.minTime = atof(argv[++i]);
+		}
+		else if (strcmp(arg, "--output") == 0 && hasValue)
+		{
+			options.output = argv[++i];
+		}
+		else if (strcmp(arg, "--list") == 0)
+		{
+			const std::vector<Rtt::Benchmark*>& benchmarks = Rtt::Benchmark::All();
+			for (size_t j = 0; j < benchmarks.size(); j++)
+			{
+				printf("%s\n", benchmarks[j]->GetName());
+			}
+			return 0;
+		}
+		else
+		{
+			return Usage(argv[0]);
+		}
+	}
+
+	if (options.minTime <= 0.0)
+	{
+		return Usage(argv[0]);
+	}
+
+	return Rtt::RunBenchmarks(options);
+}
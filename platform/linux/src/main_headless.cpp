@@ -0,0 +1,129 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Rtt_FileSystem.h"
+#include "Rtt_LinuxHeadless.h"
+#include "Rtt_LinuxUtils.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace std;
+
+smart_ptr<Rtt::SolarApp> app;
+
+static int Usage(const char* name)
+{
+	fprintf(stderr,
+		"usage: %s [--frames N] [--size WxH] [--output stats.json]\n"
+		"          [--null-renderer] [--command-stream commands.txt]\n"
+		"          [--capture-frame N frame.rttcap] <app folder>\n"
+		"\n"
+		"Runs the app offscreen for N frames (default 600) of simulated time and\n"
+		"writes frame times and renderer statistics as JSON. Without --output the\n"
+		"JSON goes to stdout, along with anything the app prints.\n"
+		"\n"
+		"--null-renderer skips all GPU work, leaving only the CPU cost of preparing\n"
+		"frames. --command-stream implies it and writes each frame's commands.\n"
+		"--capture-frame saves frame N for Solar2DReplay.\n", name);
+	return 2;
+}
+
+int main(int argc, char* argv[])
+{
+	Rtt::HeadlessApp::Options options;
+	string appPath;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (strcmp(arg, "--frames") == 0 && hasValue)
+		{
+			options.frames = atoi(argv[++i]);
+		}
+		else if (strcmp(arg, "--size") == 0 && hasValue)
+		{
+			if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2)
+			{
+				return Usage(argv[0]);
+			}
+		}
+		else if (strcmp(arg, "--output") == 0 && hasValue)
+		{
+			options.output = argv[++i];
+		}
+		else if (strcmp(arg, "--null-renderer") == 0)
+		{
+			options.nullRenderer = true;
+		}
+		else if (strcmp(arg, "--command-stream") == 0 && hasValue)
+		{
+			options.nullRenderer = true;
+			options.commandStream = argv[++i];
+		}
+		else if (strcmp(arg, "--capture-frame") == 0 && i + 2 < argc)
+		{
+			options.captureFrame = atoi(argv[++i]);
+			options.capturePath = argv[++i];
+		}
+		else if (arg[0] != '-' && appPath.empty())
+		{
+			appPath = arg;
+		}
+		else
+		{
+			return Usage(argv[0]);
+		}
+	}
+
+	if (appPath.empty() || options.frames <= 0)
+	{
+		return Usage(argv[0]);
+	}
+
+	// The app changes the working directory to its own folder
+	char cwd[PATH_MAX];
+	if (getcwd(cwd, sizeof(cwd)))
+	{
+		if (appPath[0] != '/')
+		{
+			appPath = string(cwd) + "/" + appPath;
+		}
+		if (!options.output.empty() && options.output[0] != '/')
+		{
+			options.output = string(cwd) + "/" + options.output;
+		}
+		if (!options.commandStream.empty() && options.commandStream[0] != '/')
+		{
+			options.commandStream = string(cwd) + "/" + options.commandStream;
+		}
+		if (!options.capturePath.empty() && options.capturePath[0] != '/')
+		{
+			options.capturePath = string(cwd) + "/" + options.capturePath;
+		}
+	}
+
+	if (!Rtt_IsDirectory(appPath.c_str()))
+	{
+		fprintf(stderr, "%s is not a folder\n", appPath.c_str());
+		return 1;
+	}
+
+	Rtt::HeadlessApp* headless = new Rtt::HeadlessApp(appPath, options);
+	app = headless;
+
+	int result = headless->Init() ? headless->RunFrames() : 1;
+
+	app = NULL;
+	return result;
+}
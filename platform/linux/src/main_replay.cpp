@@ -0,0 +1,176 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of the Corona game engine.
+// For overview and more information on licensing please refer to README.md
+// Home page: https://github.com/coronalabs/corona
+// Contact: support@coronalabs.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Core/Rtt_Build.h"
+#include "Core/Rtt_Time.h"
+#include "Renderer/Rtt_CommandCapture.h"
+#include "Renderer/Rtt_GL.h"
+#include "Renderer/Rtt_GLRenderer.h"
+#include "Rtt_LinuxApp.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace std;
+
+// The platform sources refer to it, but no app is ever loaded here
+smart_ptr<Rtt::SolarApp> app;
+
+static int Usage(const char* name)
+{
+	fprintf(stderr,
+		"usage: %s [--iterations N] [--warmup N] [--size WxH] <capture file>\n"
+		"\n"
+		"Replays a frame saved with graphics.captureCommandStream() or\n"
+		"Solar2DHeadless --capture-frame N times (default 1000) against an\n"
+		"offscreen GL context and writes the time per replay as JSON. Each\n"
+		"replay ends with glFinish(), so times include the GPU work.\n", name);
+	return 2;
+}
+
+// Nearest rank, on sorted values
+static double Percentile(const vector<double>& sorted, double p)
+{
+	if (sorted.empty())
+	{
+		return 0.0;
+	}
+	size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+int main(int argc, char* argv[])
+{
+	int iterations = 1000;
+	int warmup = 10;
+	int width = 1280;
+	int height = 720;
+	const char* capturePath = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (strcmp(arg, "--iterations") == 0 && hasValue)
+		{
+			iterations = atoi(argv[++i]);
+		}
+		else if (strcmp(arg, "--warmup") == 0 && hasValue)
+		{
+			warmup = atoi(argv[++i]);
+		}
+		else if (strcmp(arg, "--size") == 0 && hasValue)
+		{
+			if (sscanf(argv[++i], "%dx%d", &width, &height) != 2)
+			{
+				return Usage(argv[0]);
+			}
+		}
+		else if (arg[0] != '-' && !capturePath)
+		{
+			capturePath = arg;
+		}
+		else
+		{
+			return Usage(argv[0]);
+		}
+	}
+
+	if (!capturePath || iterations <= 0 || warmup < 0)
+	{
+		return Usage(argv[0]);
+	}
+
+	setenv("SDL_VIDEODRIVER", "offscreen", 0);
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return 1;
+	}
+
+	// Same context as SolarApp::InitSDL()
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 0);
+	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+	SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE | SDL_GL_CONTEXT_PROFILE_COMPATIBILITY);
+
+	SDL_Window* window = SDL_CreateWindow("", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+	SDL_GLContext context = window ? SDL_GL_CreateContext(window) : NULL;
+	if (!context)
+	{
+		fprintf(stderr, "Couldn't create a GL context: %s\n", SDL_GetError());
+		SDL_Quit();
+		return 1;
+	}
+	SDL_GL_MakeCurrent(window, context);
+	SDL_GL_SetSwapInterval(0);
+
+	Rtt_Allocator* allocator = Rtt_AllocatorCreate();
+	int result = 0;
+	{
+		Rtt::GLRenderer renderer(allocator);
+		renderer.Initialize();
+
+		Rtt::CommandReplay replay(allocator);
+		if (!replay.Load(capturePath))
+		{
+			fprintf(stderr, "%s is not a command stream capture\n", capturePath);
+			result = 1;
+		}
+		else
+		{
+			replay.Prepare(renderer);
+
+			for (int i = 0; i < warmup; i++)
+			{
+				replay.Execute(renderer, false);
+			}
+			glFinish();
+
+			vector<double> times;
+			times.reserve(iterations);
+			for (int i = 0; i < iterations; i++)
+			{
+				Rtt_AbsoluteTime start = Rtt_GetAbsoluteTime();
+				replay.Execute(renderer, false);
+				glFinish();
+				times.push_back(Rtt_AbsoluteToMicroseconds(Rtt_GetAbsoluteTime() - start) / 1000.0);
+			}
+
+			double total = 0.0;
+			for (size_t i = 0; i < times.size(); i++)
+			{
+				total += times[i];
+			}
+			sort(times.begin(), times.end());
+
+			printf("{\n");
+			printf("\t\"capture\": \"%s\",\n", capturePath);
+			printf("\t\"commands\": %u,\n", replay.GetCommandCount());
+			printf("\t\"resources\": %u,\n", replay.GetResourceCount());
+			printf("\t\"iterations\": %d,\n", iterations);
+			printf("\t\"replayTime\": { \"mean\": %.3f, \"min\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f }\n",
+				total / times.size(), times.front(),
+				Percentile(times, 0.5), Percentile(times, 0.95), Percentile(times, 0.99),
+				times.back());
+			printf("}\n");
+		}
+	}
+	Rtt_AllocatorDestroy(allocator);
+
+	SDL_GL_DeleteContext(context);
+	SDL_DestroyWindow(window);
+	SDL_Quit();
+	return result;
+}
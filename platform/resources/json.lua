@@ -18,14 +18,38 @@ dkjson.version = dkjson.version .. "-1"
 local decode_base = dkjson.decode
 local encode_base = dkjson.encode
 
+-- Native codec, used where it gives the same results as dkjson
+local hasNative, native = pcall(require, "json.native")
+if not hasNative then
+	native = nil
+end
+
+-- Same defaults as dkjson: fresh metatables unless the caller passes some
+local function decode_native(decoder, source, pos, nullval, ...)
+	if select("#", ...) > 0 then
+		return decoder(source, pos, nullval, ...)
+	else
+		return decoder(source, pos, nullval, {__jsontype = 'object'}, {__jsontype = 'array'})
+	end
+end
+
 local function decode_override(str, pos, nullval, ...)
 	-- Check for common error that gives an inscrutable message and
 	-- provide a better one
 	if str == nil then
 		error("json.decode called with nil string", 2)
-	else
-		return decode_base(str, pos, nullval, ...)
 	end
+
+	if native and type(str) == "string" then
+		local result, resultPos, errorMsg = decode_native(native.decode, str, pos, nullval, ...)
+		if errorMsg == nil then
+			return result, resultPos
+		end
+		-- dkjson accepts some malformed input (missing or trailing commas),
+		-- so it has the last word on anything the native codec rejects
+	end
+
+	return decode_base(str, pos, nullval, ...)
 end
 
 local function encode_override(value, state)
@@ -33,6 +57,14 @@ local function encode_override(value, state)
 	-- cannot encode.  To restore the default behavior define
 	-- an exception handler that calls error()
 	if state == nil then
+		if native then
+			-- Returns nothing for values that need dkjson (__tojson,
+			-- unsupported types, cycles)
+			local result = native.encode(value, dkjson.null)
+			if result ~= nil then
+				return result
+			end
+		end
 		state = {}
 	end
 	if state.exception == nil then
@@ -79,6 +111,16 @@ end
 
 local function json_decode_file(filename, pos, nullval, ...)
 	local decodedData
+
+	if native then
+		-- Parses the file's contents without making a Lua string of them
+		local errorMsg, _
+		decodedData, _, errorMsg = decode_native(native.decodeFile, filename, pos, nullval, ...)
+		if errorMsg == nil then
+			return decodedData, 0, nil
+		end
+	end
+
 	local fp, fileOpenErrorMsg = io.open(filename, 'r')
 
 	if not fp then
@@ -102,4 +144,10 @@ dkjson.decodeFile = json_decode_file
 dkjson.encode = encode_override
 dkjson.prettify = json_prettify
 
+if native then
+	-- Event-based parsing without building tables; see Rtt_LuaLibJSON.cpp
+	dkjson.scan = native.scan
+	dkjson.scanFile = native.scanFile
+end
+
 return dkjson
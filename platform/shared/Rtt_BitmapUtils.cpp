@@ -17,26 +17,15 @@
 
 namespace bitmapUtil
 {
-	uint8_t* loadPNG(FILE* fp, int& w, int& h)
+	// Decodes to RGBA once the png source has been set. Destroys png and info.
+	static uint8_t* readPNG(png_structp png, png_infop info, int& w, int& h)
 	{
-		png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-		if (png == NULL)
-		{
-			return NULL;
-		}
-
-		png_infop info = png_create_info_struct(png);
-		if (info == NULL)
-		{
-			return NULL;
-		}
-
 		if (setjmp(png_jmpbuf(png)))
 		{
+			png_destroy_read_struct(&png, &info, NULL);
 			return NULL;
 		}
 
-		png_init_io(png, fp);
 		png_read_info(png, info);
 
 		w = png_get_image_width(png, info);
@@ -89,6 +78,64 @@ namespace bitmapUtil
 		return im;
 	}
 
+	uint8_t* loadPNG(FILE* fp, int& w, int& h)
+	{
+		png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+		if (png == NULL)
+		{
+			return NULL;
+		}
+
+		png_infop info = png_create_info_struct(png);
+		if (info == NULL)
+		{
+			png_destroy_read_struct(&png, NULL, NULL);
+			return NULL;
+		}
+
+		png_init_io(png, fp);
+		return readPNG(png, info, w, h);
+	}
+
+	struct png_source_t
+	{
+		const uint8_t* bytes;
+		size_t length;
+		size_t offset;
+	};
+
+	static void pngReadFunc(png_structp png_ptr, png_bytep data, png_size_t length)
+	{
+		png_source_t* p = (png_source_t*)png_get_io_ptr(png_ptr);
+		if (length > p->length - p->offset)
+		{
+			png_error(png_ptr, "png reader: unexpected end of data");
+		}
+		memcpy(data, p->bytes + p->offset, length);
+		p->offset += length;
+	}
+
+	uint8_t* loadPNG(const uint8_t* bytes, size_t length, int& w, int& h)
+	{
+		png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+		if (png == NULL)
+		{
+			return NULL;
+		}
+
+		png_infop info = png_create_info_struct(png);
+		if (info == NULL)
+		{
+			png_destroy_read_struct(&png, NULL, NULL);
+			return NULL;
+		}
+
+		// libpng reads it through here, so it must outlive readPNG()
+		png_source_t source = { bytes, length, 0 };
+		png_set_read_fn(png, &source, pngReadFunc);
+		return readPNG(png, info, w, h);
+	}
+
 	struct png_buffer_t
 	{
 		char* buffer;
@@ -16,6 +16,7 @@
 namespace bitmapUtil
 {
 	uint8_t* loadPNG(FILE* infile, int& w, int& h);
+	uint8_t* loadPNG(const uint8_t* bytes, size_t length, int& w, int& h);
 	char* savePNG(size_t& length, uint8_t* data, int width, int height, Rtt::PlatformBitmap::Format format);
 };
 